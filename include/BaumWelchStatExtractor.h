@@ -0,0 +1,222 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_BaumWelchStatExtractor_h)
+#define ALIZE_BaumWelchStatExtractor_h
+
+#include "alize_util.h"
+#include "Object.h"
+#include "ThreadPool.h"
+#include "RealVector.h"
+#include "Matrix.h"
+
+namespace alize
+{
+  class Config;
+  class StatServer;
+  class MixtureGD;
+  class MixtureGDStat;
+  class FeatureInputStream;
+  class XLine;
+  class XList;
+
+  /// Extraction of the Baum-Welch statistics of utterances against a
+  /// world model (UBM), for i-vector and JFA back ends : the zero order
+  /// statistics N[distribCount] (sums of the posteriors) and the first
+  /// order statistics F[distribCount][vectSize] (sums of the frames
+  /// weighted by the posteriors). With centered statistics, N(c) x
+  /// mean(c) is subtracted from F(c).\n
+  /// The posteriors are computed by blocks of frames (block version of
+  /// MixtureGDStat::computeAndAccumulateEM()). With a top count, only the
+  /// posteriors of the top count distributions of each frame are kept and
+  /// renormalized (see MixtureStat::setPosteriorPruning()).\n
+  /// The utterances of a list are processed in parallel by the threads of
+  /// a pool, each utterance by one thread, so the results do not depend on
+  /// the number of threads. They can be written to a binary file as they
+  /// are computed : header (64 bytes : "ALIZEBWS", version, byte order
+  /// mark, distribCount, vectSize, utterance count, flags (1 : centered)),
+  /// then for each utterance the length of its id (8 bytes), the id padded
+  /// with zeros to a multiple of 8 bytes, the frame count, N and F
+  /// (doubles).
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API BaumWelchStatExtractor : public Object
+  {
+
+  public :
+
+    /// Creates an extractor
+    /// @param c the configuration. Parameters : 'BWStatTopCount' (default
+    ///     : 'posteriorTopCount', or 0 : all the distributions),
+    ///     'BWStatCentered' (default : false), 'threadCount' if
+    ///     threadCount is 0 (default : all the hardware threads)
+    /// @param ss the stat server used to create the accumulators
+    /// @param threadCount number of threads
+    ///
+    explicit BaumWelchStatExtractor(const Config& c, StatServer& ss,
+                                    unsigned long threadCount = 0);
+    virtual ~BaumWelchStatExtractor();
+
+    /// Sets the number of posteriors kept for each frame
+    /// @param n the number of posteriors (0 : all)
+    ///
+    void setTopCount(unsigned long n);
+    unsigned long getTopCount() const;
+
+    /// Chooses centered or uncentered first order statistics
+    ///
+    void setCentered(bool b);
+    bool isCentered() const;
+
+    /// Computes the statistics of the features of a stream, from its
+    /// current position to its end
+    /// @param ubm the world model
+    /// @param fs the feature stream
+    /// @param n the zero order statistics [distribCount]
+    /// @param f the first order statistics [distribCount*vectSize]
+    /// @return the number of features read
+    ///
+    unsigned long extract(const MixtureGD& ubm, FeatureInputStream& fs,
+                          double* n, double* f);
+
+    /// Same as above. n and f are resized
+    /// @param n the zero order statistics [distribCount]
+    /// @param f the first order statistics (distribCount x vectSize)
+    ///
+    unsigned long extract(const MixtureGD& ubm, FeatureInputStream& fs,
+                          DoubleVector& n, DoubleMatrix& f);
+
+    /// Computes the statistics of a list of utterances. Each line of the
+    /// list gives the id of an utterance followed by its feature files,
+    /// WITHOUT PATH AND EXTENSION (see FeatureServer).
+    /// @param ubm the world model
+    /// @param list the utterances
+    /// @param n the zero order statistics (utterances x distribCount).
+    ///     Resized
+    /// @param f the first order statistics (utterances x
+    ///     distribCount*vectSize). Resized
+    /// @return the number of features read
+    /// @exception Exception if a line has no id
+    ///
+    unsigned long extract(const MixtureGD& ubm, const XList& list,
+                          DoubleMatrix& n, DoubleMatrix& f);
+
+    /// Same as above, the statistics being written to a binary file as
+    /// they are computed. Only the statistics of a few utterances per
+    /// thread are kept in memory.
+    /// @param ubm the world model
+    /// @param list the utterances
+    /// @param file the file
+    /// @return the number of features read
+    /// @exception IOException if the file cannot be written
+    ///
+    unsigned long extract(const MixtureGD& ubm, const XList& list,
+                          const FileName& file);
+
+    /// Reads a file written by extract()
+    /// @param file the file
+    /// @param ids the ids of the utterances. Cleared
+    /// @param frameCounts the frame counts of the utterances. Resized
+    /// @param n the zero order statistics (utterances x distribCount)
+    /// @param f the first order statistics (utterances x
+    ///     distribCount*vectSize)
+    /// @return true if the statistics are centered
+    /// @exception InvalidDataException if the file is not valid
+    ///
+    static bool load(const FileName& file, XLine& ids,
+                     DoubleVector& frameCounts, DoubleMatrix& n,
+                     DoubleMatrix& f);
+
+    /// Returns the number of threads
+    ///
+    unsigned long getThreadCount() const;
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    const Config&  _config;
+    StatServer&    _statServer;
+    ThreadPool     _pool;
+    unsigned long  _topCount;
+    bool           _centered;
+    // accumulators and configurations of the threads [threadCount],
+    // reused while the world model and its dimensions do not change
+    const MixtureGD* _pUbm;
+    unsigned long    _ubmDistribCount;
+    unsigned long    _ubmVectSize;
+    MixtureGDStat**  _accArray;
+    Config**         _configArray;
+
+    void createAccumulators(const MixtureGD& ubm);
+    void deleteAccumulators();
+    unsigned long accumulate(MixtureGDStat& acc, FeatureInputStream& fs,
+                             double* n, double* f) const;
+    unsigned long extractList(const MixtureGD& ubm, const XList& list,
+                              unsigned long first, unsigned long count,
+                              double* frameCounts, double* n, double* f);
+
+    BaumWelchStatExtractor(const BaumWelchStatExtractor&); /*!Not implemented*/
+    const BaumWelchStatExtractor& operator=(
+                 const BaumWelchStatExtractor&); /*!Not implemented*/
+    bool operator==(const BaumWelchStatExtractor&) const; /*!Not implemented*/
+    bool operator!=(const BaumWelchStatExtractor&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_BaumWelchStatExtractor_h)
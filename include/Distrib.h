@@ -188,6 +188,24 @@ namespace alize
     unsigned long& dictIndex(const K&);
     unsigned long& refCounter(const K&);
 
+    /// Returns the revision of the distribution. The revision is taken
+    /// from a global counter each time the parameters may have been
+    /// modified, including each call to a non-constant accessor.
+    /// Used to keep packed copies of mixtures up to date
+    /// (see MixtureGD::getPacked()).
+    /// @return the revision
+    ///
+    unsigned long long getRevision() const;
+
+    /// Returns the last revision given to a distribution or a mixture
+    /// @return the revision
+    ///
+    static unsigned long long getLastRevision();
+
+    /// Returns a new revision (internal usage)
+    ///
+    static unsigned long long newRevision(const K&);
+
     static Distrib& create(const K&, const DistribType,
                            unsigned long vectSize);
   protected:
@@ -196,6 +214,7 @@ namespace alize
     real_t              _det;        /*!< determinant */
     real_t              _cst;        /*!< constante */
     DoubleVector        _meanVect;   /*!< mean vector */
+    unsigned long long  _revision;   /*!< see getRevision() */
   private :
     unsigned long _refCounter;
     unsigned long _dictIndex;
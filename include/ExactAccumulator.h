@@ -0,0 +1,193 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_ExactAccumulator_h)
+#define ALIZE_ExactAccumulator_h
+
+#include "alize_util.h"
+#include "Object.h"
+
+namespace alize
+{
+  /// Vector of sums which do not depend on the order of the additions.\n
+  /// Each value v is first rounded : to the nearest multiple of 2^-40 if
+  /// |v| <= 2048, else to a multiple of 2^-96 (truncation). The rounded
+  /// value only depends on v. The rounded values are then added exactly :
+  /// in a double while the partial sum stays below 4096 (a sum of
+  /// multiples of 2^-40 is exact in this range), then in a fixed point
+  /// number of LIMB_COUNT digits of 32 bits (lowest digit : 2^-96) with
+  /// integer operations. As no addition is rounded, the sums do not depend
+  /// on the order of the values, on the number of threads or on the way a
+  /// corpus is split. Most additions only cost a few floating point
+  /// operations.
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API ExactAccumulator : public Object
+  {
+
+  public :
+
+    static const unsigned long LIMB_COUNT = 6;
+
+    explicit ExactAccumulator(unsigned long size = 0);
+    virtual ~ExactAccumulator();
+
+    /// Sets the number of sums and resets them. The buffer is kept if
+    /// the size does not grow.
+    /// @param size the number of sums
+    ///
+    void setSize(unsigned long size);
+    unsigned long getSize() const;
+
+    /// Sets all the sums to 0
+    ///
+    void reset();
+
+    /// Sets a sum to 0
+    /// @param i index of the sum
+    ///
+    void reset(unsigned long i);
+
+    /// Adds a value to a sum
+    /// @param i index of the sum
+    /// @param v the value
+    /// @exception Exception if v is not finite or if |v| >= 2^84
+    ///
+    void add(unsigned long i, double v);
+
+    /// Adds n values to the sums i to i+n-1
+    /// @param i index of the first sum
+    /// @param v the values [n]
+    /// @param n the number of values
+    /// @exception Exception if a value is not finite or too large
+    ///
+    void add(unsigned long i, const double* v, unsigned long n);
+
+    /// Adds n values to the same sum
+    /// @param i index of the sum
+    /// @param v the values [n]
+    /// @param n the number of values
+    /// @exception Exception if a value is not finite or too large
+    ///
+    void addAll(unsigned long i, const double* v, unsigned long n);
+
+    /// Adds the weighted moments of order 0, 1 and 2 of rows of n values :
+    /// for each row r, w[r] is added to the sum i, p = w[r]*x[r][j] to
+    /// the sum i+1+j and p*x[r][j] to the sum i+1+n+j. The products are
+    /// computed in double precision. The sums are the same as with add()
+    /// but several rows are rounded and summed together with SIMD
+    /// instructions.
+    /// @param i index of the first sum
+    /// @param w the weights of the rows [rowCount]
+    /// @param x the rows [rowCount][n]
+    /// @param n the number of values of a row
+    /// @param rowCount the number of rows
+    /// @exception Exception if a value is not finite or too large
+    ///
+    void addMoments(unsigned long i, const double* w, const float* x,
+                    unsigned long n, unsigned long rowCount);
+
+    /// Same as above with rows in double precision (no SIMD version)
+    ///
+    void addMoments(unsigned long i, const double* w, const double* x,
+                    unsigned long n, unsigned long rowCount);
+
+    /// Adds the sums of another accumulator
+    /// @param a the accumulator
+    /// @exception Exception if the sizes are different
+    ///
+    void add(const ExactAccumulator& a);
+
+    /// Returns a sum rounded to a double. The result only depends on the
+    /// exact value of the sum.
+    /// @param i index of the sum
+    ///
+    double getValue(unsigned long i) const;
+
+    /// Copies the digits of all the sums [getSize()*LIMB_COUNT]. The
+    /// digits are normalized and exactly represented by doubles.
+    ///
+    void write(double* p) const;
+
+    /// Sets the digits of all the sums, written by write()
+    ///
+    void read(const double* p);
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    unsigned long  _size;
+    unsigned long  _capacity;
+    long long*     _limbArray; // [size][LIMB_COUNT], lowest digit first
+    double*        _partialArray; // [size] exact partial sums
+    unsigned long  _pendingCount; // additions since the last normalization
+
+    void addValue(unsigned long i, double v);
+    void addRoundedSum(unsigned long i, double s);
+    void addValues(unsigned long i, const double* v, unsigned long n);
+    void normalize();
+
+    ExactAccumulator(const ExactAccumulator&); /*!Not implemented*/
+    const ExactAccumulator& operator=(const ExactAccumulator&); /*!Not implemented*/
+    bool operator==(const ExactAccumulator&) const; /*!Not implemented*/
+    bool operator!=(const ExactAccumulator&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_ExactAccumulator_h)
@@ -178,6 +178,12 @@ namespace alize
     ///    
     void setData(const DoubleVector& v, unsigned long start=0);
 
+    /// Updates all the acoustic parameters from an array of getVectSize()
+    /// floats (for example a frame of a memory mapped file)
+    /// @param v the values
+    ///
+    void setData(const float* v);
+
     /// Copy some parameters from a feature (copy too validity and label code)
     /// <br>Gets parameters from f according to the selection s and put them
     /// into this feature
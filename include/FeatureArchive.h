@@ -0,0 +1,195 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_FeatureArchive_h)
+#define ALIZE_FeatureArchive_h
+
+#include <map>
+#include <memory>
+#include "alize_util.h"
+#include "Object.h"
+#include "ULongVector.h"
+
+namespace alize
+{
+  class MappedFile;
+  class FeatureFlags;
+  class Config;
+  class XLine;
+
+  /// Single file storing the features of many utterances, with an index
+  /// of the utterances (name, position, number of features, vectSize,
+  /// flags and sample rate).\n
+  /// The archive is mapped in memory and the index is read once : the
+  /// utterances are then read without any opening of file nor parsing
+  /// of header. The utterances are read by FeatureFileReaderArchive
+  /// (parameters 'loadFeatureFileFormat' = ARCHIVE and
+  /// 'loadFeatureFileArchive' = the archive), so a FeatureServer can
+  /// read any utterance or list of utterances of the archive.\n
+  /// File : a header of 64 bytes, the features of each utterance (floats
+  /// in the byte order of the writer) then the index. Archives are
+  /// created by pack() and converted back to feature files by unpack().
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API FeatureArchive : public Object
+  {
+
+  public :
+
+    /// Maps an archive and reads its index
+    /// @param f the full name of the archive
+    /// @exception FileNotFoundException
+    /// @exception InvalidDataException if the file is not a valid archive
+    ///
+    explicit FeatureArchive(const FileName& f);
+
+    virtual ~FeatureArchive();
+
+    /// Returns the archive opened by the process for this file. The
+    /// archive is opened at the first call and kept for the next calls.
+    /// Each reader holds the returned pointer : the archive stays open
+    /// while it is used, even after closeAll() or pack(). Thread-safe.
+    /// @param f the full name of the archive
+    ///
+    static std::shared_ptr<FeatureArchive> open(const FileName& f);
+
+    /// Closes the archives opened by open() which are not used by any
+    /// reader. The other ones stay open.
+    ///
+    static void closeAll();
+
+    /// Creates an archive from feature files. The archive is written in
+    /// a temporary file renamed at the end : the readers of a previous
+    /// version of the archive keep reading it and the next calls to
+    /// open() read the new one.
+    /// @param f the full name of the archive
+    /// @param l the names of the files, read as a FeatureServer would read
+    ///     them with the configuration (parameters 'loadFeatureFileFormat',
+    ///     'featureFilesPath', 'loadFeatureFileExtension'...). These names
+    ///     are the names of the utterances in the archive.
+    /// @param c the configuration
+    /// @return the number of features written
+    /// @exception Exception if a name is duplicated
+    /// @exception IOException if an I/O error occurs
+    ///
+    static unsigned long pack(const FileName& f, const XLine& l,
+                              const Config& c);
+
+    /// Writes each utterance of an archive in a feature file with a
+    /// FeatureFileWriter (parameters 'saveFeatureFileFormat',
+    /// 'featureFilesPath', 'saveFeatureFileExtension'). The flags and the
+    /// sample rate of an utterance replace those of the configuration.
+    /// @param f the full name of the archive
+    /// @param c the configuration
+    /// @return the number of files written
+    /// @exception IOException if an I/O error occurs
+    ///
+    static unsigned long unpack(const FileName& f, const Config& c);
+
+    /// Returns the number of utterances
+    ///
+    unsigned long getEntryCount() const;
+
+    /// Returns true if the archive contains an utterance
+    /// @param name the name of the utterance
+    ///
+    bool exists(const std::string& name) const;
+
+    /// Returns the index of an utterance
+    /// @param name the name of the utterance
+    /// @exception Exception if the utterance does not exist
+    ///
+    unsigned long getEntryIndex(const std::string& name) const;
+
+    /// Returns the name of an utterance
+    /// @param i index of the utterance
+    ///
+    std::string getName(unsigned long i) const;
+
+    unsigned long getFeatureCount(unsigned long i) const;
+    unsigned long getVectSize(unsigned long i) const;
+    FeatureFlags getFeatureFlags(unsigned long i) const;
+    real_t getSampleRate(unsigned long i) const;
+
+    /// Returns the features of an utterance (featureCount x vectSize),
+    /// valid while the archive is open
+    /// @param i index of the utterance
+    ///
+    const float* getFeatures(unsigned long i) const;
+
+    const FileName& getFileName() const;
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    FileName       _fileName;
+    MappedFile*    _pMappedFile;
+    ULongVector    _entryOffsets; // position of the entries of the index
+    std::map<std::string, unsigned long> _indexMap; // name -> entry
+
+    void readIndex();
+
+    FeatureArchive(const FeatureArchive&); /*!Not implemented*/
+    const FeatureArchive& operator=(const FeatureArchive&); /*!Not implemented*/
+    bool operator==(const FeatureArchive&) const; /*!Not implemented*/
+    bool operator!=(const FeatureArchive&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_FeatureArchive_h)
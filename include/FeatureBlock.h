@@ -0,0 +1,153 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_FeatureBlock_h)
+#define ALIZE_FeatureBlock_h
+
+#include "alize_util.h"
+#include "Object.h"
+#include "RealVector.h"
+
+namespace alize
+{
+  class Feature;
+
+  /// Block of consecutive frames stored in single precision, row-major
+  /// (frameCount x vectSize).\n
+  /// The frames are either owned by the block or are an alias of an
+  /// external memory (for example the buffer or the mapped file of a
+  /// feature file reader, see FeatureInputStream::readFeatures()). An
+  /// alias is valid until the next read or the close of the stream.
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API FeatureBlock : public Object
+  {
+
+  public :
+
+    explicit FeatureBlock(unsigned long vectSize = 0);
+    virtual ~FeatureBlock();
+
+    /// Sets the dimensions of the block. The frames become owned by the
+    /// block and their values are undefined.
+    /// @param frameCount the number of frames
+    /// @param vectSize the dimension of the frames
+    ///
+    void setDimensions(unsigned long frameCount, unsigned long vectSize);
+
+    /// Uses external frames without copy
+    /// @param frames the first value of the first frame
+    /// @param frameCount the number of frames
+    /// @param vectSize the dimension of the frames
+    ///
+    void setAlias(const float* frames, unsigned long frameCount,
+                  unsigned long vectSize);
+
+    /// Returns true if the frames are an alias of an external memory
+    ///
+    bool isAlias() const;
+
+    /// Returns the frames (frameCount x vectSize)
+    ///
+    const float* getArray() const;
+
+    /// Returns the frames to write them
+    /// @exception Exception if the frames are an alias
+    ///
+    float* getWritableArray();
+
+    /// Returns the first value of a frame
+    /// @param n index of the frame
+    ///
+    const float* getFrame(unsigned long n) const;
+
+    /// Copies a feature into a frame
+    /// @param n index of the frame
+    /// @param f the feature
+    /// @exception Exception if the frames are an alias or if the
+    ///    dimensions do not match
+    ///
+    void setFrame(unsigned long n, const Feature& f);
+
+    /// Copies a frame into a feature
+    /// @param n index of the frame
+    /// @param f the feature
+    ///
+    void getFeature(unsigned long n, Feature& f) const;
+
+    unsigned long getFrameCount() const;
+    unsigned long getVectSize() const;
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    FloatVector    _vect;   // owned frames
+    const float*   _pData;
+    unsigned long  _frameCount;
+    unsigned long  _vectSize;
+    bool           _alias;
+
+    FeatureBlock(const FeatureBlock&); /*!Not implemented*/
+    const FeatureBlock& operator=(const FeatureBlock&); /*!Not implemented*/
+    bool operator==(const FeatureBlock&) const; /*!Not implemented*/
+    bool operator!=(const FeatureBlock&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_FeatureBlock_h)
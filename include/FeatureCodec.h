@@ -0,0 +1,193 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_FeatureCodec_h)
+#define ALIZE_FeatureCodec_h
+
+#include <stdint.h>
+#include "alize_util.h"
+#include "Object.h"
+
+namespace alize
+{
+  class FeatureFlags;
+  class FeatureInputStream;
+  class StatServer;
+  class Mixture;
+
+  /// Quantization of blocks of frames used by the COMPRESSED feature file
+  /// format (see FeatureFileWriter and FeatureFileReaderCompressed).\n
+  /// Each block of BLOCK_FRAME_COUNT frames stores, for each dimension,
+  /// a scale and an offset (floats) followed by the codes of the frames
+  /// (8 or 16 bits, row-major). A value is decoded as
+  /// offset + scale*code, so the quantization error of a value is lower
+  /// than scale/2 : (max-min)/510 with 8 bits, (max-min)/131070 with
+  /// 16 bits, where min and max are taken over the block.\n
+  /// The decoding is vectorized (SSE2, AVX2) and gives exactly the same
+  /// values with all the instruction sets.
+  ///
+  /// File : FileHeader, the blocks, then the index of the blocks (the
+  /// position of each block in the file, unsigned 64-bit integers).
+  /// Values are written in the byte order of the writer.
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API FeatureCodec
+  {
+
+  public :
+
+    /// Header of a compressed feature file (64 bytes)
+    ///
+    struct FileHeader
+    {
+      char     magic[8];        // "ALIZECFF"
+      uint32_t version;
+      uint32_t byteOrderMark;   // 0x01020304 in the byte order of the file
+      uint64_t featureCount;
+      uint64_t indexOffset;     // position of the index of the blocks
+      uint32_t vectSize;
+      uint32_t bits;            // 8 or 16
+      uint32_t blockFrameCount;
+      float    sampleRate;
+      char     flags[8];        // see FeatureFlags::getString()
+      char     unused[8];
+    };
+
+    /// Number of frames of a block (the last block of a file can be
+    /// shorter)
+    ///
+    static const unsigned long BLOCK_FRAME_COUNT;
+
+    /// Fills a header. The feature count and the position of the index
+    /// are set to 0.
+    /// @param h the header
+    /// @param vectSize the dimension of the frames
+    /// @param bits 8 or 16
+    /// @param flags the feature flags
+    /// @param sampleRate the sample rate
+    /// @exception Exception if bits is not 8 or 16
+    ///
+    static void initHeader(FileHeader& h, unsigned long vectSize,
+                           unsigned long bits, const FeatureFlags& flags,
+                           real_t sampleRate);
+
+    /// Checks a header read from a file
+    /// @param h the header
+    /// @param fileName the name of the file, for the exception
+    /// @exception InvalidDataException if the header is not valid or if
+    ///      the file has been written with another byte order
+    ///
+    static void checkHeader(const FileHeader& h, const std::string& fileName);
+
+    /// Returns the size of a block in bytes (multiple of 4)
+    /// @param frameCount the number of frames of the block
+    /// @param vectSize the dimension of the frames
+    /// @param bits 8 or 16
+    ///
+    static unsigned long getBlockSize(unsigned long frameCount,
+                                      unsigned long vectSize,
+                                      unsigned long bits);
+
+    /// Quantizes a block of frames
+    /// @param frames the frames, row-major (frameCount x vectSize)
+    /// @param frameCount the number of frames
+    /// @param vectSize the dimension of the frames
+    /// @param bits 8 or 16
+    /// @param block the result (getBlockSize() bytes, aligned on 4 bytes)
+    ///
+    static void encodeBlock(const float* frames, unsigned long frameCount,
+                            unsigned long vectSize, unsigned long bits,
+                            char* block);
+
+    /// Decodes a block of frames
+    /// @param block the block (aligned on 4 bytes)
+    /// @param frameCount the number of frames of the block
+    /// @param vectSize the dimension of the frames
+    /// @param bits 8 or 16
+    /// @param frames the result, row-major (frameCount x vectSize)
+    ///
+    static void decodeBlock(const char* block, unsigned long frameCount,
+                            unsigned long vectSize, unsigned long bits,
+                            float* frames);
+
+    /// Measures the impact of the quantization on the scores : the
+    /// frames of the stream are scored against the mixture before and
+    /// after a quantization.
+    /// @param ss the stat server used to score the frames
+    /// @param m the mixture
+    /// @param s the frames (read from the beginning of the stream)
+    /// @param bits 8 or 16
+    /// @param scoreError absolute difference between the mean
+    ///     log-likelihoods of the stream (the score of a segment)
+    /// @param meanFrameError mean absolute difference between the
+    ///     log-likelihoods of the frames
+    /// @param maxFrameError max absolute difference between the
+    ///     log-likelihoods of the frames
+    /// @return the number of frames scored
+    ///
+    static unsigned long measureLLKError(StatServer& ss, const Mixture& m,
+                            FeatureInputStream& s, unsigned long bits,
+                            real_t& scoreError, real_t& meanFrameError,
+                            real_t& maxFrameError);
+
+  private :
+
+    FeatureCodec(); /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_FeatureCodec_h)
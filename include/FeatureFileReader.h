@@ -136,6 +136,8 @@ namespace alize
                              const std::string& srcName = "");
     virtual bool addFeature(const Feature& f);
     virtual bool readFeature(Feature& f, unsigned long s = 1);
+    virtual unsigned long readFeatures(FeatureBlock& b,
+                                       unsigned long maxFrames);
 
     virtual bool writeFeature(const Feature& f, unsigned long step = 1);
 
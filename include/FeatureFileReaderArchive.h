@@ -0,0 +1,134 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_FeatureFileReaderArchive_h)
+#define ALIZE_FeatureFileReaderArchive_h
+
+#include <memory>
+#include "alize_util.h"
+#include "FeatureFileReaderSingle.h"
+
+namespace alize
+{
+  class LabelServer;
+  class Config;
+  class FeatureArchive;
+
+  /// Convenient class for reading the features of an utterance of a
+  /// feature archive (see FeatureArchive). The archive is given by the
+  /// parameter 'loadFeatureFileArchive' and is opened once for all the
+  /// readers (see FeatureArchive::open()). The reader keeps the archive
+  /// open until it is destroyed. The name of the file to read is the name
+  /// of the utterance in the archive (no path nor extension).
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API FeatureFileReaderArchive : public FeatureFileReaderSingle
+  {
+    friend class TestFeatureFileReaderArchive;
+
+  public :
+
+    /// Creates a reader for an utterance of a feature archive.
+    /// @param f the name of the utterance
+    /// @param c the configuration to use
+    /// @param ls address of a label server. can be NULL.
+    /// @exception Exception if the utterance is not in the archive
+    ///
+    FeatureFileReaderArchive(const FileName& f,
+       const Config& c, LabelServer* ls = NULL,
+       BufferUsage b = BUFFER_AUTO, unsigned long bufferSize = 0,
+       HistoricUsage = ALL_FEATURES, unsigned long historicSize = 0);
+
+    /// See constructor with same parameters
+    ///
+    static FeatureFileReaderArchive& create(const FileName&,
+       const Config& c, LabelServer* ls = NULL,
+       BufferUsage b = BUFFER_AUTO, unsigned long bufferSize = 0,
+       HistoricUsage = ALL_FEATURES, unsigned long historicSize = 0);
+
+    virtual ~FeatureFileReaderArchive();
+
+    virtual unsigned long getFeatureCount();
+    virtual unsigned long getVectSize();
+    virtual const FeatureFlags& getFeatureFlags();
+    virtual real_t getSampleRate();
+
+    virtual std::string getClassName() const;
+
+  protected :
+
+    virtual unsigned long loadFrames(FloatVector& v, unsigned long start);
+
+  private :
+
+    std::shared_ptr<FeatureArchive> _pArchive;
+    unsigned long                   _entryIndex;
+
+    static std::shared_ptr<FeatureArchive> getArchive(const Config& c);
+
+    bool operator==(const FeatureFileReaderArchive&)
+                         const; /*!Not implemented*/
+    bool operator!=(const FeatureFileReaderArchive&)
+                         const; /*!Not implemented*/
+    const FeatureFileReaderArchive& operator=(
+             const FeatureFileReaderArchive&); /*!Not implemented*/
+    FeatureFileReaderArchive(
+             const FeatureFileReaderArchive&); /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_FeatureFileReaderArchive_h)
@@ -64,8 +64,23 @@ namespace alize
 {
   class Config;
   class FileReader;
+  class MappedFile;
   
-  /// Abstract base class for feature file readers
+  /// Abstract base class for feature file readers.\n
+  /// If the parameter 'loadFeatureFileMapping' is true, the file is
+  /// memory mapped (see MappedFile) instead of being read into the
+  /// feature buffer : the features are converted directly from the pages
+  /// of the file, which are shared by all the processes reading the same
+  /// file. The bytes of a frame are swapped only when the frame is read.
+  /// The features of a mapped file cannot be written.\n
+  /// If the parameter 'loadFeatureFileReadAhead' is true (and the file is
+  /// not mapped), a second buffer of the same size is filled by a
+  /// background thread with the block which follows the current one,
+  /// while the caller reads the current block.
+  /// When the features are read sequentially, the next block is usually
+  /// loaded when the current one ends and the buffers are just swapped.
+  /// A seek outside of these blocks waits for the thread and loads the
+  /// buffer as usual.
   /// @author Frederic Wils  frederic.wils@lia.univ-avignon.fr
   /// @version 1.0
   /// @date 2003
@@ -86,6 +101,14 @@ namespace alize
     virtual void close();
 
     virtual bool readFeature(Feature&, unsigned long step = 1);
+
+    /// Reads consecutive features without copy : the block is an alias of
+    /// the buffer of the reader or of the mapped file. A big endian
+    /// mapped file is copied and swapped, and the frames are copied too
+    /// if the buffer is smaller than the block.
+    ///
+    virtual unsigned long readFeatures(FeatureBlock& b,
+                                       unsigned long maxFrames);
     virtual bool addFeature(const Feature& f);
     virtual bool writeFeature(const Feature& f, unsigned long step = 1);
     virtual unsigned long getSourceCount();
@@ -116,15 +139,50 @@ namespace alize
     unsigned long   _nbStored;
     FloatVector*    _pBuffer;
     Feature         _f;
+    unsigned long   _fileFeatureIndex; // next feature read from the file
+    // memory mapping
+    bool            _mappingWanted;
+    MappedFile*     _pMappedFile;
+    FloatVector     _frameVect; // frame to swap or to align
+    // read-ahead
+    bool            _readAheadWanted;
+    // label code of the frames of the buffer (or of the mapped file),
+    // valid for a revision of the label server
+    unsigned long   _labelCode;
+    bool            _labelCodeDefined;
+    unsigned long long _labelServerRevision;
 
     std::string getPath(const FileName&, const Config&) const;
     std::string getExt(const FileName&, const Config&) const;
     bool getBigEndian(const Config&, BigEndian) const;
+    /// Loads the features from 'start' in a vector, as many as it can
+    /// hold. Overridden by the readers of files which are not arrays of
+    /// floats. Also called by the read-ahead thread.
+    /// @param v the vector to fill
+    /// @param start index of the first feature
+    /// @return the number of features loaded
+    ///
+    virtual unsigned long loadFrames(FloatVector& v, unsigned long start);
+    /// Stops the read-ahead thread. Must be called by the destructor of
+    /// each subclass : the thread calls virtual methods (loadFrames())
+    /// which must not run on a partly destroyed reader.
+    ///
+    void stopReadAhead();
 
   private :
 
+    struct ReadAhead;
+    ReadAhead*      _pReadAhead;
+
     virtual unsigned long getHeaderLength();
     bool featureWantedIsInHistoric() const;
+    void mapFile();
+    void setMappedData(Feature& f);
+    unsigned long getBufferStart(unsigned long featureIndex,
+                                 unsigned long featureCount);
+    bool useReadAhead(unsigned long start);
+    void startReadAhead(unsigned long featureCount);
+    void waitReadAhead();
   };
 
 } // end namespace alize
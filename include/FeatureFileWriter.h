@@ -55,8 +55,10 @@
 #if !defined(ALIZE_FeatureFileWriter_h)
 #define ALIZE_FeatureFileWriter_h
 
+#include <stdint.h>
 #include "alize_util.h"
 #include "FileWriter.h"
+#include "RealVector.h"
 
 namespace alize
 {
@@ -68,6 +70,10 @@ namespace alize
   In the RAW format, the dimension of the features is not saved. Each data
   of each feature is saved as a double float value (8 bytes).
   In the SPRO formats, the flags comes from the configuration.
+  In the COMPRESSED format, the features are quantized by blocks (see
+  FeatureCodec) with 16 bits, or 8 bits if the parameter
+  'saveFeatureFileCompressionBits' is 8. The flags and the sample rate
+  come from the configuration.
   A raw file can be read using a FeatureFileReaderRaw object.\n
   
   @author Frederic Wils  frederic.wils@lia.univ-avignon.fr
@@ -123,6 +129,16 @@ namespace alize
     unsigned long           _featureCount;
     bool                    _headerWritten; // for SPRO format
     const Config&           _config;
+    // COMPRESSED format
+    unsigned long           _bits;
+    FloatVector             _frames;       // frames of the current block
+    unsigned long           _blockFrameCount;
+    FloatVector             _block;        // encoded block
+    RealVector<uint64_t>    _blockOffsets; // position of each block
+
+    void writeBlock();
+    uint64_t tell();
+    void writeCompressedHeader(uint64_t indexOffset);
 
      std::string getFullFileName(const Config& c, const  std::string& n) const;
     FeatureFileWriter(const FeatureFileWriter&);   /*!Not implemented*/
@@ -63,6 +63,7 @@
 namespace alize
 {
   class Feature;
+  class FeatureBlock;
   class LabelServer;
   class Config;
   
@@ -117,6 +118,20 @@ namespace alize
     ///
     virtual bool readFeature(Feature& f, unsigned long s = 1) = 0;
 
+    /// Reads consecutive features in single precision, without the
+    /// conversion of each frame to a Feature when the stream allows it.
+    /// The block can be an alias of the stream memory, valid until the
+    /// next read. The labels of the features are not returned.\n
+    /// This implementation copies the features returned by readFeature().
+    /// The reading stops before an invalid feature (see getError()).
+    /// @param b the block to store the data read
+    /// @param maxFrames maximum number of features to read
+    /// @return the number of features read (0 at the end of the stream)
+    /// @exception IOException if an I/O error occurs
+    ///
+    virtual unsigned long readFeatures(FeatureBlock& b,
+                                       unsigned long maxFrames);
+
     /// adds a feature in the buffer is enougth memory have been allocated by 
     /// featureServerMemAlloc option
     /// @param f the feature to add in the buffer
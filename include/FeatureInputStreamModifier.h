@@ -59,6 +59,7 @@
 #include "FeatureInputStream.h"
 
 #include "Feature.h"
+#include "FeatureBlock.h"
 #include "ULongVector.h"
 
 namespace alize
@@ -107,6 +108,13 @@ namespace alize
 
     virtual bool readFeature(Feature& f, unsigned long step = 1);
 
+    /// Reads a block from the input stream and selects the parameters of
+    /// the mask in each frame. Without mask, the block of the input stream
+    /// is returned as it is.
+    ///
+    virtual unsigned long readFeatures(FeatureBlock& b,
+                                       unsigned long maxFrames);
+
     virtual bool writeFeature(const Feature& f, unsigned long step = 1);
 
     /// Returns the number of features in the file.
@@ -191,6 +199,7 @@ namespace alize
 
     FeatureInputStream* _pInput;
     Feature             _feature;
+    FeatureBlock        _block;
     std::string              _mask;
     std::string              _tmpMask;
     ULongVector         _selection;
@@ -119,6 +119,14 @@ namespace alize
 
     virtual bool readFeature(Feature& f, unsigned long step = 1);
 
+    /// Reads consecutive features of the current file by block (see
+    /// FeatureFileReaderSingle::readFeatures()). A block does not go
+    /// beyond the end of a file : it can have less than maxFrames
+    /// frames before the end of the list.
+    ///
+    virtual unsigned long readFeatures(FeatureBlock& b,
+                                       unsigned long maxFrames);
+
     virtual bool writeFeature(const Feature& f, unsigned long step = 1);
 
     /// Returns the number of features in all the files
@@ -218,7 +226,7 @@ namespace alize
     FeatureFileReader** createReaderPtrVect();
     FloatVector**       createBufferPtrVect();
     FeatureFileReader&  getReader(unsigned long idx);
-    bool                rw(bool, Feature&, unsigned long);
+    bool                rw(bool, Feature*, FeatureBlock*, unsigned long);
     bool                featureWantedIsInHistoric(unsigned long n) const;
 
     bool operator==(const FeatureMultipleFileReader&)
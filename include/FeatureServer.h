@@ -222,6 +222,15 @@ namespace alize
     ///    
     virtual bool readFeature(Feature& f, unsigned long s = 1);
 
+    /// Reads consecutive features in single precision (see
+    /// FeatureInputStream::readFeatures())
+    /// @param b the block to store the data read
+    /// @param maxFrames maximum number of features to read
+    /// @return the number of features read (0 at the end of the stream)
+    ///
+    virtual unsigned long readFeatures(FeatureBlock& b,
+                                       unsigned long maxFrames);
+
     /// adds a feature
     /// @param f the feature to store the data read
     /// @return false not possible to add feature
@@ -174,6 +174,14 @@ namespace alize
     /// @exception IOException if an I/O error occurs
     ///
     unsigned long readSomeFloats(FloatVector& v);
+
+    /// Reads bytes without conversion
+    /// @param buffer the memory to fill
+    /// @param length number of bytes to read
+    /// @exception IOException if an I/O error occurs
+    /// @exception EOFException if end of file has been reached
+    ///
+    void readBytes(void* buffer, unsigned long length);
     
     /// Reads the next line of text from the input stream. It reads
     /// successive bytes until it encounters a line terminator or end of
@@ -221,11 +229,11 @@ namespace alize
     /// @exception IOException if an I/O error occurs
     /// @return the length of the file in bytes
     ///
-    unsigned long getFileLength();
+    unsigned long long getFileLength();
 
     /// @exception IOException if an I/O error occurs
     ///
-    void seek(unsigned long pos);
+    void seek(unsigned long long pos);
 
     void rewind();
     long tell();
@@ -250,7 +258,7 @@ namespace alize
     FileName       _fileName;
     std::string         _path;
     std::string         _extension;
-    unsigned long  _fileLength;
+    unsigned long long _fileLength;
     bool           _fileLengthDefined;
     mutable std::string _string; /*! to store temporary data */
     bool           _swap; /*! flag for numeric data */
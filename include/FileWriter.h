@@ -128,6 +128,11 @@ namespace alize
     ///
     void writeString(const std::string& string);
 
+    /// Writes bytes without any conversion
+    /// @exception IOException if an I/O error occurs
+    ///
+    void writeBytes(const void* buffer, unsigned long length);
+
     /// @exception IOException if an I/O error occurs
     ///
     void writeAttribute(const std::string& name, const std::string& value);
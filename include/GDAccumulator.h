@@ -0,0 +1,218 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_GDAccumulator_h)
+#define ALIZE_GDAccumulator_h
+
+#include "alize_util.h"
+#include "Object.h"
+#include "ExactAccumulator.h"
+
+namespace alize
+{
+  /// Flat accumulators of the EM statistics of a diagonal gaussian
+  /// mixture : for each distribution c, the zero order statistic
+  /// (occupation) sum_n g[n][c], the first order statistics
+  /// sum_n g[n][c]*x[n] and the second order statistics
+  /// sum_n g[n][c]*x[n]^2 (g : posteriors multiplied by the weights of the
+  /// frames).\n
+  /// The statistics of the distribution c are stored at
+  /// array[c*getStride()+i]. The rows are aligned for the SIMD
+  /// instructions. The buffers are kept by reset() and by setDimensions()
+  /// when the dimensions do not grow.\n
+  /// In exact mode (setExact()), the statistics are summed by an
+  /// ExactAccumulator and do not depend on the order of the frames. The
+  /// arrays are then copies of the exact sums, updated when they are read
+  /// (values written in these arrays are lost).
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API GDAccumulator : public Object
+  {
+
+  public :
+
+    explicit GDAccumulator(unsigned long distribCount = 0,
+                           unsigned long vectSize = 0);
+    virtual ~GDAccumulator();
+
+    /// Sets the dimensions and resets the statistics
+    /// @param distribCount the number of distributions
+    /// @param vectSize the dimension of the frames
+    ///
+    void setDimensions(unsigned long distribCount, unsigned long vectSize);
+
+    /// Sets all the statistics and the frame count to 0
+    ///
+    void reset();
+
+    /// Activates or deactivates the exact mode and resets the statistics
+    ///
+    void setExact(bool exact);
+    bool isExact() const;
+
+    /// Accumulates the statistics of a frame for one distribution
+    /// @param c index of the distribution
+    /// @param occ the weighted posterior of the distribution
+    /// @param x the frame [vectSize]
+    ///
+    void accumulate(unsigned long c, occ_t occ, const real_t* x);
+
+    /// Same as above with a frame in single precision
+    ///
+    void accumulate(unsigned long c, occ_t occ, const float* x);
+
+    /// Accumulates the statistics of several frames for one distribution.
+    /// Same statistics as a call of the method above per frame. In exact
+    /// mode the frames are summed together (see
+    /// ExactAccumulator::addMoments()).
+    /// @param c index of the distribution
+    /// @param occ the weighted posteriors of the distribution [frameCount]
+    /// @param x the frames [frameCount][vectSize]
+    /// @param frameCount the number of frames
+    ///
+    void accumulate(unsigned long c, const occ_t* occ, const float* x,
+                    unsigned long frameCount);
+
+    /// Adds the statistics of another accumulator
+    /// @param a the accumulator
+    /// @exception Exception if the dimensions are different
+    ///
+    void add(const GDAccumulator& a);
+
+    occ_t* getZeroOrderArray();
+    const occ_t* getZeroOrderArray() const;
+
+    real_t* getFirstOrderArray();
+    const real_t* getFirstOrderArray() const;
+
+    real_t* getSecondOrderArray();
+    const real_t* getSecondOrderArray() const;
+
+    /// Returns the first order statistics of a distribution [vectSize]
+    ///
+    const real_t* getFirstOrder(unsigned long c) const;
+
+    /// Returns the second order statistics of a distribution [vectSize]
+    ///
+    const real_t* getSecondOrder(unsigned long c) const;
+
+    /// Returns the sum of the weights of the accumulated frames
+    ///
+    real_t getFeatureCount() const;
+
+    /// Adds a weight to the count of accumulated frames
+    ///
+    void addFeatureCount(real_t w);
+
+    /// Sets the count of accumulated frames
+    /// @exception Exception in exact mode
+    ///
+    void setFeatureCount(real_t n);
+
+    /// Returns the number of values copied by writeExactState() (exact
+    /// mode)
+    ///
+    unsigned long getExactStateSize() const;
+
+    /// Copies the exact sums [getExactStateSize()] (see
+    /// ExactAccumulator::write())
+    ///
+    void writeExactState(double* p) const;
+
+    /// Sets the exact sums [getExactStateSize()] written by
+    /// writeExactState()
+    ///
+    void readExactState(const double* p);
+
+    unsigned long getDistribCount() const;
+    unsigned long getVectSize() const;
+
+    /// Returns the distance between the statistics of two distributions
+    /// in the first and second order arrays
+    ///
+    unsigned long getStride() const;
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    unsigned long  _distribCount;
+    unsigned long  _vectSize;
+    unsigned long  _stride;
+    unsigned long  _capacity; // size of the first and second order arrays
+    unsigned long  _zeroCapacity;
+    occ_t*         _zeroArray;
+    real_t*        _firstArray;
+    real_t*        _secondArray;
+    real_t         _featureCount;
+    bool           _exact;
+    // exact mode : [distribCount][zero, first[vectSize], second[vectSize]]
+    // and frame count
+    ExactAccumulator _exactAcc;
+    mutable bool   _synchronized; // arrays up to date with _exactAcc
+
+    void synchronize() const;
+
+    GDAccumulator(const GDAccumulator&); /*!Not implemented*/
+    const GDAccumulator& operator=(const GDAccumulator&); /*!Not implemented*/
+    bool operator==(const GDAccumulator&) const; /*!Not implemented*/
+    bool operator!=(const GDAccumulator&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_GDAccumulator_h)
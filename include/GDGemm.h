@@ -0,0 +1,140 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_GDGemm_h)
+#define ALIZE_GDGemm_h
+
+#include "alize_util.h"
+#include "Object.h"
+
+namespace alize
+{
+  class MixtureGDPacked;
+
+  /// Scores a block of frames against all the distributions of a diagonal
+  /// gaussian mixture with a matrix product.\n
+  /// The quadratic form of the distribution c is expanded :\n
+  /// log(w[c]*lk(c,x)) = sum_i x[i]^2*(-0.5*covInv[c][i])
+  ///                   + sum_i x[i]*(mean[c][i]*covInv[c][i]) + k[c]\n
+  /// so that the scores of N frames are the product of the N x (2D+1)
+  /// matrix [x^2 | x | 1] by the (2D+1) x C matrix stored by
+  /// MixtureGDPacked::getGemmArray().\n
+  /// The product is computed by a cache-blocked, register-tiled kernel
+  /// (AVX-512, AVX2+FMA, SSE2 or plain C++ according to
+  /// GDKernel::getSimdLevel()). When the library is compiled with
+  /// ALIZE_USE_BLAS (configure --with-blas), the product is delegated to
+  /// cblas_dgemm().\n
+  /// The expanded form is faster than the direct form used by GDKernel
+  /// when many frames are scored at once but it is less accurate for
+  /// frames very far from the means (absolute error about 1e-12 on the
+  /// log-likelihoods of usual features).
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API GDGemm
+  {
+
+  public :
+
+    /// Computes the weighted log-likelihoods log(w[c]*lk(c, x[n])) between
+    /// a block of frames and all the distributions of a packed mixture.
+    /// A frame which contains a NaN gets log(w[c]*EPS_LK) like in
+    /// GDKernel::computeWeightedLogLK().
+    /// @param m the packed mixture
+    /// @param frames the frames, row-major (frameCount x vectSize)
+    /// @param frameCount the number of frames in the block
+    /// @param llk the result, row-major (frameCount x distribCount)
+    ///
+    static void computeWeightedLogLK(const MixtureGDPacked& m,
+                                     const real_t* frames,
+                                     unsigned long frameCount, lk_t* llk);
+
+    /// Same as above with float frames (see FeatureBlock). The
+    /// computations are done in double precision.
+    ///
+    static void computeWeightedLogLK(const MixtureGDPacked& m,
+                                     const float* frames,
+                                     unsigned long frameCount, lk_t* llk);
+
+    /// Computes the matrix product C = A x B, or C += A x B (row-major
+    /// matrices)
+    /// @param n the number of rows of A and C
+    /// @param m the number of columns of B and C
+    /// @param k the number of columns of A and of rows of B
+    /// @param a the matrix A
+    /// @param lda distance between two rows of A
+    /// @param b the matrix B
+    /// @param ldb distance between two rows of B
+    /// @param c the matrix C
+    /// @param ldc distance between two rows of C
+    /// @param add true to add the product to C
+    ///
+    static void multiply(unsigned long n, unsigned long m, unsigned long k,
+                         const real_t* a, unsigned long lda,
+                         const real_t* b, unsigned long ldb,
+                         real_t* c, unsigned long ldc, bool add = false);
+
+    /// Returns true if the products are computed by a BLAS library
+    ///
+    static bool isBlasUsed();
+
+  private :
+
+    GDGemm(); /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_GDGemm_h)
@@ -0,0 +1,185 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_GDKernel_h)
+#define ALIZE_GDKernel_h
+
+#include "alize_util.h"
+#include "Object.h"
+
+namespace alize
+{
+  class MixtureGDPacked;
+
+  /// Instruction sets used by the vectorized kernels
+  ///
+  enum SimdLevel
+  {
+    SimdLevel_SCALAR,
+    SimdLevel_SSE2,
+    SimdLevel_AVX2,
+    SimdLevel_AVX512
+  };
+
+  /// Vectorized kernels used to score blocks of frames against all the
+  /// distributions of a diagonal gaussian mixture (see MixtureGDPacked).\n
+  /// The instruction set is chosen at runtime according to the CPU
+  /// (AVX-512, AVX2+FMA, SSE2 or plain C++). The SIMD versions use their
+  /// own exponential and differ from the scalar version by a relative error
+  /// lower than 1e-13. The scalar version performs exactly the same
+  /// operations as DistribGD::computeLK() and gives the same results.
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API GDKernel
+  {
+
+  public :
+
+    /// Computes the weighted likelihoods w[c]*lk(c, x[n]) between a block
+    /// of frames and all the distributions of a packed mixture.
+    /// @param m the packed mixture
+    /// @param frames the frames, row-major (frameCount x vectSize)
+    /// @param frameCount the number of frames in the block
+    /// @param lk the result, row-major (frameCount x distribCount)
+    ///
+    static void computeWeightedLK(const MixtureGDPacked& m,
+                                  const real_t* frames,
+                                  unsigned long frameCount, lk_t* lk);
+
+    /// Same as above with float frames (see FeatureBlock). The frames are
+    /// converted in the registers : the computations and the results are
+    /// in double precision.
+    ///
+    static void computeWeightedLK(const MixtureGDPacked& m,
+                                  const float* frames,
+                                  unsigned long frameCount, lk_t* lk);
+
+    /// Same as computeWeightedLK() in the log domain :
+    /// log(w[c]) + log(cst[c]) - 0.5*(x-mean[c])'covInv[c](x-mean[c]).
+    /// No exponential is computed and the result does not underflow.
+    /// @param m the packed mixture
+    /// @param frames the frames, row-major (frameCount x vectSize)
+    /// @param frameCount the number of frames in the block
+    /// @param llk the result, row-major (frameCount x distribCount)
+    ///
+    static void computeWeightedLogLK(const MixtureGDPacked& m,
+                                     const real_t* frames,
+                                     unsigned long frameCount, lk_t* llk);
+
+    /// Same as above with float frames
+    ///
+    static void computeWeightedLogLK(const MixtureGDPacked& m,
+                                     const float* frames,
+                                     unsigned long frameCount, lk_t* llk);
+
+    /// Computes log(sum(exp(v[i]))) without overflow nor underflow
+    /// (the maximum value is factored out)
+    /// @param v the values
+    /// @param n the number of values
+    /// @return the result, LOG_ZERO if n == 0
+    ///
+    static lk_t logSumExp(const lk_t* v, unsigned long n);
+
+    /// Computes the posterior probabilities exp(llk[i]-logSumExp(llk))
+    /// @param llk the weighted log-likelihoods of the distributions
+    /// @param n the number of distributions
+    /// @param post the result [n]
+    /// @return logSumExp(llk), the log-likelihood of the mixture
+    ///
+    static lk_t computePosteriors(const lk_t* llk, unsigned long n,
+                                  occ_t* post);
+
+    /// Returns the instruction set used by the kernels
+    ///
+    static SimdLevel getSimdLevel();
+
+    /// Forces the instruction set used by the kernels. A level which is
+    /// not supported by the CPU is replaced by the best supported one.
+    /// @param l the instruction set
+    ///
+    static void setSimdLevel(SimdLevel l);
+
+    /// Returns the best instruction set supported by the CPU
+    ///
+    static SimdLevel detectSimdLevel();
+
+    static std::string getSimdLevelName(SimdLevel l);
+
+    /// Allocates an array of reals aligned on MixtureGDPacked::ALIGNMENT
+    /// bytes
+    /// @param size number of values
+    /// @exception OutOfMemoryException
+    ///
+    static real_t* createAlignedArray(unsigned long size);
+
+    /// Frees an array allocated with createAlignedArray()
+    ///
+    static void deleteAlignedArray(real_t* p);
+
+    /// Value used in the log domain for a null likelihood or weight
+    ///
+    static const lk_t LOG_ZERO;
+
+  private :
+
+    static SimdLevel _simdLevel;
+
+    GDKernel(); /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_GDKernel_h)
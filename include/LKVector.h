@@ -125,6 +125,16 @@ namespace alize
     ///
     void descendingSort() const;
 
+    /// Partial sort : moves the n greatest values (by decreasing lk) to
+    /// the beginning of the vector. The other values follow in an
+    /// unspecified order. Much faster than descendingSort() when n is
+    /// small compared to the size of the vector.
+    /// @param n the number of values to sort
+    /// @param stable if true, values with the same lk are sorted by
+    ///     increasing idx
+    ///
+    void descendingSort(unsigned long n, bool stable = false) const;
+
     /// Use this method to access directly to the internal vector
     /// @return a pointer on the first element
     /// @warning Fast but dangerous ! Use preferably operator [].
@@ -55,6 +55,7 @@
 #if !defined(ALIZE_LabelServer_h)
 #define ALIZE_LabelServer_h
 
+#include <map>
 #include "alize_util.h"
 #include "Object.h"
 #include "RefVector.h"
@@ -96,7 +97,10 @@ namespace alize
     /// nouveau label. Dans le cas contraire, il ajoute une copie de ce
     /// label à la fin de sa liste de label et retourne l'index.
     /// On peut forcer l'ajout d'un label dans le cas ou un exemplaire
-    /// existe déjà
+    /// existe déjà.
+    /// </FRANCAIS>
+    /// The labels are indexed by their string and source name, so the
+    /// search does not scan the labels.
     /// @param l The object to add. The Label object stored is a copy
     ///    of this parameter.\n
     /// @param forceAdd force the add of the label
@@ -113,12 +117,13 @@ namespace alize
     void setLabel(const Label& l, unsigned long index) const;
 
     /// Returns a reference to the label stored inside the server at a
-    /// specific position
+    /// specific position. The label is indexed by its value (see
+    /// addLabel()) : use setLabel() to change it.
     /// @param index the position of the label inside the server
     /// @exception IndexOutOfBoundsException
     /// @return a reference to the label
     ///
-    Label& getLabel(unsigned long index) const;
+    const Label& getLabel(unsigned long index) const;
 
     /// Find and returns the index of a label
     /// @param s the string used as a key to search the label
@@ -138,6 +143,13 @@ namespace alize
     ///
     unsigned long size() const;
 
+    /// Returns the revision of the server. It changes each time labels
+    /// are replaced or deleted (setLabel(), clear()) : an index returned
+    /// by addLabel() is valid while the revision does not change.
+    /// @return the revision
+    ///
+    unsigned long long getRevision() const;
+
     virtual std::string getClassName() const;
 
 
@@ -146,6 +158,13 @@ namespace alize
     unsigned long   _first; /*! index of the first non-predefined label */
     unsigned long   _lastAdded;/*! index of the last label added*/
     RefVector<Label> _vect;
+    mutable std::map<std::string, unsigned long> _indexMap; /*! key ->
+                                                     index of first label */
+    mutable unsigned long long _revision; /*! see getRevision() */
+
+    static std::string getKey(const Label& l);
+    long findLabel(const Label& l) const;
+    void updateIndex() const;
 
     LabelServer(const LabelServer&); /*! Not implemented */
     const LabelServer& operator=(const LabelServer&); /*! Not implemented*/
@@ -0,0 +1,200 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_LinearScorer_h)
+#define ALIZE_LinearScorer_h
+
+#include "alize_util.h"
+#include "Object.h"
+#include "RealVector.h"
+#include "Matrix.h"
+#include "XLine.h"
+#include "BaumWelchStatExtractor.h"
+
+namespace alize
+{
+  class Config;
+  class StatServer;
+  class MixtureGD;
+  class FeatureInputStream;
+  class MeanOffsetStore;
+
+  /// Fast approximate scoring of a test utterance against many target
+  /// models which are mean-only MAP adaptations of a world model (same
+  /// weights and covariances, see MAPAdaptation).\n
+  /// With the posteriors of the world model, the difference between the
+  /// EM auxiliary functions of a target and of the world model is :\n
+  /// > sum_c d(c)' covInv(c) F(c) - 0.5 N(c) d(c)' covInv(c) d(c)\n
+  /// where d(c) = mean(target, c) - mean(world, c) and N, F are the
+  /// centered Baum-Welch statistics of the test frames (see
+  /// BaumWelchStatExtractor). Divided by the frame count, it approximates
+  /// the mean log-likelihood ratio of the frames
+  /// (StatServer::computeLLK() of the target minus the one of the world
+  /// model).\n
+  /// Each target is stored as one row [covInv d | -0.5 d' covInv d] and
+  /// the test statistics as one vector [F | N] / frameCount, so the scores
+  /// of all the targets are one matrix-vector product (GDGemm). The
+  /// statistics of the test frames are computed once.
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API LinearScorer : public Object
+  {
+
+  public :
+
+    /// Creates a scorer
+    /// @param c the configuration (see BaumWelchStatExtractor for the top
+    ///     count of the posteriors)
+    /// @param ss the stat server used to compute the test statistics
+    /// @param world the world model. It must not change while the scorer
+    ///     is used
+    ///
+    explicit LinearScorer(const Config& c, StatServer& ss,
+                          const MixtureGD& world);
+    virtual ~LinearScorer();
+
+    /// Adds a target model. Only its means are used.
+    /// @param m the model
+    /// @return the index of the target
+    /// @exception Exception if the dimensions of the model are not the
+    ///     ones of the world model
+    ///
+    unsigned long addTarget(const MixtureGD& m);
+
+    /// Adds all the models of a mean offset store as targets
+    /// @param s the store. Its world model must have the dimensions of the
+    ///     world model of the scorer and the same covariances
+    /// @return the index of the first target added
+    /// @exception Exception if the dimensions of the world model of the
+    ///     store are not the ones of the world model
+    ///
+    unsigned long addTargets(const MeanOffsetStore& s);
+
+    /// Removes all the targets
+    ///
+    void resetTargets();
+
+    unsigned long getTargetCount() const;
+
+    /// Returns the id of the model of a target
+    /// @param k index of the target
+    ///
+    const std::string& getTargetId(unsigned long k) const;
+
+    /// Returns the size of the test statistics vector :
+    /// distribCount*(vectSize+1)
+    ///
+    unsigned long getTestStatSize() const;
+
+    /// Computes the statistics of the features of a stream, from its
+    /// current position to its end
+    /// @param fs the feature stream
+    /// @param stat the test statistics [getTestStatSize()]. Resized
+    /// @return the number of features read
+    ///
+    unsigned long computeTestStat(FeatureInputStream& fs,
+                                  DoubleVector& stat);
+
+    /// Scores a test against all the targets
+    /// @param stat the test statistics given by computeTestStat()
+    /// @param scores the scores [getTargetCount()]. Resized
+    ///
+    void score(const DoubleVector& stat, DoubleVector& scores) const;
+
+    /// Scores the features of a stream against all the targets
+    /// @param fs the feature stream
+    /// @param scores the scores [getTargetCount()]. Resized
+    /// @return the number of features read
+    ///
+    unsigned long score(FeatureInputStream& fs, DoubleVector& scores);
+
+    /// Scores several tests against all the targets with a matrix product
+    /// @param n the zero order statistics (tests x distribCount)
+    /// @param f the CENTERED first order statistics (tests x
+    ///     distribCount*vectSize)
+    /// @param frameCounts the frame counts of the tests
+    /// @param scores the scores (tests x targets). Resized
+    /// @exception Exception if the dimensions are not valid
+    ///
+    void score(const DoubleMatrix& n, const DoubleMatrix& f,
+               const DoubleVector& frameCounts, DoubleMatrix& scores) const;
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    const MixtureGD&       _world;
+    BaumWelchStatExtractor _extractor;
+    unsigned long          _rowSize;  // distribCount*(vectSize+1)
+    unsigned long          _targetCount;
+    unsigned long          _targetCapacity;
+    DoubleVector           _targetArray; // [targets][rowSize]
+    XLine                  _targetIds;
+    DoubleVector           _nVect;    // buffers of computeTestStat()
+    DoubleMatrix           _fMatrix;
+
+    unsigned long addTarget(const std::string& id, const real_t* offsets);
+
+    LinearScorer(const LinearScorer&); /*!Not implemented*/
+    const LinearScorer& operator=(const LinearScorer&); /*!Not implemented*/
+    bool operator==(const LinearScorer&) const; /*!Not implemented*/
+    bool operator!=(const LinearScorer&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_LinearScorer_h)
@@ -0,0 +1,181 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_MAPAdaptation_h)
+#define ALIZE_MAPAdaptation_h
+
+#include "alize_util.h"
+#include "Object.h"
+#include "ThreadPool.h"
+
+namespace alize
+{
+  class Config;
+  class StatServer;
+  class MixtureServer;
+  class MixtureGD;
+  class GDAccumulator;
+  class XList;
+
+  /// Maximum a posteriori adaptation of a world model (UBM) to the data
+  /// of speakers.\n
+  /// For each distribution c, with n(c) the occupation of the
+  /// distribution, E(x) and E(x^2) its mean statistics and r the
+  /// relevance factor, a = n(c) / (n(c) + r) and :\n
+  /// > mean = a E(x) + (1 - a) mean(world)\n
+  /// > cov = a E(x^2) + (1 - a) (cov(world) + mean(world)^2) - mean^2\n
+  /// > weight = a n(c) / T + (1 - a) weight(world), normalized\n
+  /// The means are always adapted, the weights and the variances
+  /// optionally (see setAdaptedParams()). The other parameters are the
+  /// ones of the world model.\n
+  /// The posteriors of each frame are computed once by the world model
+  /// (block version of MixtureGDStat::computeAndAccumulateEM(), with the
+  /// posterior pruning and the accumulation mode given by the
+  /// configuration). The speakers of a list are adapted in parallel by
+  /// the threads of a pool, each speaker by one thread, so the models do
+  /// not depend on the number of threads.\n
+  /// Usage :\n
+  /// > MAPAdaptation map(config, ss, ms);\n
+  /// > map.adapt(world, enrollList); // models added to ms\n
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API MAPAdaptation : public Object
+  {
+
+  public :
+
+    /// Creates an adaptation engine
+    /// @param c the configuration. Parameters : 'MAPRelevanceFactor'
+    ///     (default : 16), 'MAPAdaptWeight' and 'MAPAdaptVar' (default :
+    ///     false), 'threadCount' if threadCount is 0 (default : all the
+    ///     hardware threads)
+    /// @param ss the stat server used to create the accumulators
+    /// @param ms the mixture server which receives the models
+    /// @param threadCount number of threads
+    ///
+    explicit MAPAdaptation(const Config& c, StatServer& ss,
+                           MixtureServer& ms, unsigned long threadCount = 0);
+    virtual ~MAPAdaptation();
+
+    /// Sets the relevance factor
+    /// @param r the relevance factor (> 0)
+    /// @exception Exception if r <= 0
+    ///
+    void setRelevanceFactor(real_t r);
+    real_t getRelevanceFactor() const;
+
+    /// Chooses the parameters adapted in addition to the means
+    /// @param weight true to adapt the weights
+    /// @param var true to adapt the variances
+    ///
+    void setAdaptedParams(bool weight, bool var);
+    bool isWeightAdapted() const;
+    bool isVarAdapted() const;
+
+    /// Adapts the world model with statistics accumulated by the world
+    /// model (MixtureGDStat::getAccumulator(), ParallelEM...)
+    /// @param model the adapted model. It can be the world model itself
+    /// @param world the world model
+    /// @param a the statistics
+    /// @exception Exception if the dimensions are different
+    ///
+    void adapt(MixtureGD& model, const MixtureGD& world,
+               const GDAccumulator& a) const;
+
+    /// Adapts the world model to a list of speakers. Each line of the list
+    /// gives the id of a model followed by its feature files, WITHOUT PATH
+    /// AND EXTENSION (see FeatureServer). The model of an id which is
+    /// already in the mixture server is overwritten, else a new model is
+    /// added to the server. The distributions that such a model shares
+    /// with other mixtures (SHARE_DISTRIB duplication...) are first
+    /// replaced by copies : only the model is modified.
+    /// @param world the world model
+    /// @param list the speakers
+    /// @return the number of features read
+    /// @exception Exception if a line has no id, if an id is the one of
+    ///     the world model or appears twice, or if a model of the server
+    ///     has not the dimensions of the world model
+    ///
+    unsigned long adapt(const MixtureGD& world, const XList& list);
+
+    /// Returns the number of threads
+    ///
+    unsigned long getThreadCount() const;
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    const Config&  _config;
+    StatServer&    _statServer;
+    MixtureServer& _mixtureServer;
+    ThreadPool     _pool;
+    real_t         _relevanceFactor;
+    bool           _adaptWeight;
+    bool           _adaptVar;
+
+    MixtureGD& getModel(const MixtureGD& world, const std::string& id);
+
+    MAPAdaptation(const MAPAdaptation&); /*!Not implemented*/
+    const MAPAdaptation& operator=(const MAPAdaptation&); /*!Not implemented*/
+    bool operator==(const MAPAdaptation&) const; /*!Not implemented*/
+    bool operator!=(const MAPAdaptation&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_MAPAdaptation_h)
@@ -0,0 +1,210 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_MeanOffsetStore_h)
+#define ALIZE_MeanOffsetStore_h
+
+#include <map>
+#include "alize_util.h"
+#include "Object.h"
+#include "RealVector.h"
+#include "XLine.h"
+
+namespace alize
+{
+  class Config;
+  class MixtureGD;
+  class MixtureServer;
+
+  /// Set of models which only differ from a world model (UBM) by their
+  /// means, like the models given by a mean-only MAP adaptation (see
+  /// MAPAdaptation). Only the offsets of the means from the means of the
+  /// world model are stored : distribCount*vectSize values per model, in
+  /// single or double precision. The weights, the covariances and the
+  /// constants are the ones of the world model, which is only referenced.
+  /// A model takes about 3 times less memory than a MixtureGD in double
+  /// precision and 6 times less in single precision.\n
+  /// A full MixtureGD can be rebuilt with getModel() or createModel(), and
+  /// the targets of a LinearScorer can be read from a store directly.\n
+  /// Files (see save()) :\n
+  /// > RAW : header (64 bytes : "ALIZEMOS", version, byte order mark,
+  /// distribCount, vectSize, model count, flags (1 : single precision)),
+  /// then for each model the length of its id (8 bytes), the id padded
+  /// with zeros to a multiple of 8 bytes and the offsets\n
+  /// > XML : <MeanOffsetStore version="1" distribCount="..."
+  /// vectSize="..." singlePrecision="..."> with one element
+  /// <model id="...">offsets</model> per model
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API MeanOffsetStore : public Object
+  {
+
+  public :
+
+    /// Creates an empty store
+    /// @param world the world model. It must not be deleted while the
+    ///     store is used
+    /// @param singlePrecision true to store the offsets as floats
+    ///
+    explicit MeanOffsetStore(const MixtureGD& world,
+                             bool singlePrecision = false);
+    virtual ~MeanOffsetStore();
+
+    const MixtureGD& getWorld() const;
+    bool isSinglePrecision() const;
+
+    /// Adds a model, or replaces the model which has the same id. Only
+    /// its means are used.
+    /// @param m the model
+    /// @return the index of the model
+    /// @exception Exception if the dimensions of the model are not the
+    ///     ones of the world model
+    ///
+    unsigned long addModel(const MixtureGD& m);
+
+    /// Adds a model, or replaces the model which has the same id
+    /// @param id the id of the model
+    /// @param offsets the offsets of the means [distribCount*vectSize]
+    /// @return the index of the model
+    ///
+    unsigned long addModel(const std::string& id, const real_t* offsets);
+
+    /// Removes all the models
+    ///
+    void reset();
+
+    unsigned long getModelCount() const;
+
+    /// Returns the id of a model
+    /// @param k index of the model
+    ///
+    const std::string& getModelId(unsigned long k) const;
+
+    /// Returns the index of a model, or -1 if the id is unknown
+    ///
+    long getModelIndex(const std::string& id) const;
+
+    /// Copies the offsets of the means of a model
+    /// @param k index of the model
+    /// @param offsets the offsets [distribCount*vectSize]
+    ///
+    void getOffsets(unsigned long k, real_t* offsets) const;
+
+    /// Sets a mixture to a model : the world model with the means of the
+    /// model. The id of the mixture does not change.
+    /// @param k index of the model
+    /// @param m the mixture
+    /// @exception Exception if the dimensions of the mixture are not the
+    ///     ones of the world model
+    ///
+    void getModel(unsigned long k, MixtureGD& m) const;
+
+    /// Creates a mixture of a mixture server for a model
+    /// @param k index of the model
+    /// @param ms the mixture server
+    /// @return the mixture, with the id of the model
+    ///
+    MixtureGD& createModel(unsigned long k, MixtureServer& ms) const;
+
+    /// Saves the store. Like the mixtures, the path and the extension of
+    /// the file are given by the parameters 'mixtureFilesPath' and
+    /// 'saveMixtureFileExtension' unless the name begins with "/" or "./",
+    /// and the format by 'saveMixtureFileFormat' (RAW or XML, XML if the
+    /// parameter does not exist and the name ends with ".xml").
+    /// @param f the file
+    /// @param c the configuration
+    /// @exception IOException if the file cannot be written
+    /// @exception Exception in XML if a model id contains '"', '<' or '&'
+    ///
+    void save(const FileName& f, const Config& c) const;
+
+    /// Loads the models of a file written by save() (the format is
+    /// detected) and adds them to the store. The path and the extension
+    /// are given by 'mixtureFilesPath' and 'loadMixtureFileExtension'.
+    /// @param f the file
+    /// @param c the configuration
+    /// @exception InvalidDataException if the file is not valid or if its
+    ///     dimensions are not the ones of the world model
+    ///
+    void load(const FileName& f, const Config& c);
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    const MixtureGD& _world;
+    bool             _singlePrecision;
+    unsigned long    _offsetCount;  // distribCount*vectSize
+    unsigned long    _modelCount;
+    unsigned long    _capacity;
+    DoubleVector     _doubleArray;  // [models][offsetCount]
+    FloatVector      _floatArray;   // same, in single precision
+    XLine            _ids;
+    std::map<std::string, unsigned long> _indexMap;
+
+    void loadRaw(const FileName& f);
+    void loadXml(const FileName& f);
+
+    MeanOffsetStore(const MeanOffsetStore&); /*!Not implemented*/
+    const MeanOffsetStore& operator=(const MeanOffsetStore&); /*!Not implemented*/
+    bool operator==(const MeanOffsetStore&) const; /*!Not implemented*/
+    bool operator!=(const MeanOffsetStore&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_MeanOffsetStore_h)
@@ -192,6 +192,15 @@ namespace alize
     void setId(const K&, const std::string& id);
     void setId(const std::string& id);
 
+    /// Returns the revision of the mixture. The revision is taken from
+    /// the same global counter as the distributions (see
+    /// Distrib::getRevision()) each time the weights or the list of the
+    /// distributions may have been modified. It does not change when
+    /// the content of a distribution is modified.
+    /// @return the revision
+    ///
+    unsigned long long getRevision() const;
+
     virtual DistribType getType() const = 0;
 
     /// Internal usage
@@ -220,6 +229,7 @@ namespace alize
     DoubleVector   _weightVect;  // a vector for weights
     DistribRefVector _distribVect; // a vector for distributions
     std::string       _id;      // identifier of the mixture
+    unsigned long long _revision; // see getRevision()
     
     virtual Mixture& clone(DuplDistrib) const = 0;
   };
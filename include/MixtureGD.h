@@ -55,6 +55,7 @@
 #if !defined(ALIZE_MixtureGD_h)
 #define ALIZE_MixtureGD_h
 
+#include <mutex>
 #include "alize_util.h"
 #include "Mixture.h"
 #include "DistribGD.h"
@@ -64,6 +65,7 @@ namespace alize
   class MixtureStat; // TODO : garder ici ?
   class Config;
   class StatServer;
+  class MixtureGDPacked;
 
   /// Class for a mixture of gaussian distributions with diagonal vector
   /// of covariance (DistribGD objects).
@@ -149,12 +151,35 @@ namespace alize
 
     virtual DistribType getType() const;
 
+    /// Returns a packed copy of the mixture used by the vectorized scoring
+    /// kernels (see MixtureGDPacked). The copy is built at the first call
+    /// and built again when the mixture or one of its distributions has
+    /// been modified since the last call.\n
+    /// The copy is built under a lock : a mixture scored by several
+    /// threads should get its copy before the threads start.\n
+    /// The copy is updated in place and is not checked again while the
+    /// caller keeps the reference : the mixture and its distributions must
+    /// NOT be modified, and releasePacked() must not be called, while the
+    /// reference is in use.
+    /// @return the packed copy
+    ///
+    const MixtureGDPacked& getPacked() const;
+
+    /// Deletes the packed copy of the mixture, if it exists, to save
+    /// memory. It will be rebuilt by the next call to getPacked().
+    /// References returned by getPacked() are no longer valid.
+    ///
+    void releasePacked() const;
+
     virtual std::string getClassName() const;
     virtual std::string toString() const;
         
 
   private :
 
+    mutable MixtureGDPacked* _pPacked;
+    mutable std::mutex _packedMutex;
+
     virtual Mixture& clone(DuplDistrib) const;
     virtual MixtureStat& createNewMixtureStatObject(
                      const K&, StatServer&, const Config&) const;
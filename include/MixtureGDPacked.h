@@ -0,0 +1,227 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_MixtureGDPacked_h)
+#define ALIZE_MixtureGDPacked_h
+
+#include "alize_util.h"
+#include "Object.h"
+
+namespace alize
+{
+  class Distrib;
+  class Feature;
+  class MixtureGD;
+
+  /// Packed copy of a MixtureGD used by the vectorized scoring kernels
+  /// (see GDKernel).\n
+  /// Parameters are stored as a structure of arrays, dimension-major :
+  /// for each dimension d, the values of all the distributions are
+  /// contiguous (array[d*getStride()+c]). The distribution count is padded
+  /// up to a multiple of the widest SIMD register so that the kernels
+  /// never have to deal with a partial vector. Padding distributions have
+  /// a null weight and a null constant (GDKernel::LOG_ZERO in the log
+  /// domain).\n
+  /// A packed copy is NOT updated automatically : use isUpToDate() and
+  /// update(), or preferably MixtureGD::getPacked() which does it. A
+  /// caller that keeps a packed copy scores the parameters of the mixture
+  /// at the time of the last update, so the mixture must not be modified
+  /// while the copy is in use.
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API MixtureGDPacked : public Object
+  {
+
+  public :
+
+    /// Builds a packed copy of a mixture
+    /// @param m the mixture
+    ///
+    explicit MixtureGDPacked(const MixtureGD& m);
+    virtual ~MixtureGDPacked();
+
+    /// Packs again the mixture. Buffers are reused when the dimensions
+    /// of the mixture did not change.
+    /// @param m the mixture
+    ///
+    void update(const MixtureGD& m);
+
+    /// Tests whether the packed copy is still equal to the mixture, using
+    /// the revisions of the mixture and of its distributions
+    /// (see Distrib::getRevision())
+    /// @param m the mixture
+    /// @return true if the mixture has not been modified since the last
+    ///     call to update()
+    ///
+    bool isUpToDate(const MixtureGD& m) const;
+
+    /// Computes the weighted likelihoods w[c]*lk(c, f) between a feature
+    /// and all the distributions (see GDKernel::computeWeightedLK())
+    /// @param f the feature
+    /// @param lk the result [distribCount]
+    /// @exception Exception if the feature vectSize does not match the
+    ///      mixture vectSize
+    ///
+    void computeWeightedLK(const Feature& f, lk_t* lk) const;
+
+    /// Computes the weighted log-likelihoods log(w[c]*lk(c, f)) between a
+    /// feature and all the distributions
+    /// (see GDKernel::computeWeightedLogLK())
+    /// @param f the feature
+    /// @param llk the result [distribCount]
+    /// @exception Exception if the feature vectSize does not match the
+    ///      mixture vectSize
+    ///
+    void computeWeightedLogLK(const Feature& f, lk_t* llk) const;
+
+    /// Same as computeWeightedLK() with a frame in single precision
+    /// (see FeatureBlock)
+    /// @param x the frame [vectSize]
+    /// @param lk the result [distribCount]
+    ///
+    void computeWeightedLK(const float* x, lk_t* lk) const;
+
+    /// Same as computeWeightedLogLK() with a frame in single precision
+    /// @param x the frame [vectSize]
+    /// @param llk the result [distribCount]
+    ///
+    void computeWeightedLogLK(const float* x, lk_t* llk) const;
+
+    /// Returns the number of distributions of the source mixture
+    ///
+    unsigned long getDistribCount() const;
+
+    /// Returns the dimension of the distributions
+    ///
+    unsigned long getVectSize() const;
+
+    /// Returns the padded distribution count, i.e. the distance between
+    /// two dimensions in the arrays
+    ///
+    unsigned long getStride() const;
+
+    /// Returns the mean array [vectSize][stride]
+    ///
+    const real_t* getMeanArray() const;
+
+    /// Returns the inverse covariance array [vectSize][stride]
+    ///
+    const real_t* getCovInvArray() const;
+
+    /// Returns the array of the products mean*covInv [vectSize][stride]
+    ///
+    const real_t* getMeanCovInvArray() const;
+
+    /// Returns the right operand of the block scoring product (see
+    /// GDGemm) [2*vectSize+1][stride] :\n
+    /// > rows 0 to vectSize-1 : -0.5*covInv\n
+    /// > rows vectSize to 2*vectSize-1 : mean*covInv\n
+    /// > last row : log(w)+log(cst)-0.5*sum(mean*mean*covInv)
+    ///
+    const real_t* getGemmArray() const;
+
+    /// Returns the constant of each distribution [stride]
+    ///
+    const real_t* getCstArray() const;
+
+    /// Returns the logarithm of the constant of each distribution [stride]
+    ///
+    const real_t* getLogCstArray() const;
+
+    /// Returns the weight of each distribution [stride]
+    ///
+    const weight_t* getWeightArray() const;
+
+    /// Returns the logarithm of the weight of each distribution [stride]
+    ///
+    const weight_t* getLogWeightArray() const;
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+    /// Alignment (in bytes) of all the arrays
+    ///
+    static const unsigned long ALIGNMENT;
+
+  private :
+
+    unsigned long _distribCount;
+    unsigned long _vectSize;
+    unsigned long _stride;
+    real_t*       _meanArray;
+    real_t*       _covInvArray;
+    real_t*       _meanCovInvArray;
+    real_t*       _gemmArray;
+    real_t*       _cstArray;
+    real_t*       _logCstArray;
+    weight_t*     _weightArray;
+    weight_t*     _logWeightArray;
+    const Distrib** _distribArray; // source distributions
+    unsigned long long _revision;  // last revision when packed
+    mutable unsigned long long _checkedRevision; // see isUpToDate()
+
+    void freeArrays();
+
+    MixtureGDPacked(const MixtureGDPacked&); /*!Not implemented*/
+    const MixtureGDPacked& operator=(
+                 const MixtureGDPacked&); /*!Not implemented*/
+    bool operator==(const MixtureGDPacked&) const; /*!Not implemented*/
+    bool operator!=(const MixtureGDPacked&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_MixtureGDPacked_h)
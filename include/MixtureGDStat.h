@@ -58,6 +58,7 @@
 #include "alize_util.h"
 #include "MixtureStat.h"
 #include "MixtureGD.h"
+#include "GDAccumulator.h"
 
 namespace alize
 {
@@ -86,23 +87,132 @@ namespace alize
     /// @return sum of occupations BEFORE normalization
     virtual occ_t computeAndAccumulateEM(const Feature&, double w = 1.0);
 
+    /// Block version of computeAndAccumulateEM(). The posteriors of the
+    /// frames are computed together (N x C matrix G) and the statistics
+    /// are given by one matrix product :
+    /// G' x [X | X^2 | 1] = [first order | second order | occupation].
+    /// The result is the same as frame by frame, except for the rounding
+    /// errors. If the posteriors are pruned (see
+    /// MixtureStat::setPosteriorPruning()), the statistics of the kept
+    /// distributions are accumulated frame by frame instead. With the
+    /// deterministic accumulation, the statistics are the exact sums of
+    /// the products of each frame (same result as frame by frame).
+    /// @param b the frames
+    /// @param w the weight of each frame
+    /// @return sum of the occupations of the frames BEFORE normalization
+    ///
+    virtual occ_t computeAndAccumulateEM(const FeatureBlock& b,
+                                         double w = 1.0);
+
     virtual void addAccEM(const MixtureStat&);
 
     virtual const Mixture& getEM();
 
-    /// Returns the internal mixture used to accumulate data for EM
-    /// @return the internal mixture used to accumulate data for EM
+    /// Returns a mixture which contains the EM accumulators : the first
+    /// order statistics in the mean vectors and the second order
+    /// statistics in the covariance vectors. The mixture is a copy of
+    /// getAccumulator(), updated by each call : it is read-only, use
+    /// getAccumulator() to modify the accumulators.
+    /// @return the mixture
     /// @exception Exception if resetEM() have not been called beforehand
     ///
-    MixtureGD& getInternalAccumEM(); /* NOT VIRTUAL */
+    const MixtureGD& getInternalAccumEM(); /* NOT VIRTUAL */
+
+    // ----------------------- online EM ------------------------
+
+    /// Sets the step sizes of the online EM : the k-th update (k = 0, 1,
+    /// ...) uses the step (k + offset)^-exponent.\n
+    /// If this method is not called, the values are given by the
+    /// parameters 'onlineEMStepExponent' (default : 0.6) and
+    /// 'onlineEMStepOffset' (default : 2) of the configuration, read by
+    /// resetOnlineEM().
+    /// @param exponent the exponent, in ]0.5, 1]
+    /// @param offset the offset, >= 1
+    /// @exception Exception if a value is out of range
+    ///
+    void setOnlineEMStep(real_t exponent, real_t offset);
+
+    /// Starts an online (stepwise) EM from the current mixture. The
+    /// statistics per frame of the mixture (weight, weight x mean and
+    /// weight x (cov + mean^2) of each distribution) are the initial
+    /// online statistics. resetEM() and resetLLK() are called.\n
+    /// Usage, for each mini-batch of frames :\n
+    /// > acc.computeAndAccumulateLLK(f); // optional, for monitoring\n
+    /// > acc.computeAndAccumulateEM(f);  // or a block or ParallelEM\n
+    /// > world = acc.updateOnlineEM();\n
+    /// @exception Exception if the step parameters of the configuration
+    ///     are out of range (see setOnlineEMStep())
+    ///
+    void resetOnlineEM();
+
+    /// Updates the online statistics with the EM statistics accumulated
+    /// since the last update, divided by the weighted frame count :
+    /// s = (1 - step) x s + step x s(mini-batch). The mixture is then
+    /// estimated from s as by getEM(), and resetEM() and resetLLK() are
+    /// called for the next mini-batch. An empty mini-batch does not
+    /// change the statistics.\n
+    /// The mean log-likelihood of the frames accumulated by
+    /// computeAndAccumulateLLK(), computed with the mixture before the
+    /// update, is averaged with the same steps (see getOnlineMeanLLK()).
+    /// @return the updated mixture (the mixture given by getEM())
+    /// @exception Exception if resetOnlineEM() have not been called
+    ///     beforehand
+    ///
+    const Mixture& updateOnlineEM();
+
+    /// Returns the number of updates since resetOnlineEM()
+    ///
+    unsigned long getOnlineEMStepCount() const;
+
+    /// Returns the step of the last update (0 before the first update)
+    ///
+    real_t getOnlineEMStep() const;
+
+    /// Returns the average of the mean log-likelihoods of the mini-batches
+    /// with the weights of the online statistics. It can be used to
+    /// monitor the convergence.
+    /// @exception Exception if no log-likelihood has been accumulated
+    ///
+    lk_t getOnlineMeanLLK() const;
+
+    /// Returns the EM accumulators. They are reused by resetEM(), and
+    /// getEM() always returns the same mixture, so that successive EM
+    /// iterations do not allocate memory.
+    /// @return the accumulators
+    ///
+    GDAccumulator& getAccumulator();
+    const GDAccumulator& getAccumulator() const;
 
     virtual std::string getClassName() const;
   
-  
+  protected :
+
+    virtual unsigned long getAccEMSize() const;
+    virtual void writeAccEM(double* p) const;
+    virtual void readAccEM(const double* p);
+
   private :
 
-    MixtureGD* _pMixForAccumulation;
+    GDAccumulator _accum;
     MixtureGD* _pMixtureForEM;
+    MixtureGD* _pMixForAccumulation; // see getInternalAccumEM()
+    // buffers of the block version of computeAndAccumulateEM()
+    DoubleVector _occBlock;   // posteriors (frames x distribs)
+    DoubleVector _occTBlock;  // weighted posteriors (distribs x frames)
+    DoubleVector _dataBlock;  // [x | x^2 | 1] (frames x 2*vectSize+1)
+    DoubleVector _statBlock;  // statistics (distribs x 2*vectSize+1)
+    // online EM
+    real_t        _onlineStepExponent;
+    real_t        _onlineStepOffset;
+    bool          _onlineStepDefined; // by setOnlineEMStep()
+    DoubleVector  _onlineStat; // [distribs][occ, first, second] per frame
+    unsigned long _onlineStepCount;
+    real_t        _onlineStep;
+    lk_t          _onlineLLK;  // weighted sum of the mean LLK
+    real_t        _onlineLLKWeight;
+
+    void estimateDistrib(unsigned long c, occ_t occ, const real_t* first,
+                         const real_t* second, occ_t totOcc);
 
     MixtureGDStat(const MixtureGDStat&); /*!Not implemented*/
     const MixtureGDStat& operator=(
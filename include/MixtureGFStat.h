@@ -86,6 +86,7 @@ namespace alize
 
     /// @return sum of occupations BEFORE normalization
     virtual occ_t computeAndAccumulateEM(const Feature&, double w = 1.0);
+    using MixtureStat::computeAndAccumulateEM; // block of frames
     virtual void addAccEM(const MixtureStat&);
     virtual const Mixture& getEM();
 
@@ -97,7 +98,12 @@ namespace alize
 
     virtual std::string getClassName() const;
   
-  
+  protected :
+
+    virtual unsigned long getAccEMSize() const;
+    virtual void writeAccEM(double* p) const;
+    virtual void readAccEM(const double* p);
+
   private :
 
     MixtureGF* _pMixForAccumulation;
@@ -216,6 +216,17 @@ namespace alize
     ///
     void deleteUnusedDistribs();
 
+    /// Builds or updates the packed copies of all the mixtures GD
+    /// (see MixtureGD::getPacked()). Packed copies are built on demand
+    /// by the stat servers; call this method to build them beforehand,
+    /// for example after having modified or loaded mixtures.
+    ///
+    void updatePackedMixtures() const;
+
+    /// Deletes the packed copies of all the mixtures GD
+    ///
+    void releasePackedMixtures() const;
+
     //-------------------------------------------------------------------
     
     /// Creates a new distribution GD and adds it to the internal 
@@ -59,12 +59,18 @@
 #include "Object.h"
 #include "StatServer.h"
 #include "RealVector.h"
+#include "ULongVector.h"
+#include "ExactAccumulator.h"
 
 namespace alize
 {
   class Config;
   class Feature;
+  class FeatureBlock;
+  class XLine;
   class LKVector;
+  template <class T> class Matrix;
+  typedef Matrix<double> DoubleMatrix;
 
   /// Abstract class used to make calculation in a Mixture object
   /// and to store and accumulate results
@@ -156,6 +162,18 @@ namespace alize
     ///      stat server (the log-likelihood array is not computed)
     ///
     lk_t computeAndAccumulateLLK();
+
+    /// Like computeAndAccumulateLLK(const Feature& f...) for all the
+    /// frames of a block in single precision (see
+    /// StatServer::computeLLK(const Mixture&, const FeatureBlock&...)).
+    /// The log-likelihoods are accumulated in double precision and the
+    /// internal feature counter increases by w for each frame.
+    /// @param b the frames
+    /// @param w the weight of each frame
+    /// @return the sum of the log-likelihoods of the block (not
+    ///     multiplied by w)
+    ///
+    lk_t computeAndAccumulateLLK(const FeatureBlock& b, double w = 1.0);
     
     /// Accumulates the log-likelihood.
     /// @param llk the value to accumulate
@@ -218,12 +236,73 @@ namespace alize
     ///
     real_t computeAndAccumulateOcc(const Feature& f, weight_t w = 1.0);
 
+    /// Sets the pruning of the posteriors used by
+    /// computeAndAccumulateOcc() and computeAndAccumulateEM(). The
+    /// posteriors lower than floor are removed, then only the topCount
+    /// largest ones are kept (at least the largest one is kept), and the
+    /// kept posteriors are renormalized. The accumulators of the removed
+    /// distributions are not updated.\n
+    /// The default values are given by the parameters 'posteriorFloor'
+    /// and 'posteriorTopCount' of the configuration (0 if they do not
+    /// exist : no pruning).
+    /// @param floor the minimum posterior (0 : no floor)
+    /// @param topCount the maximum number of posteriors (0 : no maximum)
+    ///
+    void setPosteriorPruning(occ_t floor, unsigned long topCount);
+
+    occ_t getPosteriorFloor() const;
+    unsigned long getPosteriorTopCount() const;
+
+    /// Returns true if the posteriors are pruned
+    /// (see setPosteriorPruning())
+    ///
+    bool isPosteriorPruningActive() const;
+
+    /// Returns the indices of the distributions kept for the last frame,
+    /// in increasing order (the others have a null occupation in
+    /// getOccVect()). Valid only if the posteriors are pruned.
+    /// @return the indices (see getOccIndexCount())
+    ///
+    const ULongVector& getOccIndexVect() const;
+
+    /// Returns the number of distributions kept for the last frame
+    ///
+    unsigned long getOccIndexCount() const;
+
+    /// Returns the sum of the posteriors removed by the pruning, before
+    /// the renormalization, multiplied by the weights of the frames. The
+    /// relative loss of occupation is
+    /// getAccumulatedPrunedOcc() / getAccumulatedOccFeatureCount().
+    /// Reset by resetOcc().
+    ///
+    occ_t getAccumulatedPrunedOcc() const;
+
     /// Gets a reference to the vector of mean occupations.
     /// @return a reference to the vector of mean occupations.
     /// @exception Exception if no occ accumulated
     ///
     DoubleVector& getMeanOccVect();
 
+    /// Activates or deactivates the deterministic accumulation. The
+    /// log-likelihoods, the occupations, the counters and the EM
+    /// statistics of diagonal mixtures are summed by an ExactAccumulator :
+    /// the results do not depend on the order of the frames, on the number
+    /// of threads of ParallelEM or on the way a corpus is split between
+    /// accumulators merged by addAccEM() or mergeAccEM(). Each frame must
+    /// be given by the same method (frame or block) in all the runs
+    /// compared. The accumulators are reset and resetEM() must be called
+    /// again.\n
+    /// The EM statistics of a block of frames are then the exact sums of
+    /// the products of each frame, vectorized but about 3 times slower
+    /// than the matrix products.\n
+    /// The default value is given by the parameter
+    /// 'deterministicAccumulation' of the configuration (false if it does
+    /// not exist).
+    ///
+    void setDeterministicAccumulation(bool b);
+
+    bool isDeterministicAccumulationActive() const;
+
     // -------------------------- EM ----------------------------
 
     /// Reset all internal variables used for EM computation
@@ -238,6 +317,17 @@ namespace alize
     ///
     virtual occ_t computeAndAccumulateEM(const Feature& f, real_t weight = 1.0) = 0;
 
+    /// Acumulate data for EM algorithm from all the frames of a block.
+    /// This implementation calls computeAndAccumulateEM(const Feature&...)
+    /// for each frame.
+    /// @param b the frames
+    /// @param weight the weight of each frame
+    /// @exception Exception if resetEM() have not been called beforehand
+    /// @return sum of the occupations of the frames BEFORE normalization
+    ///
+    virtual occ_t computeAndAccumulateEM(const FeatureBlock& b,
+                                         real_t weight = 1.0);
+
     virtual void addAccEM(const MixtureStat&) = 0;
 
     /// Gets the result of EM accumulation.
@@ -251,6 +341,33 @@ namespace alize
     ///
     real_t getEMFeatureCount() const;
 
+    /// Saves the EM accumulators in a binary file : the occupations, the
+    /// statistics of the derived class and the feature counters. The
+    /// file can be loaded by another process to merge the accumulators
+    /// of several parts of a corpus (see mergeAccEM()).
+    /// @param f the full name of the file
+    /// @exception Exception if resetEM() have not been called beforehand
+    /// @exception IOException if the file cannot be written
+    ///
+    void saveAccEM(const FileName& f) const;
+
+    /// Replaces the EM accumulators by the ones saved by saveAccEM().
+    /// resetEM() is called beforehand.
+    /// @param f the full name of the file
+    /// @exception FileNotFoundException if the file cannot be opened
+    /// @exception InvalidDataException if the file is not an accumulator
+    ///    file or if it does not match the mixture (type, dimensions)
+    ///
+    void loadAccEM(const FileName& f);
+
+    /// Resets the EM accumulators, adds the accumulators saved in several
+    /// files (see saveAccEM()) and computes the new mixture
+    /// @param fileList the full names of the files
+    /// @return the result of getEM()
+    /// @exception same as loadAccEM()
+    ///
+    const Mixture& mergeAccEM(const XLine& fileList);
+
     // -----------------------------------------------------
 
     virtual std::string getClassName() const = 0;
@@ -269,18 +386,60 @@ namespace alize
     double              _featureCounterForAccumulatedLK;
 
     DoubleVector        _occVect;
-    DoubleVector        _accumulatedOccVect;
+    mutable DoubleVector _accumulatedOccVect;
     DoubleVector        _meanOccVect;
     real_t              _featureCounterForAccumulatedOcc;
 
     bool                _resetedEM;
     StatServer*         _pStatServer;
     real_t              _featureCounterForEM;
+    // pruning of the posteriors
+    occ_t               _posteriorFloor;
+    unsigned long       _posteriorTopCount;
+    ULongVector         _occIndexVect;
+    unsigned long       _occIndexCount;
+    occ_t               _accumulatedPrunedOcc;
+    DoubleMatrix*       _pBlockLLKMatrix; // created at the first block
+    DoubleVector        _blockLLKVect;
+    // deterministic accumulation : [llk, count] and
+    // [occ[distribCount], occ count, pruned occ, EM count]
+    bool                _deterministic;
+    ExactAccumulator    _exactLLKAcc;
+    ExactAccumulator    _exactOccAcc;
+    mutable bool        _occSynchronized; // _accumulatedOccVect up to date
+
+    /// Returns the number of values of the statistics of the derived
+    /// class saved by saveAccEM()
+    ///
+    virtual unsigned long getAccEMSize() const = 0;
+
+    /// Copies the statistics of the derived class [getAccEMSize()]
+    ///
+    virtual void writeAccEM(double* p) const = 0;
+
+    /// Sets the statistics of the derived class [getAccEMSize()]
+    ///
+    virtual void readAccEM(const double* p) = 0;
 
     real_t computeOccVect(const Feature&);
+    real_t computeOccBlock(const float* frames, unsigned long frameCount,
+                           occ_t* occ);
+    occ_t pruneOcc(occ_t* occ, unsigned long* idx, unsigned long& count);
+
+    // updates of the accumulators, exact in deterministic mode
+    void addOcc(unsigned long c, occ_t occ);
+    void addOcc(unsigned long c, const occ_t* occ, unsigned long n);
+    void addOccFeatureCount(real_t w);
+    void addPrunedOcc(occ_t occ);
+    void addEMFeatureCount(real_t w);
+    void resetEMFeatureCount();
+    void addAccOcc(const MixtureStat& m);
+    void synchronizeOcc() const;
     void assertResetEMDone() const;
 
   private:
+    void synchronizeCounters();
+
     bool operator==(const MixtureStat&) const;/*!Not implemented*/
     bool operator!=(const MixtureStat&) const;/*!Not implemented*/
     const MixtureStat& operator=(
@@ -59,6 +59,7 @@
 #include <iostream>
 #include <cassert>
 #include <string>
+#include <atomic>
 
 #ifndef NULL
   #define NULL 0
@@ -134,6 +135,8 @@ namespace alize
     FeatureFileReaderFormat_SPRO3,
     FeatureFileReaderFormat_SPRO4,
     FeatureFileReaderFormat_HTK,
+    FeatureFileReaderFormat_COMPRESSED,
+    FeatureFileReaderFormat_ARCHIVE
   };
 
   enum MixtureFileReaderFormat
@@ -147,7 +150,8 @@ namespace alize
   {
     FeatureFileWriterFormat_SPRO3,
     FeatureFileWriterFormat_SPRO4,
-    FeatureFileWriterFormat_RAW
+    FeatureFileWriterFormat_RAW,
+    FeatureFileWriterFormat_COMPRESSED
   };
 
   enum SegServerFileReaderFormat
@@ -171,6 +175,13 @@ namespace alize
     MixtureServerFileWriterFormat_RAW
   };
 
+  enum ScoringMode
+  {
+    ScoringMode_EXACT,  // Distrib::computeLK() for each distribution
+    ScoringMode_LINEAR, // vectorized kernel, linear domain
+    ScoringMode_LOG     // vectorized kernel, log domain
+  };
+
   class ALIZE_API TopDistribsAction
   {
     friend class Object;
@@ -242,6 +253,8 @@ namespace alize
              const std::string& name);
     static MixtureServerFileWriterFormat getMixtureServerFileWriterFormat(
              const std::string& name);
+    static ScoringMode getScoringMode(const std::string& name);
+    static std::string getScoringModeName(ScoringMode);
 
     /// Tests whether i <= size. Throws an exception if not. For debbuging.
     /// @exception IndexOutOfBoundsException
@@ -270,9 +283,11 @@ namespace alize
     static unsigned long getMax();
 
   private:
-    static unsigned long _max;
-    static unsigned long _creationCounter;
-    static unsigned long _destructionCounter;
+    // atomic : objects are created and destroyed by several threads
+    // (see ThreadPool)
+    static std::atomic<unsigned long> _max;
+    static std::atomic<unsigned long> _creationCounter;
+    static std::atomic<unsigned long> _destructionCounter;
 #endif
     
   protected:
@@ -361,6 +376,10 @@ namespace alize
     friend class FeatureFileReaderSingle;
     friend class FeatureInputStreamModifier;
     friend class FeatureServer;
+    friend class ParallelEM;
+    friend class MAPAdaptation;
+    friend class BaumWelchStatExtractor;
+    friend class FeatureBlock;
 
   private :
     K(){}; /*! private constructor */
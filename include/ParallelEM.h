@@ -0,0 +1,168 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_ParallelEM_h)
+#define ALIZE_ParallelEM_h
+
+#include "alize_util.h"
+#include "Object.h"
+#include "ThreadPool.h"
+
+namespace alize
+{
+  class Config;
+  class StatServer;
+  class MixtureStat;
+  class FeatureInputStream;
+  class XLine;
+
+  /// Multi-threaded EM accumulation.\n
+  /// The frames are split between the threads of a pool. Each thread
+  /// accumulates into its own private MixtureStat object, created by the
+  /// stat server for the mixture of the target accumulator. When all the
+  /// frames are read, the private accumulators are added to the target
+  /// accumulator with MixtureStat::addAccEM(), always in the same order.
+  /// The frames given to each thread only depend on the number of
+  /// threads, so two runs with the same thread count give exactly the
+  /// same result. With the deterministic accumulation of the target
+  /// accumulator (see MixtureStat::setDeterministicAccumulation()), the
+  /// result does not depend on the thread count either. The posterior
+  /// pruning and the accumulation mode of the target accumulator are
+  /// given to the private accumulators.\n
+  /// Usage :\n
+  /// > MixtureStat& acc = ss.createAndStoreMixtureStat(world);\n
+  /// > acc.resetEM();\n
+  /// > ParallelEM(config, ss).accumulateEM(acc, featureServer);\n
+  /// > world = acc.getEM();\n
+  /// The scoring mode of the stat server (see
+  /// StatServer::setScoringMode()) is used by all the threads.
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API ParallelEM : public Object
+  {
+
+  public :
+
+    /// Creates an EM driver
+    /// @param c the configuration. The parameter 'threadCount' gives the
+    ///     number of threads if threadCount is 0 (default : all the
+    ///     hardware threads)
+    /// @param ss the stat server used to create the private accumulators
+    /// @param threadCount number of threads
+    ///
+    explicit ParallelEM(const Config& c, StatServer& ss,
+                        unsigned long threadCount = 0);
+    virtual ~ParallelEM();
+
+    /// Accumulates a part of a feature stream. The frames are read by the
+    /// calling thread.
+    /// @param acc the target accumulator. resetEM() must have been
+    ///     called beforehand
+    /// @param fs the feature stream
+    /// @param start the index of the first feature
+    /// @param count the number of features
+    /// @return the number of features accumulated
+    ///
+    unsigned long accumulateEM(MixtureStat& acc, FeatureInputStream& fs,
+                               unsigned long start, unsigned long count);
+
+    /// Accumulates all the features of a stream from its current
+    /// position to its end
+    /// @param acc the target accumulator. resetEM() must have been
+    ///     called beforehand
+    /// @param fs the feature stream
+    /// @return the number of features accumulated
+    ///
+    unsigned long accumulateEM(MixtureStat& acc, FeatureInputStream& fs);
+
+    /// Accumulates all the features of a list of feature files. Each
+    /// thread reads its own files (a contiguous part of the list) with its
+    /// own feature server.
+    /// @param acc the target accumulator. resetEM() must have been
+    ///     called beforehand
+    /// @param fileList the feature files (or lists of feature files)
+    /// @return the number of features accumulated
+    ///
+    unsigned long accumulateEM(MixtureStat& acc, const XLine& fileList);
+
+    /// Returns the number of threads
+    ///
+    unsigned long getThreadCount() const;
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    const Config&  _config;
+    StatServer&    _statServer;
+    ThreadPool     _pool;
+    MixtureStat**  _accArray;  // private accumulators [threadCount]
+
+    void createAccumulators(const MixtureStat& acc);
+    void reduceAccumulators(MixtureStat& acc, bool add);
+    unsigned long accumulateStream(MixtureStat& acc,
+                       FeatureInputStream& fs, unsigned long count);
+
+    ParallelEM(const ParallelEM&); /*!Not implemented*/
+    const ParallelEM& operator=(const ParallelEM&); /*!Not implemented*/
+    bool operator==(const ParallelEM&) const; /*!Not implemented*/
+    bool operator!=(const ParallelEM&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_ParallelEM_h)
@@ -0,0 +1,207 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_ParallelLLK_h)
+#define ALIZE_ParallelLLK_h
+
+#include "alize_util.h"
+#include "Object.h"
+#include "RefVector.h"
+#include "RealVector.h"
+#include "ThreadPool.h"
+
+namespace alize
+{
+  class Config;
+  class StatServer;
+  class Mixture;
+  class FeatureInputStream;
+
+  /// Multi-threaded scoring of a test segment against many target
+  /// mixtures.\n
+  /// The frames are read by the calling thread in chunks. For each chunk,
+  /// the top distributions of the world mixture (if any) are determined
+  /// once per frame and shared by all the targets, then each pair (target,
+  /// block of frames) is a task of a work stealing thread pool (see
+  /// ThreadPool). The log-likelihoods are accumulated in frame order, so
+  /// the accumulated and mean log-likelihoods are exactly the same as the
+  /// ones given by the serial calls :\n
+  /// > ss.computeAndAccumulateLLK(world, f, DETERMINE_TOP_DISTRIBS);\n
+  /// > ss.computeAndAccumulateLLK(target, f, USE_TOP_DISTRIBS);\n
+  /// or, without world mixture :\n
+  /// > ss.computeAndAccumulateLLK(target, f);\n
+  /// Usage :\n
+  /// > ParallelLLK p(config, ss);\n
+  /// > p.addMixture(target1); p.addMixture(target2);\n
+  /// > p.computeAndAccumulateLLK(featureServer, &world);\n
+  /// > lk_t score = p.getMeanLLK(0) - p.getWorldMeanLLK();\n
+  /// The mixtures must not be modified during the computation.
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API ParallelLLK : public Object
+  {
+
+  public :
+
+    /// Creates a scoring engine
+    /// @param c the configuration. The parameter 'threadCount' gives the
+    ///     number of threads if threadCount is 0 (default : all the
+    ///     hardware threads)
+    /// @param ss the stat server used for the computations
+    /// @param threadCount number of threads
+    ///
+    explicit ParallelLLK(const Config& c, StatServer& ss,
+                         unsigned long threadCount = 0);
+    virtual ~ParallelLLK();
+
+    /// Adds a target mixture. The mixture is not copied.
+    /// @param m the mixture
+    /// @return the index of the mixture in the engine
+    ///
+    unsigned long addMixture(const Mixture& m);
+
+    /// Returns the number of target mixtures
+    ///
+    unsigned long getMixtureCount() const;
+
+    /// Removes all the target mixtures and resets the log-likelihoods
+    ///
+    void removeAllMixtures();
+
+    /// Resets the accumulated log-likelihoods of all the mixtures
+    ///
+    void resetLLK();
+
+    /// Computes and accumulates the log-likelihoods of a part of a feature
+    /// stream for all the target mixtures
+    /// @param fs the feature stream
+    /// @param start the index of the first feature
+    /// @param count the number of features
+    /// @param world the world mixture used to determine the top
+    ///     distributions. If NULL, all the distributions are used
+    /// @param w the weight of each feature
+    /// @return the number of features read
+    /// @warning the packed copies of the mixtures (see
+    ///     MixtureGD::getPacked()) are taken once per call : the mixtures
+    ///     must not be modified during the call
+    ///
+    unsigned long computeAndAccumulateLLK(FeatureInputStream& fs,
+                  unsigned long start, unsigned long count,
+                  const Mixture* world = NULL, double w = 1.0);
+
+    /// Same as above, for all the features from the current position of
+    /// the stream to its end
+    ///
+    unsigned long computeAndAccumulateLLK(FeatureInputStream& fs,
+                  const Mixture* world = NULL, double w = 1.0);
+
+    /// Returns the accumulated log-likelihood of a target mixture
+    /// @param i the index of the mixture
+    /// @exception IndexOutOfBoundsException
+    ///
+    lk_t getAccumulatedLLK(unsigned long i) const;
+
+    /// Returns the mean log-likelihood of a target mixture
+    /// @param i the index of the mixture
+    /// @exception IndexOutOfBoundsException
+    /// @exception Exception if no feature has been accumulated
+    ///
+    lk_t getMeanLLK(unsigned long i) const;
+
+    /// Returns the accumulated log-likelihood of the world mixture
+    ///
+    lk_t getWorldAccumulatedLLK() const;
+
+    /// Returns the mean log-likelihood of the world mixture
+    /// @exception Exception if no feature has been accumulated with a
+    ///     world mixture
+    ///
+    lk_t getWorldMeanLLK() const;
+
+    /// Returns the sum of the weights of the accumulated features
+    ///
+    double getAccumulatedLLKFeatureCount() const;
+
+    /// Returns the number of threads
+    ///
+    unsigned long getThreadCount() const;
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    const Config&        _config;
+    StatServer&          _statServer;
+    ThreadPool           _pool;
+    RefVector<Mixture>   _mixtureVect;
+    DoubleVector         _llkAccVect;    // [mixtureCount]
+    lk_t                 _worldLLKAcc;
+    double               _featureCounter;
+    double               _worldFeatureCounter;
+
+    unsigned long accumulateStream(FeatureInputStream& fs,
+                  unsigned long count, const Mixture* world, double w);
+
+    ParallelLLK(const ParallelLLK&); /*!Not implemented*/
+    const ParallelLLK& operator=(const ParallelLLK&); /*!Not implemented*/
+    bool operator==(const ParallelLLK&) const; /*!Not implemented*/
+    bool operator!=(const ParallelLLK&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_ParallelLLK_h)
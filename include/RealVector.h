@@ -173,6 +173,21 @@ namespace alize
     {
       _size = 0;
     }
+
+    /// Exchanges the values of two vectors without copy
+    /// @param v the other vector
+    ///
+    void swap(RealVector<T>& v)
+    {
+      const unsigned long size = _size, capacity = _capacity;
+      T* array = _array;
+      _size = v._size;
+      _capacity = v._capacity;
+      _array = v._array;
+      v._size = size;
+      v._capacity = capacity;
+      v._array = array;
+    }
   
     /// Set a new size. If updateCapacity is set to true, update the
     /// capacity of the vector (useful to save memory)
@@ -74,7 +74,12 @@
 namespace alize
 {
   class Config;
+  class TopDistribsStore;
+  class FeatureBlock;
   class FrameAcc;
+  class MixtureGDPacked;
+  template <class T> class Matrix;
+  typedef Matrix<double> DoubleMatrix;
   class FrameAccGD;
   class FrameAccGF;
   class MixtureGDStat;
@@ -117,6 +122,29 @@ namespace alize
     /// Resets the server. Delete all temporary objects.
     ///
     void reset();
+
+    /// Sets the way log-likelihoods and occupations are computed for the
+    /// mixtures GD :\n
+    /// > ScoringMode_EXACT : each distribution is scored by
+    ///   Distrib::computeLK(). Results are the same, bit for bit, as with
+    ///   the previous versions of the library\n
+    /// > ScoringMode_LINEAR : vectorized kernel in the linear domain
+    ///   (see GDKernel). Same flooring as ScoringMode_EXACT\n
+    /// > ScoringMode_LOG : vectorized kernel in the log domain, combined
+    ///   by log-sum-exp. No exponential per distribution, and frames far
+    ///   from all the distributions keep their true log-likelihood
+    ///   instead of collapsing to minLLK\n
+    /// Top distributions are always computed in the linear domain.
+    /// The default mode is given by the parameter 'scoringMode' of the
+    /// configuration (EXACT, LINEAR or LOG), LINEAR if it does not exist.
+    /// @param m the mode
+    ///
+    void setScoringMode(ScoringMode m);
+
+    /// Returns the scoring mode (see setScoringMode())
+    /// @return the scoring mode
+    ///
+    ScoringMode getScoringMode() const;
     
     /// Computes log-likelihood between a mixture and a feature
     /// @param m the mixture
@@ -124,6 +152,73 @@ namespace alize
     /// @return the log-likelihood
     ///
     lk_t computeLLK(const Mixture& m, const Feature& f) const;
+
+    /// Same as computeLLK(m, f) with a buffer given by the caller. Several
+    /// threads can call this method at the same time with different
+    /// buffers.
+    /// @param m the mixture
+    /// @param f the feature
+    /// @param buffer buffer used for the weighted likelihoods
+    /// @return the log-likelihood
+    ///
+    lk_t computeLLK(const Mixture& m, const Feature& f,
+                    DoubleVector& buffer) const;
+
+    /// Same as computeLLK(m, f, buffer) with the packed copy of the
+    /// mixture given by the caller : MixtureGD::getPacked() and its lock
+    /// are not called for each frame. The copy is not used in mode
+    /// ScoringMode_EXACT. It is not checked against the mixture : m must
+    /// not be modified while p is in use.
+    /// @param m the mixture
+    /// @param p the packed copy of m (see MixtureGD::getPacked())
+    /// @param f the feature
+    /// @param buffer buffer used for the weighted likelihoods
+    /// @return the log-likelihood
+    ///
+    lk_t computeLLK(const Mixture& m, const MixtureGDPacked& p,
+                    const Feature& f, DoubleVector& buffer) const;
+
+    /// Computes the log-likelihood between a mixture and a feature and
+    /// determines the top distributions like
+    /// computeAndAccumulateLLK(m, f, DETERMINE_TOP_DISTRIBS), but stores
+    /// them in a vector given by the caller. Several threads can call this
+    /// method at the same time with different vectors and buffers.
+    /// @param m the mixture
+    /// @param f the feature
+    /// @param topDistribs the result : all the distributions sorted by
+    ///     decreasing weighted likelihood and the sums of the others
+    /// @param buffer buffer used for the weighted likelihoods
+    /// @return the log-likelihood
+    ///
+    lk_t computeTopDistribsLLK(const Mixture& m, const Feature& f,
+                 LKVector& topDistribs, DoubleVector& buffer) const;
+
+    /// Same as computeTopDistribsLLK(m, f, topDistribs, buffer) with the
+    /// packed copy of the mixture given by the caller (see
+    /// computeLLK(m, p, f, buffer))
+    /// @param m the mixture
+    /// @param p the packed copy of m (see MixtureGD::getPacked())
+    /// @param f the feature
+    /// @param topDistribs the result
+    /// @param buffer buffer used for the weighted likelihoods
+    /// @return the log-likelihood
+    ///
+    lk_t computeTopDistribsLLK(const Mixture& m, const MixtureGDPacked& p,
+                 const Feature& f, LKVector& topDistribs,
+                 DoubleVector& buffer) const;
+
+    /// Computes the log-likelihood between a mixture and a feature using
+    /// only the top distributions determined with another mixture, like
+    /// computeAndAccumulateLLK(m, f, USE_TOP_DISTRIBS). Thread-safe.
+    /// @param m the mixture
+    /// @param f the feature
+    /// @param topDistribs the top distributions (see
+    ///     computeTopDistribsLLK()). Only the first topDistribsCount
+    ///     entries are read
+    /// @return the log-likelihood
+    ///
+    lk_t computeLLKWithTopDistribs(const Mixture& m, const Feature& f,
+                                   const LKVector& topDistribs) const;
     
     /// Computes log-likelihood between a mixture and a single parameter
     /// of a feature
@@ -134,6 +229,37 @@ namespace alize
     ///
     lk_t computeLLK(const Mixture& m, const Feature& f, unsigned long idx) const;
 
+    /// Computes the log-likelihoods between a block of frames (for
+    /// example a chunk read from a FeatureServer) and a mixture.\n
+    /// For a mixture GD, all the scores are computed by one matrix
+    /// product (see GDGemm), except in mode ScoringMode_EXACT where each
+    /// distribution is scored by Distrib::computeLK(). The log-likelihood
+    /// of a frame is the log-sum-exp of its row, limited to maxLLK, or
+    /// minLLK if no distribution contributes (see ScoringMode_LOG).
+    /// @param m the mixture
+    /// @param frames the frames, row-major (frameCount x vectSize)
+    /// @param frameCount the number of frames
+    /// @param llkMatrix the weighted log-likelihoods log(w[c]*lk(c,x[n]))
+    ///     (frameCount x distribCount)
+    /// @param llkVect the log-likelihood of each frame (frameCount)
+    ///
+    void computeLLK(const Mixture& m, const real_t* frames,
+                    unsigned long frameCount, DoubleMatrix& llkMatrix,
+                    DoubleVector& llkVect) const;
+
+    /// Same as above with a block of frames in single precision (for
+    /// example read by FeatureInputStream::readFeatures()). The frames
+    /// are not converted to double in memory.
+    /// @param m the mixture
+    /// @param b the frames
+    /// @param llkMatrix the weighted log-likelihoods
+    ///     (frameCount x distribCount)
+    /// @param llkVect the log-likelihood of each frame (frameCount)
+    /// @exception Exception if the dimensions do not match
+    ///
+    void computeLLK(const Mixture& m, const FeatureBlock& b,
+                    DoubleMatrix& llkMatrix, DoubleVector& llkVect) const;
+
     /// Computes the log-likelihood between ALL the distributions of the
     /// server and the feature. The results are store in an array.\n
     /// That is useful when many distributions are shared by mixtures.
@@ -157,6 +283,16 @@ namespace alize
                                   real_t sumNonTopDistribWeights,
                                   real_t sumNonTopDistribLK);
 
+    /// Sets the internal top distrib vector with the top distributions of
+    /// a frame of a store. computeAndAccumulateLLK(m, f, USE_TOP_DISTRIBS)
+    /// can then be called for any mixture with the same number of
+    /// distributions as the world mixture of the store.
+    /// @param s the store
+    /// @param frame the index of the frame in the store
+    ///
+    void setTopDistribIndexVector(const TopDistribsStore& s,
+                                  unsigned long frame);
+
     /// ***** DEPRECATED *****<br>
     /// Returns the count of accumulated features for occupation
     /// @param m the mixture
@@ -452,8 +588,18 @@ namespace alize
     LKVector                _topDistribsVect; // For top distributions management
     const lk_t              _minLLK;
     const lk_t              _maxLLK;
+    mutable DoubleVector    _weightedLKVect; // w[c]*lk(c) for mixtures GD
+    ScoringMode             _scoringMode;
 
     lk_t computeLLK(lk_t lk) const;
+    lk_t computeLLK(const Mixture& m, const MixtureGDPacked* p,
+                    const Feature& f, DoubleVector& buffer) const;
+    lk_t computeTopDistribsLLK(const Mixture& m, const MixtureGDPacked* p,
+                 const Feature& f, LKVector& topDistribs,
+                 DoubleVector& buffer) const;
+    bool usesPacked(const Mixture& m) const;
+    const lk_t* computeWeightedLK(const MixtureGDPacked& p, const Feature& f,
+                                  DoubleVector& buffer) const;
 
     /// @param m
     ///
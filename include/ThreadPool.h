@@ -0,0 +1,168 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_ThreadPool_h)
+#define ALIZE_ThreadPool_h
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include "alize_util.h"
+#include "Object.h"
+
+namespace alize
+{
+  class Config;
+
+  /// Fixed set of worker threads used to run groups of independent
+  /// tasks.\n
+  /// run() executes the tasks 0 to taskCount-1 and returns when all of
+  /// them are done. The calling thread works as well, so a pool of n
+  /// threads creates n-1 threads.\n
+  /// Tasks are scheduled by work stealing : each thread starts with a
+  /// contiguous range of tasks, runs them in increasing order and, when
+  /// its range is empty, steals the upper half of the largest range left.
+  /// Neighbouring tasks therefore tend to run on the same thread, but
+  /// the thread which runs a given task is not defined : a task should
+  /// only write in data owned by its index, or by the index of the thread
+  /// (0 to getThreadCount()-1) given with it.
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API ThreadPool : public Object
+  {
+
+  public :
+
+    /// Creates a pool
+    /// @param threadCount number of threads, including the calling
+    ///     thread. 0 means getHardwareThreadCount()
+    ///
+    explicit ThreadPool(unsigned long threadCount = 0);
+    virtual ~ThreadPool();
+
+    /// Function run for each task, with the index of the task and the
+    /// index of the thread
+    ///
+    typedef std::function<void(unsigned long, unsigned long)> Task;
+
+    /// Runs a group of tasks. Only one group can run at a time.
+    /// @param taskCount the number of tasks
+    /// @param task the function called for each task
+    /// @exception the first exception thrown by a task is thrown again
+    ///     when all the tasks are done
+    ///
+    void run(unsigned long taskCount, const Task& task);
+
+    /// Returns the number of threads, including the calling thread
+    ///
+    unsigned long getThreadCount() const;
+
+    /// Returns the number of threads to create for a given request : the
+    /// parameter 'threadCount' of the configuration if threadCount is 0
+    /// and the parameter exists, threadCount otherwise
+    /// @param c the configuration
+    /// @param threadCount number of threads requested (0 : default)
+    /// @exception Exception if the parameter is negative
+    ///
+    static unsigned long getThreadCount(const Config& c,
+                                        unsigned long threadCount);
+
+    /// Returns the number of threads the hardware can run concurrently
+    /// (at least 1)
+    ///
+    static unsigned long getHardwareThreadCount();
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    struct Range // tasks [begin, end) of a thread
+    {
+      std::mutex    mutex;
+      unsigned long begin;
+      unsigned long end;
+    };
+
+    unsigned long               _threadCount;
+    std::thread*                _threadArray;
+    Range*                      _rangeArray;  // [threadCount]
+    std::mutex                  _mutex;
+    std::condition_variable     _startCondition;
+    std::condition_variable     _doneCondition;
+    const Task*                 _pTask;
+    unsigned long               _activeCount; // workers in the group
+    unsigned long long          _group;       // group counter
+    bool                        _stop;
+    std::atomic<bool>           _cancelled;
+    std::exception_ptr          _error;
+
+    void work(unsigned long thread);
+    void runTasks(unsigned long thread);
+    bool nextTask(unsigned long thread, unsigned long& task);
+
+    ThreadPool(const ThreadPool&); /*!Not implemented*/
+    const ThreadPool& operator=(const ThreadPool&); /*!Not implemented*/
+    bool operator==(const ThreadPool&) const; /*!Not implemented*/
+    bool operator!=(const ThreadPool&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_ThreadPool_h)
@@ -0,0 +1,196 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_TopDistribsStore_h)
+#define ALIZE_TopDistribsStore_h
+
+#include "alize_util.h"
+#include "Object.h"
+#if defined (_WIN32)
+#define uint32_t unsigned __int32
+#else
+#include <stdint.h>
+#endif
+
+namespace alize
+{
+  class Config;
+  class StatServer;
+  class Mixture;
+  class FeatureInputStream;
+  class LKVector;
+  class MappedFile;
+
+  /// Top distributions of a world mixture for all the frames of a
+  /// feature stream.\n
+  /// The top distributions (index and weighted likelihood), the sums
+  /// used for the other distributions and the log-likelihood of the world
+  /// are computed once for each frame. They can then be used to score any
+  /// number of target mixtures without a new pass on the world :\n
+  /// > TopDistribsStore store(config);\n
+  /// > store.computeTopDistribs(ss, world, fs);\n
+  /// > for each frame i of fs :\n
+  /// >   ss.setTopDistribIndexVector(store, i);\n
+  /// >   ss.computeAndAccumulateLLK(target, f, USE_TOP_DISTRIBS);\n
+  /// The store can be saved in a binary file, for example next to the
+  /// feature file, and loaded by other jobs. The file is memory mapped
+  /// when it is loaded (see MappedFile) : the frames are not copied and
+  /// the pages are shared by the processes reading the same file.\n
+  /// File format (native byte order, checked when loading) :\n
+  /// > header (64 bytes) : "ALIZETOP", version, byte order mark, frame
+  ///   count, top distribution count, world distribution count, value of
+  ///   the parameter topDistribsCount\n
+  /// > frameCount x 3 doubles : world llk, sumNonTopDistribWeights,
+  ///   sumNonTopDistribLK\n
+  /// > frameCount x topCount doubles : weighted likelihoods\n
+  /// > frameCount x topCount 32 bits integers : distribution indexes
+  ///
+  /// @version 1.0
+  /// @date 2026
+
+  class ALIZE_API TopDistribsStore : public Object
+  {
+
+  public :
+
+    /// Creates an empty store
+    /// @param c the configuration. The optional parameter
+    ///     'topDistribsFileExtension' (default '.top') gives the extension
+    ///     of the files and the parameter 'featureFilesPath' their path
+    ///
+    explicit TopDistribsStore(const Config& c);
+    virtual ~TopDistribsStore();
+
+    /// Computes the top distributions of all the features of a stream,
+    /// from its beginning, like StatServer::computeAndAccumulateLLK(world,
+    /// f, DETERMINE_TOP_DISTRIBS)
+    /// @param ss the stat server
+    /// @param world the world mixture
+    /// @param fs the feature stream
+    /// @return the number of frames
+    ///
+    unsigned long computeTopDistribs(const StatServer& ss,
+                  const Mixture& world, FeatureInputStream& fs);
+
+    /// Returns the number of frames
+    ///
+    unsigned long getFrameCount() const;
+
+    /// Returns the number of top distributions stored for each frame
+    ///
+    unsigned long getTopDistribsCount() const;
+
+    /// Returns the number of distributions of the world mixture
+    ///
+    unsigned long getDistribCount() const;
+
+    /// Returns the log-likelihood of the world mixture for a frame
+    /// @param frame the index of the frame
+    /// @exception IndexOutOfBoundsException
+    ///
+    lk_t getLLK(unsigned long frame) const;
+
+    /// Copies the top distributions of a frame in a vector. The size of
+    /// the vector is set to getTopDistribsCount().
+    /// @param frame the index of the frame
+    /// @param v the vector
+    /// @exception IndexOutOfBoundsException
+    ///
+    void getTopDistribs(unsigned long frame, LKVector& v) const;
+
+    /// Saves the store
+    /// @param f the name of the file
+    /// @exception IOException if an I/O error occurs
+    ///
+    void save(const FileName& f) const;
+
+    /// Loads a store saved with save()
+    /// @param f the name of the file
+    /// @exception FileNotFoundException if the file cannot be opened
+    /// @exception InvalidDataException if the file is not valid : wrong
+    ///     header or size, or an index which is not the index of a
+    ///     distribution
+    ///
+    void load(const FileName& f);
+
+    virtual std::string getClassName() const;
+    virtual std::string toString() const;
+
+  private :
+
+    const Config&   _config;
+    unsigned long   _frameCount;
+    unsigned long   _topCount;
+    unsigned long   _distribCount;
+    unsigned long   _paramTopCount;
+    char*           _buffer;       // computed store, same layout as a file
+    MappedFile*     _pMappedFile;  // loaded store
+    const double*   _frameArray;   // [frameCount][3]
+    const double*   _lkArray;      // [frameCount][topCount]
+    const uint32_t* _idxArray;     // [frameCount][topCount]
+
+    FileName getFullFileName(const FileName& f) const;
+    void setArrays(const char* data);
+    void clear();
+
+    TopDistribsStore(const TopDistribsStore&); /*!Not implemented*/
+    const TopDistribsStore& operator=(
+                 const TopDistribsStore&); /*!Not implemented*/
+    bool operator==(const TopDistribsStore&) const; /*!Not implemented*/
+    bool operator!=(const TopDistribsStore&) const; /*!Not implemented*/
+  };
+
+} // end namespace alize
+
+#endif // !defined(ALIZE_TopDistribsStore_h)
@@ -83,6 +83,25 @@
 #include "DistribGF.h"
 #include "MixtureGD.h"
 #include "MixtureGF.h"
+#include "MixtureGDPacked.h"
+#include "GDKernel.h"
+#include "GDGemm.h"
+#include "ThreadPool.h"
+#include "ParallelEM.h"
+#include "MAPAdaptation.h"
+#include "BaumWelchStatExtractor.h"
+#include "LinearScorer.h"
+#include "MeanOffsetStore.h"
+#include "FeatureCodec.h"
+#include "FeatureFileReaderCompressed.h"
+#include "FeatureArchive.h"
+#include "FeatureFileReaderArchive.h"
+#include "ParallelLLK.h"
+#include "MappedFile.h"
+#include "TopDistribsStore.h"
+#include "FeatureBlock.h"
+#include "GDAccumulator.h"
+#include "ExactAccumulator.h"
 #include "FeatureFlags.h"
 #include "Feature.h"
 
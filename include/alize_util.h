@@ -65,4 +65,13 @@
     #define ALIZE_API
 #endif
 
+// 64 bits positions in a FILE (long is 32 bits on Windows)
+#if defined(_WIN32)
+    #define ALIZE_FTELL64 _ftelli64
+    #define ALIZE_FSEEK64 _fseeki64
+#else
+    #define ALIZE_FTELL64 ftello
+    #define ALIZE_FSEEK64 fseeko
+#endif
+
 #endif
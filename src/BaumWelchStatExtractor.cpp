@@ -0,0 +1,440 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_BaumWelchStatExtractor_cpp)
+#define ALIZE_BaumWelchStatExtractor_cpp
+
+#if defined(_WIN32)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <new>
+#include <cstdio>
+#include <cstring>
+#include "BaumWelchStatExtractor.h"
+#include "StatServer.h"
+#include "Mixture.h"
+#include "MixtureGD.h"
+#include "MixtureGDStat.h"
+#include "DistribGD.h"
+#include "GDAccumulator.h"
+#include "FeatureBlock.h"
+#include "FeatureInputStream.h"
+#include "FeatureServer.h"
+#include "MappedFile.h"
+#include "Config.h"
+#include "XList.h"
+#include "XLine.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef BaumWelchStatExtractor B;
+
+// frames read at a time for an utterance
+static const unsigned long FRAME_BLOCK = 512;
+// utterances per thread kept in memory by extract(..., file)
+static const unsigned long FILE_CHUNK = 8;
+
+static const char BW_MAGIC[8] = {'A','L','I','Z','E','B','W','S'};
+static const uint32_t BW_VERSION = 1;
+static const uint32_t BW_BYTE_ORDER_MARK = 0x01020304;
+static const unsigned long long BW_CENTERED = 1;
+
+struct BWHeader // 64 bytes
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  unsigned long long distribCount;
+  unsigned long long vectSize;
+  unsigned long long utteranceCount;
+  unsigned long long flags;
+  char     unused[16];
+};
+//-------------------------------------------------------------------------
+static unsigned long getTopCountParam(const Config& c)
+{
+  if (c.existsParam("BWStatTopCount"))
+    return (unsigned long)c.getIntegerParam("BWStatTopCount");
+  if (c.existsParam("posteriorTopCount"))
+    return (unsigned long)c.getIntegerParam("posteriorTopCount");
+  return 0;
+}
+//-------------------------------------------------------------------------
+B::BaumWelchStatExtractor(const Config& c, StatServer& ss,
+                          unsigned long threadCount)
+:Object(), _config(c), _statServer(ss),
+ _pool(ThreadPool::getThreadCount(c, threadCount)), _topCount(getTopCountParam(c)),
+ _centered(c.existsParam("BWStatCentered")
+           && c.getBooleanParam("BWStatCentered")),
+ _pUbm(NULL), _ubmDistribCount(0), _ubmVectSize(0), _accArray(NULL),
+ _configArray(NULL) {}
+//-------------------------------------------------------------------------
+void B::setTopCount(unsigned long n) { _topCount = n; }
+//-------------------------------------------------------------------------
+unsigned long B::getTopCount() const { return _topCount; }
+//-------------------------------------------------------------------------
+void B::setCentered(bool b) { _centered = b; }
+//-------------------------------------------------------------------------
+bool B::isCentered() const { return _centered; }
+//-------------------------------------------------------------------------
+void B::createAccumulators(const MixtureGD& ubm) // private
+{
+  const unsigned long threadCount = _pool.getThreadCount();
+  ubm.getPacked();
+  // an accumulator has the dimensions of the mixture at its creation :
+  // another mixture at the same address or a modified one needs new
+  // accumulators
+  if (_pUbm != &ubm || _ubmDistribCount != ubm.getDistribCount()
+      || _ubmVectSize != ubm.getVectSize())
+  {
+    deleteAccumulators();
+    _accArray = new (std::nothrow) MixtureGDStat*[threadCount];
+    assertMemoryIsAllocated(_accArray, __FILE__, __LINE__);
+    _configArray = new (std::nothrow) Config*[threadCount];
+    assertMemoryIsAllocated(_configArray, __FILE__, __LINE__);
+    for (unsigned long t=0; t<threadCount; t++)
+    {
+      _accArray[t] = NULL;
+      _configArray[t] = NULL;
+    }
+    _pUbm = &ubm;
+    _ubmDistribCount = ubm.getDistribCount();
+    _ubmVectSize = ubm.getVectSize();
+    for (unsigned long t=0; t<threadCount; t++)
+    {
+      _configArray[t] = new (std::nothrow) Config(_config);
+      assertMemoryIsAllocated(_configArray[t], __FILE__, __LINE__);
+      _accArray[t] = &static_cast<MixtureGDStat&>(
+                     static_cast<const Mixture&>(ubm)
+                     .createNewMixtureStatObject(K::k, _statServer, _config));
+    }
+  }
+  for (unsigned long t=0; t<threadCount; t++)
+    _accArray[t]->setPosteriorPruning(_accArray[t]->getPosteriorFloor(),
+                                      _topCount);
+}
+//-------------------------------------------------------------------------
+void B::deleteAccumulators() // private
+{
+  if (_accArray == NULL)
+    return;
+  for (unsigned long t=0; t<_pool.getThreadCount(); t++)
+  {
+    delete _accArray[t];
+    delete _configArray[t];
+  }
+  delete[] _accArray;
+  delete[] _configArray;
+  _accArray = NULL;
+  _configArray = NULL;
+  _pUbm = NULL;
+}
+//-------------------------------------------------------------------------
+// statistics of a stream -> n[distribCount], f[distribCount*vectSize]
+//-------------------------------------------------------------------------
+unsigned long B::accumulate(MixtureGDStat& acc, FeatureInputStream& fs,
+                            double* n, double* f) const // private
+{
+  FeatureBlock b;
+  unsigned long total = 0, k;
+  acc.resetEM();
+  while ((k = fs.readFeatures(b, FRAME_BLOCK)) != 0)
+  {
+    acc.computeAndAccumulateEM(b);
+    total += k;
+  }
+  const MixtureGD& ubm = static_cast<const MixtureGD&>(acc.getMixture());
+  const GDAccumulator& a = acc.getAccumulator();
+  const unsigned long distribCount = a.getDistribCount();
+  const unsigned long vectSize = a.getVectSize();
+  memcpy(n, a.getZeroOrderArray(), distribCount*sizeof(double));
+  for (unsigned long c=0; c<distribCount; c++, f+=vectSize)
+  {
+    const real_t* first = a.getFirstOrder(c);
+    if (_centered)
+    {
+      const real_t* meanVect = ubm.getDistrib(c).getMeanVect().getArray();
+      for (unsigned long i=0; i<vectSize; i++)
+        f[i] = first[i] - n[c]*meanVect[i];
+    }
+    else
+      memcpy(f, first, vectSize*sizeof(double));
+  }
+  return total;
+}
+//-------------------------------------------------------------------------
+unsigned long B::extract(const MixtureGD& ubm, FeatureInputStream& fs,
+                         double* n, double* f)
+{
+  createAccumulators(ubm);
+  return accumulate(*_accArray[0], fs, n, f);
+}
+//-------------------------------------------------------------------------
+unsigned long B::extract(const MixtureGD& ubm, FeatureInputStream& fs,
+                         DoubleVector& n, DoubleMatrix& f)
+{
+  n.setSize(ubm.getDistribCount());
+  f.setDimensions(ubm.getDistribCount(), ubm.getVectSize());
+  return extract(ubm, fs, n.getArray(), f.getArray());
+}
+//-------------------------------------------------------------------------
+// statistics of the utterances first to first+count-1 of a list ->
+// frameCounts[count], n[count][distribCount],
+// f[count][distribCount*vectSize]
+//-------------------------------------------------------------------------
+unsigned long B::extractList(const MixtureGD& ubm, const XList& list,
+                    unsigned long first, unsigned long count,
+                    double* frameCounts, double* n, double* f) // private
+{
+  const unsigned long nSize = ubm.getDistribCount();
+  const unsigned long fSize = nSize*ubm.getVectSize();
+  unsigned long total = 0;
+
+  // the file names are copied by this thread
+  XLine* fileArray = new (std::nothrow) XLine[count];
+  assertMemoryIsAllocated(fileArray, __FILE__, __LINE__);
+  unsigned long* countArray = new (std::nothrow) unsigned long[count];
+  assertMemoryIsAllocated(countArray, __FILE__, __LINE__);
+  try
+  {
+    for (unsigned long u=0; u<count; u++)
+    {
+      const XLine& l = list.getLine(first+u);
+      if (l.getElementCount() == 0)
+        throw Exception("BaumWelchStatExtractor : no utterance id",
+                        __FILE__, __LINE__);
+      for (unsigned long i=1; i<l.getElementCount(); i++)
+        fileArray[u].addElement(l.getElement(i, false));
+      countArray[u] = 0;
+    }
+    _pool.run(count, [&](unsigned long u, unsigned long t)
+    {
+      double* pn = n + u*nSize;
+      double* pf = f + u*fSize;
+      if (fileArray[u].getElementCount() != 0)
+      {
+        FeatureServer fs(*_configArray[t], fileArray[u]);
+        countArray[u] = accumulate(*_accArray[t], fs, pn, pf);
+      }
+      else
+      {
+        memset(pn, 0, nSize*sizeof(double));
+        memset(pf, 0, fSize*sizeof(double));
+      }
+      frameCounts[u] = (double)countArray[u];
+    });
+  }
+  catch (...)
+  {
+    delete[] countArray;
+    delete[] fileArray;
+    throw;
+  }
+  for (unsigned long u=0; u<count; u++)
+    total += countArray[u];
+  delete[] countArray;
+  delete[] fileArray;
+  return total;
+}
+//-------------------------------------------------------------------------
+unsigned long B::extract(const MixtureGD& ubm, const XList& list,
+                         DoubleMatrix& n, DoubleMatrix& f)
+{
+  const unsigned long count = list.getLineCount();
+  n.setDimensions(count, ubm.getDistribCount());
+  f.setDimensions(count, ubm.getDistribCount()*ubm.getVectSize());
+  DoubleVector frameCounts(count, count);
+  createAccumulators(ubm);
+  return extractList(ubm, list, 0, count, frameCounts.getArray(),
+                     n.getArray(), f.getArray());
+}
+//-------------------------------------------------------------------------
+unsigned long B::extract(const MixtureGD& ubm, const XList& list,
+                         const FileName& file)
+{
+  const unsigned long count = list.getLineCount();
+  const unsigned long nSize = ubm.getDistribCount();
+  const unsigned long fSize = nSize*ubm.getVectSize();
+  const unsigned long chunk = FILE_CHUNK*_pool.getThreadCount();
+  DoubleVector frameCounts(chunk, chunk);
+  DoubleVector n(chunk*nSize, chunk*nSize);
+  DoubleVector f(chunk*fSize, chunk*fSize);
+  unsigned long total = 0;
+
+  createAccumulators(ubm);
+  FILE* pFile = ::fopen(file.c_str(), "wb");
+  if (pFile == NULL)
+    throw IOException("Cannot create new file", __FILE__, __LINE__, file);
+  bool ok = true;
+  try
+  {
+    BWHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, BW_MAGIC, sizeof(BW_MAGIC));
+    h.version = BW_VERSION;
+    h.byteOrderMark = BW_BYTE_ORDER_MARK;
+    h.distribCount = nSize;
+    h.vectSize = ubm.getVectSize();
+    h.utteranceCount = count;
+    h.flags = _centered ? BW_CENTERED : 0;
+    ok = ::fwrite(&h, sizeof(h), 1, pFile) == 1;
+    for (unsigned long first=0; ok && first<count; first+=chunk)
+    {
+      const unsigned long k = count-first < chunk ? count-first : chunk;
+      total += extractList(ubm, list, first, k, frameCounts.getArray(),
+                           n.getArray(), f.getArray());
+      for (unsigned long u=0; ok && u<k; u++)
+      {
+        const string id(list.getLine(first+u).getElement(0, false));
+        const unsigned long long length = id.size();
+        const char pad[8] = {0};
+        const size_t padSize = (8-id.size()%8)%8;
+        ok = ::fwrite(&length, sizeof(length), 1, pFile) == 1
+          && ::fwrite(id.data(), 1, id.size(), pFile) == id.size()
+          && ::fwrite(pad, 1, padSize, pFile) == padSize
+          && ::fwrite(&frameCounts[u], sizeof(double), 1, pFile) == 1
+          && ::fwrite(n.getArray()+u*nSize, sizeof(double), nSize, pFile)
+             == nSize
+          && ::fwrite(f.getArray()+u*fSize, sizeof(double), fSize, pFile)
+             == fSize;
+      }
+    }
+  }
+  catch (...)
+  {
+    ::fclose(pFile);
+    throw;
+  }
+  if (::fclose(pFile) != 0 || !ok)
+    throw IOException("Cannot write in file", __FILE__, __LINE__, file);
+  return total;
+}
+//-------------------------------------------------------------------------
+bool B::load(const FileName& file, XLine& ids, DoubleVector& frameCounts,
+             DoubleMatrix& n, DoubleMatrix& f)
+{
+  MappedFile m(file);
+  const char* p = m.getData();
+  const char* end = p + m.getLength();
+  BWHeader h;
+  if (m.getLength() < sizeof(h))
+    throw InvalidDataException("Not a Baum-Welch statistics file",
+                               __FILE__, __LINE__, file);
+  memcpy(&h, p, sizeof(h));
+  p += sizeof(h);
+  if (memcmp(h.magic, BW_MAGIC, sizeof(BW_MAGIC)) != 0)
+    throw InvalidDataException("Not a Baum-Welch statistics file",
+                               __FILE__, __LINE__, file);
+  if (h.version != BW_VERSION || h.byteOrderMark != BW_BYTE_ORDER_MARK)
+    throw InvalidDataException("Wrong version or byte order",
+                               __FILE__, __LINE__, file);
+  // the dimensions are checked against the length of the file before any
+  // allocation : an utterance takes at least (length of its id, frame
+  // count, nSize+fSize statistics) 8*(2+nSize+fSize) bytes
+  const unsigned long long max = ~0ULL/sizeof(double);
+  if ((h.vectSize != 0 && h.distribCount > max/h.vectSize)
+      || h.distribCount*h.vectSize > max-2-h.distribCount
+      || h.utteranceCount > (unsigned long long)(end-p)/sizeof(double)
+                            /(2+h.distribCount+h.distribCount*h.vectSize))
+    throw InvalidDataException("Wrong size", __FILE__, __LINE__, file);
+  const unsigned long count = (unsigned long)h.utteranceCount;
+  const unsigned long nSize = (unsigned long)h.distribCount;
+  const unsigned long fSize = nSize*(unsigned long)h.vectSize;
+  ids.reset();
+  frameCounts.setSize(count);
+  n.setDimensions(count, nSize);
+  f.setDimensions(count, fSize);
+  for (unsigned long u=0; u<count; u++)
+  {
+    unsigned long long length;
+    if ((unsigned long)(end-p) < sizeof(length))
+      throw InvalidDataException("Wrong size", __FILE__, __LINE__, file);
+    memcpy(&length, p, sizeof(length));
+    p += sizeof(length);
+    const unsigned long padded = (unsigned long)((length+7)/8*8);
+    if (length > (unsigned long)(end-p) || (unsigned long)(end-p)
+        < padded + (1+nSize+fSize)*sizeof(double))
+      throw InvalidDataException("Wrong size", __FILE__, __LINE__, file);
+    ids.addElement(string(p, (size_t)length));
+    p += padded;
+    memcpy(&frameCounts[u], p, sizeof(double));
+    p += sizeof(double);
+    memcpy(n.getArray()+u*nSize, p, nSize*sizeof(double));
+    p += nSize*sizeof(double);
+    memcpy(f.getArray()+u*fSize, p, fSize*sizeof(double));
+    p += fSize*sizeof(double);
+  }
+  if (p != end)
+    throw InvalidDataException("Wrong size", __FILE__, __LINE__, file);
+  return (h.flags & BW_CENTERED) != 0;
+}
+//-------------------------------------------------------------------------
+unsigned long B::getThreadCount() const { return _pool.getThreadCount(); }
+//-------------------------------------------------------------------------
+string B::getClassName() const { return "BaumWelchStatExtractor"; }
+//-------------------------------------------------------------------------
+string B::toString() const
+{
+  return Object::toString()
+    + "\n  threadCount = " + std::to_string(_pool.getThreadCount())
+    + "\n  topCount    = " + std::to_string(_topCount)
+    + "\n  centered    = " + (_centered ? "true" : "false");
+}
+//-------------------------------------------------------------------------
+B::~BaumWelchStatExtractor() { deleteAccumulators(); }
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_BaumWelchStatExtractor_cpp)
@@ -55,6 +55,7 @@
 #if !defined(ALIZE_Distrib_cpp)
 #define ALIZE_Distrib_cpp
 
+#include <atomic>
 #include "Distrib.h"
 #include "DistribGD.h"
 #include "DistribGF.h"
@@ -63,10 +64,13 @@
 using namespace alize;
 typedef Distrib D;
 
+static std::atomic<unsigned long long> lastRevision(0);
+
 //-------------------------------------------------------------------------
 D::Distrib(unsigned long vectSize)
 :Object(), _vectSize(vectSize), _det(0.0), _cst(0.0),
- _meanVect(vectSize, vectSize), _refCounter(0), _dictIndex(0) {}
+ _meanVect(vectSize, vectSize), _revision(newRevision(K::k)),
+ _refCounter(0), _dictIndex(0) {}
 //-------------------------------------------------------------------------
 bool D::operator!=(const Distrib& d) const { return !(*this == d); }
 //-------------------------------------------------------------------------
@@ -76,26 +80,52 @@ unsigned long D::getVectSize() const { return _vectSize; }
 //-------------------------------------------------------------------------
 real_t D::getMean(unsigned long i) const { return _meanVect[i]; }
 //-------------------------------------------------------------------------
-DoubleVector& D::getMeanVect() { return _meanVect; }
+DoubleVector& D::getMeanVect()
+{
+  _revision = newRevision(K::k);
+  return _meanVect;
+}
 //-------------------------------------------------------------------------
 const DoubleVector& D::getMeanVect() const { return _meanVect; }
 //-------------------------------------------------------------------------
-void D::setMean(const real_t v, const unsigned long i){ _meanVect[i] = v; }
+void D::setMean(const real_t v, const unsigned long i)
+{
+  _meanVect[i] = v;
+  _revision = newRevision(K::k);
+}
 //-------------------------------------------------------------------------
-void D::setMeanVect(const DoubleVector& v) { _meanVect.setValues(v); }
+void D::setMeanVect(const DoubleVector& v)
+{
+  _meanVect.setValues(v);
+  _revision = newRevision(K::k);
+}
 //-------------------------------------------------------------------------
 real_t D::getDet() const { return _det; }
 //-------------------------------------------------------------------------
 real_t D::getCst() const { return _cst; }
 //-------------------------------------------------------------------------
-void D::setDet(const K&, real_t v) { _det = v; }
+void D::setDet(const K&, real_t v)
+{
+  _det = v;
+  _revision = newRevision(K::k);
+}
 //-------------------------------------------------------------------------
-void D::setCst(const K&, real_t v) { _cst = v; }
+void D::setCst(const K&, real_t v)
+{
+  _cst = v;
+  _revision = newRevision(K::k);
+}
 //-------------------------------------------------------------------------
 unsigned long& D::refCounter(const K&) { return _refCounter; }
 //-------------------------------------------------------------------------
 unsigned long& D::dictIndex(const K&) { return _dictIndex; }
 //-------------------------------------------------------------------------
+unsigned long long D::getRevision() const { return _revision; }
+//-------------------------------------------------------------------------
+unsigned long long D::getLastRevision() { return lastRevision; }
+//-------------------------------------------------------------------------
+unsigned long long D::newRevision(const K&) { return ++lastRevision; }
+//-------------------------------------------------------------------------
 D::~Distrib() {}
 //-------------------------------------------------------------------------
 Distrib& D::create(const K&, const DistribType type,
@@ -138,6 +138,7 @@ const DistribGD& DistribGD::operator=(const DistribGD& d)
   _covVect = d._covVect;
   _det = d._det;
   _cst = d._cst;
+  _revision = newRevision(K::k);
   return *this;
 }
 //-------------------------------------------------------------------------
@@ -220,6 +221,7 @@ void DistribGD::computeAll()
 
   //
   _covVect.setSize(0, true); // set capacity to 0 too
+  _revision = newRevision(K::k);
 }
 //-------------------------------------------------------------------------
 void DistribGD::setCov(real_t v, unsigned long i)
@@ -231,7 +233,10 @@ void DistribGD::setCov(real_t v, unsigned long i)
 }
 //-------------------------------------------------------------------------
 void DistribGD::setCovInv(const K&, real_t v, unsigned long i)
-{ _covInvVect[i] = v; }
+{
+  _covInvVect[i] = v;
+  _revision = newRevision(K::k);
+}
 //-------------------------------------------------------------------------
 real_t DistribGD::getCov(unsigned long i)
 { return getCovVect()[i];}
@@ -241,7 +246,11 @@ real_t DistribGD::getCov(unsigned long i) const
 //-------------------------------------------------------------------------
 real_t DistribGD::getCovInv(unsigned long i) const {return _covInvVect[i];}
 //-------------------------------------------------------------------------
-DoubleVector& DistribGD::getCovInvVect() { return _covInvVect; }
+DoubleVector& DistribGD::getCovInvVect()
+{
+  _revision = newRevision(K::k);
+  return _covInvVect;
+}
 //-------------------------------------------------------------------------
 const DoubleVector& DistribGD::getCovInvVect() const { return _covInvVect; }
 //-------------------------------------------------------------------------
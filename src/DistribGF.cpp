@@ -147,6 +147,7 @@ const DistribGF& DistribGF::operator=(const DistribGF& d)
   _covMatr = d._covMatr;
   _det = d._det;
   _cst = d._cst;
+  _revision = newRevision(K::k);
   return *this;
 }
 //-------------------------------------------------------------------------
@@ -230,6 +231,7 @@ void DistribGF::computeAll()
 
   // remove cov matrix
   _covMatr.setSize(0, true);
+  _revision = newRevision(K::k);
 }
 //-------------------------------------------------------------------------
 void DistribGF::setCov(real_t v, unsigned long col, unsigned long row)
@@ -242,7 +244,10 @@ void DistribGF::setCov(real_t v, unsigned long col, unsigned long row)
 //-------------------------------------------------------------------------
 void DistribGF::setCovInv(const K&, const real_t v, const unsigned long col,
                                                    const  unsigned long row)
-{ _covInvMatr(col, row) = v; }
+{
+  _covInvMatr(col, row) = v;
+  _revision = newRevision(K::k);
+}
 //-------------------------------------------------------------------------
 real_t DistribGF::getCov(unsigned long col, unsigned long row) const
 {
@@ -254,7 +259,11 @@ real_t DistribGF::getCovInv(const unsigned long col,
                             const unsigned long row) const
 { return _covInvMatr(col, row); }
 //-------------------------------------------------------------------------
-DoubleSquareMatrix& DistribGF::getCovInvMatrix() {return _covInvMatr;}
+DoubleSquareMatrix& DistribGF::getCovInvMatrix()
+{
+  _revision = newRevision(K::k);
+  return _covInvMatr;
+}
 //-------------------------------------------------------------------------
 const DoubleSquareMatrix& DistribGF::getCovInvMatrix() const {return _covInvMatr;}
 //-------------------------------------------------------------------------
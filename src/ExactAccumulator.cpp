@@ -0,0 +1,566 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_ExactAccumulator_cpp)
+#define ALIZE_ExactAccumulator_cpp
+
+// The rounding to the grid needs the IEEE additions : no reassociation,
+// even if the library is compiled with -ffast-math
+#if defined(__clang__) || defined(_MSC_VER)
+  #pragma float_control(precise, on)
+#elif defined(__GNUC__)
+  #pragma GCC optimize("no-fast-math")
+#endif
+
+// see GDKernel.cpp. No FMA in the AVX2 version : all the versions compute
+// the products and the sums with the same roundings.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+  #define ALIZE_EXACTACCUMULATOR_X86
+  #define ALIZE_EXACTACCUMULATOR_AVX
+  #define TARGET_SSE2   __attribute__((target("sse2")))
+  #define TARGET_AVX2   __attribute__((target("avx2")))
+  #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+  #define ALIZE_EXACTACCUMULATOR_X86
+  #define TARGET_SSE2
+  #include <emmintrin.h>
+#endif
+
+#include <new>
+#include <cmath>
+#include <cstring>
+#include "ExactAccumulator.h"
+#include "GDKernel.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef ExactAccumulator A;
+
+const unsigned long A::LIMB_COUNT;
+static const int LOW_EXPONENT = -96; // weight of the lowest digit
+static const unsigned long long LIMB_MASK = 0xFFFFFFFFULL;
+static const long long LIMB_BASE = 0x100000000LL;
+// a digit gets less than 2^32 by addition : no overflow before 2^31
+static const unsigned long MAX_PENDING = 1UL << 30;
+// (v + GRID_ROUND) - GRID_ROUND rounds v to a multiple of 2^-40 if
+// |v| <= GRID_MAX (v + GRID_ROUND in [2^12, 2^13])
+static const double GRID_MAX = 2048.0;
+static const double GRID_ROUND = 6144.0;
+// sums of multiples of 2^-40 lower than 2^13 are exact
+static const double PARTIAL_MAX = 4096.0;
+// rows of addMoments() summed in registers before being added to the
+// partial sums
+static const unsigned long ROW_BLOCK = 32;
+
+//-------------------------------------------------------------------------
+// adds a double to the digits l[LIMB_COUNT], the bits lower than 2^-96
+// being truncated
+//-------------------------------------------------------------------------
+static void addToLimbs(long long* l, double v)
+{
+  // v = m * 2^(p+LOW_EXPONENT), m integer of 53 bits (IEEE 754 fields)
+  unsigned long long bits;
+  memcpy(&bits, &v, sizeof(bits));
+  const int biased = (int)((bits >> 52) & 0x7FF);
+  unsigned long long m = bits & 0xFFFFFFFFFFFFFULL;
+  if (biased == 0x7FF)
+    throw Exception("Cannot accumulate a value which is not finite",
+                    __FILE__, __LINE__);
+  if (biased != 0)
+    m |= 1ULL << 52;
+  else if (m == 0) // 0.0
+    return;
+  int p = (biased != 0 ? biased : 1) - 1075 - LOW_EXPONENT;
+  if (p < 0)
+  {
+    if (p <= -53)
+      return;
+    m >>= -p;
+    p = 0;
+  }
+  const unsigned long k = p/32;
+  const int s = p%32;
+  if (k+3 > ExactAccumulator::LIMB_COUNT)
+    throw Exception("Value too large for an exact accumulation",
+                    __FILE__, __LINE__);
+  const long long d0 = (long long)((m & (LIMB_MASK >> s)) << s);
+  const unsigned long long r = m >> (32-s);
+  const long long d1 = (long long)(r & LIMB_MASK);
+  const long long d2 = (long long)(r >> 32);
+  l += k;
+  if ((bits >> 63) == 0)
+  {
+    l[0] += d0;
+    l[1] += d1;
+    l[2] += d2;
+  }
+  else
+  {
+    l[0] -= d0;
+    l[1] -= d1;
+    l[2] -= d2;
+  }
+}
+//-------------------------------------------------------------------------
+// propagates the carries : digits 0..LIMB_COUNT-2 in [0, 2^32), the last
+// one has the sign of the value
+//-------------------------------------------------------------------------
+static void normalizeLimbs(long long* l)
+{
+  for (unsigned long j=0; j+1<A::LIMB_COUNT; j++)
+  {
+    const long long low = (long long)((unsigned long long)l[j] & LIMB_MASK);
+    l[j+1] += (l[j] - low)/LIMB_BASE;
+    l[j] = low;
+  }
+}
+//-------------------------------------------------------------------------
+// Sums of rounded values computed in registers by addMoments(). If the
+// sum of the absolute values is at most GRID_MAX, each value is rounded
+// to the grid and the sum of the rounded values is exact (below
+// PARTIAL_MAX). Otherwise, or if a value is not finite, the functions
+// return false and the values are added one by one.
+//-------------------------------------------------------------------------
+static bool sumMomentColumn(const double* w, const float* x,
+                            unsigned long n, unsigned long rowCount,
+                            double* first, double* second)
+{
+  double s1 = 0.0, s2 = 0.0, absSum = 0.0;
+  for (unsigned long r=0; r<rowCount; r++, x+=n)
+  {
+    const double xr = *x;
+    const double t = w[r] * xr;
+    const double u = t * xr;
+    s1 += (t + GRID_ROUND) - GRID_ROUND;
+    s2 += (u + GRID_ROUND) - GRID_ROUND;
+    absSum += fabs(t) + fabs(u);
+  }
+  *first = s1;
+  *second = s2;
+  return absSum <= GRID_MAX;
+}
+//-------------------------------------------------------------------------
+static bool sumValues(const double* v, unsigned long n, double* s)
+{
+  double sum = 0.0, absSum = 0.0;
+  for (unsigned long r=0; r<n; r++)
+  {
+    sum += (v[r] + GRID_ROUND) - GRID_ROUND;
+    absSum += fabs(v[r]);
+  }
+  *s = sum;
+  return absSum <= GRID_MAX;
+}
+#if defined(ALIZE_EXACTACCUMULATOR_X86)
+//-------------------------------------------------------------------------
+// 4 columns
+//-------------------------------------------------------------------------
+TARGET_SSE2 static bool sumMomentsSSE2(const double* w, const float* x,
+                                       unsigned long n,
+                                       unsigned long rowCount,
+                                       double* first, double* second)
+{
+  const __m128d round = _mm_set1_pd(GRID_ROUND);
+  const __m128d absMask = _mm_castsi128_pd(
+                          _mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+  __m128d f0 = _mm_setzero_pd(), f1 = _mm_setzero_pd();
+  __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+  __m128d b0 = _mm_setzero_pd(), b1 = _mm_setzero_pd();
+  for (unsigned long r=0; r<rowCount; r++, x+=n)
+  {
+    const __m128d a = _mm_set1_pd(w[r]);
+    const __m128 xf = _mm_loadu_ps(x);
+    const __m128d x0 = _mm_cvtps_pd(xf);
+    const __m128d x1 = _mm_cvtps_pd(_mm_movehl_ps(xf, xf));
+    const __m128d t0 = _mm_mul_pd(a, x0);
+    const __m128d t1 = _mm_mul_pd(a, x1);
+    const __m128d u0 = _mm_mul_pd(t0, x0);
+    const __m128d u1 = _mm_mul_pd(t1, x1);
+    f0 = _mm_add_pd(f0, _mm_sub_pd(_mm_add_pd(t0, round), round));
+    f1 = _mm_add_pd(f1, _mm_sub_pd(_mm_add_pd(t1, round), round));
+    s0 = _mm_add_pd(s0, _mm_sub_pd(_mm_add_pd(u0, round), round));
+    s1 = _mm_add_pd(s1, _mm_sub_pd(_mm_add_pd(u1, round), round));
+    b0 = _mm_add_pd(b0, _mm_add_pd(_mm_and_pd(t0, absMask),
+                                   _mm_and_pd(u0, absMask)));
+    b1 = _mm_add_pd(b1, _mm_add_pd(_mm_and_pd(t1, absMask),
+                                   _mm_and_pd(u1, absMask)));
+  }
+  _mm_storeu_pd(first, f0);
+  _mm_storeu_pd(first+2, f1);
+  _mm_storeu_pd(second, s0);
+  _mm_storeu_pd(second+2, s1);
+  const __m128d gridMax = _mm_set1_pd(GRID_MAX);
+  return _mm_movemask_pd(_mm_or_pd(_mm_cmpnle_pd(b0, gridMax),
+                                   _mm_cmpnle_pd(b1, gridMax))) == 0;
+}
+#endif
+#if defined(ALIZE_EXACTACCUMULATOR_AVX)
+//-------------------------------------------------------------------------
+// 8 columns
+//-------------------------------------------------------------------------
+TARGET_AVX2 static bool sumMomentsAVX2(const double* w, const float* x,
+                                       unsigned long n,
+                                       unsigned long rowCount,
+                                       double* first, double* second)
+{
+  const __m256d round = _mm256_set1_pd(GRID_ROUND);
+  const __m256d absMask = _mm256_castsi256_pd(
+                          _mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+  __m256d f0 = _mm256_setzero_pd(), f1 = _mm256_setzero_pd();
+  __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+  __m256d b0 = _mm256_setzero_pd(), b1 = _mm256_setzero_pd();
+  for (unsigned long r=0; r<rowCount; r++, x+=n)
+  {
+    const __m256d a = _mm256_set1_pd(w[r]);
+    const __m256d x0 = _mm256_cvtps_pd(_mm_loadu_ps(x));
+    const __m256d x1 = _mm256_cvtps_pd(_mm_loadu_ps(x+4));
+    const __m256d t0 = _mm256_mul_pd(a, x0);
+    const __m256d t1 = _mm256_mul_pd(a, x1);
+    const __m256d u0 = _mm256_mul_pd(t0, x0);
+    const __m256d u1 = _mm256_mul_pd(t1, x1);
+    f0 = _mm256_add_pd(f0, _mm256_sub_pd(_mm256_add_pd(t0, round), round));
+    f1 = _mm256_add_pd(f1, _mm256_sub_pd(_mm256_add_pd(t1, round), round));
+    s0 = _mm256_add_pd(s0, _mm256_sub_pd(_mm256_add_pd(u0, round), round));
+    s1 = _mm256_add_pd(s1, _mm256_sub_pd(_mm256_add_pd(u1, round), round));
+    b0 = _mm256_add_pd(b0, _mm256_add_pd(_mm256_and_pd(t0, absMask),
+                                         _mm256_and_pd(u0, absMask)));
+    b1 = _mm256_add_pd(b1, _mm256_add_pd(_mm256_and_pd(t1, absMask),
+                                         _mm256_and_pd(u1, absMask)));
+  }
+  _mm256_storeu_pd(first, f0);
+  _mm256_storeu_pd(first+4, f1);
+  _mm256_storeu_pd(second, s0);
+  _mm256_storeu_pd(second+4, s1);
+  const __m256d gridMax = _mm256_set1_pd(GRID_MAX);
+  return _mm256_movemask_pd(_mm256_or_pd(
+           _mm256_cmp_pd(b0, gridMax, _CMP_NLE_UQ),
+           _mm256_cmp_pd(b1, gridMax, _CMP_NLE_UQ))) == 0;
+}
+#endif
+//-------------------------------------------------------------------------
+A::ExactAccumulator(unsigned long size)
+:Object(), _size(0), _capacity(0), _limbArray(NULL), _partialArray(NULL),
+ _pendingCount(0)
+{
+  setSize(size);
+}
+//-------------------------------------------------------------------------
+void A::setSize(unsigned long size)
+{
+  if (size > _capacity || _limbArray == NULL)
+  {
+    if (_limbArray != NULL)
+    {
+      delete[] _limbArray;
+      delete[] _partialArray;
+    }
+    _capacity = size;
+    _limbArray = new (std::nothrow) long long[(size!=0?size:1)*LIMB_COUNT];
+    assertMemoryIsAllocated(_limbArray, __FILE__, __LINE__);
+    _partialArray = new (std::nothrow) double[size!=0?size:1];
+    assertMemoryIsAllocated(_partialArray, __FILE__, __LINE__);
+  }
+  _size = size;
+  reset();
+}
+//-------------------------------------------------------------------------
+unsigned long A::getSize() const { return _size; }
+//-------------------------------------------------------------------------
+void A::reset()
+{
+  memset(_limbArray, 0, _size*LIMB_COUNT*sizeof(long long));
+  memset(_partialArray, 0, _size*sizeof(double));
+  _pendingCount = 0;
+}
+//-------------------------------------------------------------------------
+void A::reset(unsigned long i)
+{
+  assertIsInBounds(__FILE__, __LINE__, i, _size);
+  memset(_limbArray + i*LIMB_COUNT, 0, LIMB_COUNT*sizeof(long long));
+  _partialArray[i] = 0.0;
+}
+//-------------------------------------------------------------------------
+void A::addValue(unsigned long i, double v) // private
+{
+  double& partial = _partialArray[i];
+  if (fabs(v) <= GRID_MAX) // false if v is NaN
+  {
+    const double q = (v + GRID_ROUND) - GRID_ROUND;
+    const double sum = partial + q;
+    if (fabs(sum) < PARTIAL_MAX)
+    {
+      partial = sum;
+      return;
+    }
+    addToLimbs(_limbArray + i*LIMB_COUNT, partial);
+    partial = q;
+  }
+  else
+    addToLimbs(_limbArray + i*LIMB_COUNT, v);
+  if (++_pendingCount == MAX_PENDING)
+    normalize();
+}
+//-------------------------------------------------------------------------
+// adds an exact sum of rounded values, |s| < PARTIAL_MAX
+//-------------------------------------------------------------------------
+void A::addRoundedSum(unsigned long i, double s) // private
+{
+  double& partial = _partialArray[i];
+  const double sum = partial + s; // exact : |sum| < 2*PARTIAL_MAX
+  if (fabs(sum) < PARTIAL_MAX)
+  {
+    partial = sum;
+    return;
+  }
+  addToLimbs(_limbArray + i*LIMB_COUNT, partial);
+  partial = s;
+  if (++_pendingCount == MAX_PENDING)
+    normalize();
+}
+//-------------------------------------------------------------------------
+void A::add(unsigned long i, double v)
+{
+  assertIsInBounds(__FILE__, __LINE__, i, _size);
+  addValue(i, v);
+}
+//-------------------------------------------------------------------------
+void A::add(unsigned long i, const double* v, unsigned long n)
+{
+  if (n == 0)
+    return;
+  assertIsInBounds(__FILE__, __LINE__, i+n-1, _size);
+  for (unsigned long j=0; j<n; j++)
+    addValue(i+j, v[j]);
+}
+//-------------------------------------------------------------------------
+void A::addValues(unsigned long i, const double* v, unsigned long n) // private
+{
+  double s;
+  for (unsigned long r0=0; r0<n; r0+=ROW_BLOCK, v+=ROW_BLOCK)
+  {
+    const unsigned long nb = n-r0 < ROW_BLOCK ? n-r0 : ROW_BLOCK;
+    if (sumValues(v, nb, &s))
+      addRoundedSum(i, s);
+    else
+      for (unsigned long r=0; r<nb; r++)
+        addValue(i, v[r]);
+  }
+}
+//-------------------------------------------------------------------------
+void A::addAll(unsigned long i, const double* v, unsigned long n)
+{
+  assertIsInBounds(__FILE__, __LINE__, i, _size);
+  addValues(i, v, n);
+}
+//-------------------------------------------------------------------------
+void A::addMoments(unsigned long i, const double* w, const float* x,
+                   unsigned long n, unsigned long rowCount)
+{
+  if (rowCount == 0)
+    return;
+  assertIsInBounds(__FILE__, __LINE__, i+2*n, _size);
+  const SimdLevel level = GDKernel::getSimdLevel();
+  unsigned long tile = 1; // columns summed together
+#if defined(ALIZE_EXACTACCUMULATOR_AVX)
+  if (level == SimdLevel_AVX2 || level == SimdLevel_AVX512)
+    tile = 8;
+#endif
+#if defined(ALIZE_EXACTACCUMULATOR_X86)
+  if (level == SimdLevel_SSE2)
+    tile = 4;
+#endif
+  double first[8], second[8];
+  unsigned long r, j, k, t;
+  for (unsigned long r0=0; r0<rowCount; r0+=ROW_BLOCK, w+=ROW_BLOCK,
+       x+=ROW_BLOCK*n)
+  {
+    const unsigned long nb = rowCount-r0 < ROW_BLOCK ? rowCount-r0
+                                                      : ROW_BLOCK;
+    addValues(i, w, nb);
+    for (j=0; j<n; j+=t)
+    {
+      t = tile;
+      while (j+t > n) // last columns
+        t /= 2;
+      bool exact;
+#if defined(ALIZE_EXACTACCUMULATOR_AVX)
+      if (t == 8)
+        exact = sumMomentsAVX2(w, x+j, n, nb, first, second);
+      else
+#endif
+#if defined(ALIZE_EXACTACCUMULATOR_X86)
+      if (t == 4)
+        exact = sumMomentsSSE2(w, x+j, n, nb, first, second);
+      else
+#endif
+      {
+        t = 1;
+        exact = sumMomentColumn(w, x+j, n, nb, first, second);
+      }
+      if (exact)
+        for (k=0; k<t; k++)
+        {
+          addRoundedSum(i+1+j+k, first[k]);
+          addRoundedSum(i+1+n+j+k, second[k]);
+        }
+      else // same products, added one by one
+        for (r=0; r<nb; r++)
+          for (k=0; k<t; k++)
+          {
+            const double xr = x[r*n+j+k];
+            const double p = w[r] * xr;
+            addValue(i+1+j+k, p);
+            addValue(i+1+n+j+k, p * xr);
+          }
+    }
+  }
+}
+//-------------------------------------------------------------------------
+void A::addMoments(unsigned long i, const double* w, const double* x,
+                   unsigned long n, unsigned long rowCount)
+{
+  if (rowCount == 0)
+    return;
+  assertIsInBounds(__FILE__, __LINE__, i+2*n, _size);
+  for (unsigned long r=0; r<rowCount; r++, x+=n)
+  {
+    addValue(i, w[r]);
+    for (unsigned long j=0; j<n; j++)
+    {
+      const double p = w[r] * x[j];
+      addValue(i+1+j, p);
+      addValue(i+1+n+j, p * x[j]);
+    }
+  }
+}
+//-------------------------------------------------------------------------
+void A::add(const ExactAccumulator& a)
+{
+  if (a._size != _size)
+    throw Exception("ExactAccumulator incompatibility", __FILE__, __LINE__);
+  normalize();
+  const unsigned long n = _size*LIMB_COUNT;
+  for (unsigned long i=0; i<n; i++)
+    _limbArray[i] += a._limbArray[i];
+  for (unsigned long i=0; i<_size; i++)
+    addToLimbs(_limbArray + i*LIMB_COUNT, a._partialArray[i]);
+  // normalized digits and partial sums count as two additions
+  _pendingCount = a._pendingCount + 3;
+  if (_pendingCount >= MAX_PENDING)
+    normalize();
+}
+//-------------------------------------------------------------------------
+void A::normalize() // private
+{
+  for (unsigned long i=0; i<_size; i++)
+    normalizeLimbs(_limbArray + i*LIMB_COUNT);
+  _pendingCount = 0;
+}
+//-------------------------------------------------------------------------
+double A::getValue(unsigned long i) const
+{
+  assertIsInBounds(__FILE__, __LINE__, i, _size);
+  long long l[LIMB_COUNT];
+  memcpy(l, _limbArray + i*LIMB_COUNT, sizeof(l));
+  addToLimbs(l, _partialArray[i]);
+  normalizeLimbs(l);
+  double v = (double)l[LIMB_COUNT-1];
+  for (unsigned long j=LIMB_COUNT-1; j>0; j--)
+    v = v*(double)LIMB_BASE + (double)l[j-1];
+  return ldexp(v, LOW_EXPONENT);
+}
+//-------------------------------------------------------------------------
+void A::write(double* p) const
+{
+  long long l[LIMB_COUNT];
+  for (unsigned long i=0; i<_size; i++)
+  {
+    memcpy(l, _limbArray + i*LIMB_COUNT, sizeof(l));
+    addToLimbs(l, _partialArray[i]);
+    normalizeLimbs(l);
+    for (unsigned long j=0; j<LIMB_COUNT; j++)
+      *p++ = (double)l[j];
+  }
+}
+//-------------------------------------------------------------------------
+void A::read(const double* p)
+{
+  const unsigned long n = _size*LIMB_COUNT;
+  for (unsigned long i=0; i<n; i++)
+    _limbArray[i] = (long long)p[i];
+  memset(_partialArray, 0, _size*sizeof(double));
+  _pendingCount = 1;
+}
+//-------------------------------------------------------------------------
+string A::getClassName() const { return "ExactAccumulator"; }
+//-------------------------------------------------------------------------
+string A::toString() const
+{
+  return Object::toString()
+    + "\n  size = " + std::to_string(_size);
+}
+//-------------------------------------------------------------------------
+A::~ExactAccumulator()
+{
+  if (_limbArray != NULL)
+  {
+    delete[] _limbArray;
+    delete[] _partialArray;
+  }
+}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_ExactAccumulator_cpp)
@@ -193,6 +193,12 @@ void Feature::setData(const DoubleVector& v, unsigned long start)
     _dataVector[i] = (data_t)source[i+start];
 }
 //-------------------------------------------------------------------------
+void Feature::setData(const float* v)
+{
+  for (unsigned long i=0; i<_vectSize; i++)
+    _dataVector[i] = (data_t)v[i];
+}
+//-------------------------------------------------------------------------
 void Feature::copySelectedData(const Feature& f, const ULongVector& selection)
 {
   const unsigned long selectionSize = selection.size();
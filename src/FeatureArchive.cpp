@@ -0,0 +1,375 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_FeatureArchive_cpp)
+#define ALIZE_FeatureArchive_cpp
+
+#include <new>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include "FeatureArchive.h"
+#include "FeatureFileReader.h"
+#include "FeatureFileWriter.h"
+#include "FeatureBlock.h"
+#include "FeatureFlags.h"
+#include "Feature.h"
+#include "MappedFile.h"
+#include "XLine.h"
+#include "Config.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef FeatureArchive A;
+
+static const char FAR_MAGIC[8] = {'A','L','I','Z','E','F','A','R'};
+static const uint32_t FAR_VERSION = 1;
+static const uint32_t FAR_BYTE_ORDER_MARK = 0x01020304;
+static const unsigned long FAR_PACK_BLOCK = 4096; // frames read at once
+
+struct FARHeader // 64 bytes
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  unsigned long long entryCount;
+  unsigned long long indexOffset;
+  char     unused[32];
+};
+
+struct FAREntry // 40 bytes, followed by the name padded to 8 bytes
+{
+  unsigned long long offset;
+  unsigned long long featureCount;
+  uint32_t vectSize;
+  float    sampleRate;
+  char     flags[8]; // see FeatureFlags::getString()
+  uint32_t nameLength;
+  uint32_t unused;
+};
+
+//-------------------------------------------------------------------------
+// Archives shared by the readers (see open())
+//-------------------------------------------------------------------------
+static std::mutex& getOpenMutex()
+{
+  static std::mutex m;
+  return m;
+}
+typedef std::map<std::string, std::shared_ptr<FeatureArchive> > ArchiveMap;
+static ArchiveMap& getOpenArchives()
+{
+  static ArchiveMap m;
+  return m;
+}
+//-------------------------------------------------------------------------
+A::FeatureArchive(const FileName& f)
+:Object(), _fileName(f), _pMappedFile(NULL)
+{
+  _pMappedFile = new (std::nothrow) MappedFile(f);
+  assertMemoryIsAllocated(_pMappedFile, __FILE__, __LINE__);
+  try { readIndex(); }
+  catch (...)
+  {
+    delete _pMappedFile;
+    throw;
+  }
+}
+//-------------------------------------------------------------------------
+std::shared_ptr<FeatureArchive> A::open(const FileName& f)
+{
+  std::lock_guard<std::mutex> lock(getOpenMutex());
+  ArchiveMap& m = getOpenArchives();
+  ArchiveMap::const_iterator it = m.find(f);
+  if (it != m.end())
+    return it->second;
+  FeatureArchive* p = new (std::nothrow) FeatureArchive(f);
+  assertMemoryIsAllocated(p, __FILE__, __LINE__);
+  return m[f] = std::shared_ptr<FeatureArchive>(p);
+}
+//-------------------------------------------------------------------------
+void A::closeAll()
+{
+  std::lock_guard<std::mutex> lock(getOpenMutex());
+  ArchiveMap& m = getOpenArchives();
+  // an archive only held by the map cannot get a new reader : open()
+  // needs the lock
+  for (ArchiveMap::iterator it=m.begin(); it!=m.end();)
+    if (it->second.use_count() == 1)
+      m.erase(it++);
+    else
+      it++;
+}
+//-------------------------------------------------------------------------
+void A::readIndex() // private
+{
+  const char* data = _pMappedFile->getData();
+  const unsigned long length = _pMappedFile->getLength();
+  FARHeader h;
+  if (length < sizeof(h))
+    throw InvalidDataException("Not a feature archive", __FILE__,
+                               __LINE__, _fileName);
+  memcpy(&h, data, sizeof(h));
+  if (memcmp(h.magic, FAR_MAGIC, sizeof(FAR_MAGIC)) != 0)
+    throw InvalidDataException("Not a feature archive", __FILE__,
+                               __LINE__, _fileName);
+  if (h.version != FAR_VERSION || h.byteOrderMark != FAR_BYTE_ORDER_MARK)
+    throw InvalidDataException("Wrong version or byte order",
+                               __FILE__, __LINE__, _fileName);
+  if (h.indexOffset < sizeof(h) || h.indexOffset > length)
+    throw InvalidDataException("Wrong index", __FILE__, __LINE__,
+                               _fileName);
+  const unsigned long count = (unsigned long)h.entryCount;
+  unsigned long pos = (unsigned long)h.indexOffset;
+  _entryOffsets.clear();
+  _indexMap.clear();
+  for (unsigned long i=0; i<count; i++)
+  {
+    FAREntry e;
+    if (length-pos < sizeof(e))
+      throw InvalidDataException("Wrong index", __FILE__, __LINE__,
+                                 _fileName);
+    memcpy(&e, data+pos, sizeof(e));
+    const unsigned long padded = (e.nameLength+7)/8*8;
+    if (length-pos-sizeof(e) < padded || e.vectSize == 0
+        || e.offset < sizeof(h) || e.offset > h.indexOffset
+        || e.featureCount > (h.indexOffset-e.offset)/sizeof(float)
+                            /e.vectSize
+        || e.flags[sizeof(e.flags)-1] != 0)
+      throw InvalidDataException("Wrong index", __FILE__, __LINE__,
+                                 _fileName);
+    _entryOffsets.addValue(pos);
+    _indexMap[string(data+pos+sizeof(e), e.nameLength)] = i;
+    pos += sizeof(e) + padded;
+  }
+  if (pos != length)
+    throw InvalidDataException("Wrong size", __FILE__, __LINE__,
+                               _fileName);
+}
+//-------------------------------------------------------------------------
+unsigned long A::pack(const FileName& f, const XLine& l, const Config& c)
+{
+  const unsigned long count = l.getElementCount();
+  std::map<std::string, unsigned long> names;
+  string index; // entries of the index
+  unsigned long total = 0;
+  // never written in place : the archive may be mapped by readers
+  const FileName tmp = f + ".tmp";
+  FILE* pFile = ::fopen(tmp.c_str(), "wb");
+  if (pFile == NULL)
+    throw IOException("Cannot create new file", __FILE__, __LINE__, tmp);
+  bool ok = true;
+  try
+  {
+    FARHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, FAR_MAGIC, sizeof(FAR_MAGIC));
+    h.version = FAR_VERSION;
+    h.byteOrderMark = FAR_BYTE_ORDER_MARK;
+    h.entryCount = count;
+    ok = ::fwrite(&h, sizeof(h), 1, pFile) == 1; // rewritten at the end
+    unsigned long long offset = sizeof(h);
+    FeatureBlock b;
+    for (unsigned long i=0; ok && i<count; i++)
+    {
+      const string& name = l.getElement(i, false);
+      if (names.find(name) != names.end())
+        throw Exception("Duplicated name '" + name + "'", __FILE__,
+                        __LINE__);
+      names[name] = i;
+      FeatureFileReader r(name, c);
+      FAREntry e;
+      memset(&e, 0, sizeof(e));
+      e.offset = offset;
+      e.vectSize = (uint32_t)r.getVectSize();
+      e.sampleRate = (float)r.getSampleRate();
+      strncpy(e.flags, r.getFeatureFlags().getString().c_str(),
+              sizeof(e.flags)-1);
+      e.nameLength = (uint32_t)name.size();
+      unsigned long n;
+      while (ok && (n = r.readFeatures(b, FAR_PACK_BLOCK)) > 0)
+      {
+        const unsigned long size = n*e.vectSize;
+        ok = ::fwrite(b.getArray(), sizeof(float), size, pFile) == size;
+        e.featureCount += n;
+      }
+      offset += e.featureCount*e.vectSize*sizeof(float);
+      total += (unsigned long)e.featureCount;
+      const char pad[8] = {0};
+      index.append((const char*)&e, sizeof(e));
+      index.append(name);
+      index.append(pad, (8-name.size()%8)%8);
+    }
+    h.indexOffset = offset;
+    ok = ok && ::fwrite(index.data(), 1, index.size(), pFile)
+               == index.size()
+            && ::fseek(pFile, 0, SEEK_SET) == 0
+            && ::fwrite(&h, sizeof(h), 1, pFile) == 1;
+  }
+  catch (...)
+  {
+    ::fclose(pFile);
+    ::remove(tmp.c_str());
+    throw;
+  }
+  if (::fclose(pFile) != 0 || !ok)
+  {
+    ::remove(tmp.c_str());
+    throw IOException("Cannot write in file", __FILE__, __LINE__, tmp);
+  }
+#if defined(_WIN32)
+  ::remove(f.c_str()); // rename() does not replace a file
+#endif
+  if (::rename(tmp.c_str(), f.c_str()) != 0)
+  {
+    ::remove(tmp.c_str());
+    throw IOException("Cannot rename file", __FILE__, __LINE__, tmp);
+  }
+  // the archive opened for this file is stale : the readers keep it and
+  // open() reads the new one
+  std::lock_guard<std::mutex> lock(getOpenMutex());
+  getOpenArchives().erase(f);
+  return total;
+}
+//-------------------------------------------------------------------------
+unsigned long A::unpack(const FileName& f, const Config& c)
+{
+  FeatureArchive a(f);
+  Config cc(c);
+  for (unsigned long i=0; i<a.getEntryCount(); i++)
+  {
+    const unsigned long vectSize = a.getVectSize(i);
+    const unsigned long featureCount = a.getFeatureCount(i);
+    const float* p = a.getFeatures(i);
+    cc.setParam("featureFlags", a.getFeatureFlags(i).getString());
+    cc.setParam("sampleRate", std::to_string(a.getSampleRate(i)));
+    FeatureFileWriter w(a.getName(i), cc);
+    Feature feature(vectSize);
+    for (unsigned long t=0; t<featureCount; t++, p+=vectSize)
+    {
+      for (unsigned long j=0; j<vectSize; j++)
+        feature[j] = p[j];
+      w.writeFeature(feature);
+    }
+    w.close();
+  }
+  return a.getEntryCount();
+}
+//-------------------------------------------------------------------------
+unsigned long A::getEntryCount() const { return _entryOffsets.size(); }
+//-------------------------------------------------------------------------
+bool A::exists(const string& name) const
+{ return _indexMap.find(name) != _indexMap.end(); }
+//-------------------------------------------------------------------------
+unsigned long A::getEntryIndex(const string& name) const
+{
+  std::map<std::string, unsigned long>::const_iterator it
+                                                  = _indexMap.find(name);
+  if (it == _indexMap.end())
+    throw Exception("Utterance '" + name + "' not found in the archive '"
+                    + _fileName + "'", __FILE__, __LINE__);
+  return it->second;
+}
+//-------------------------------------------------------------------------
+// Entry of the index (copied : the entries are not aligned)
+//-------------------------------------------------------------------------
+static FAREntry getEntry(const MappedFile& m, unsigned long pos)
+{
+  FAREntry e;
+  memcpy(&e, m.getData()+pos, sizeof(e));
+  return e;
+}
+//-------------------------------------------------------------------------
+string A::getName(unsigned long i) const
+{
+  const unsigned long pos = _entryOffsets[i];
+  return string(_pMappedFile->getData()+pos+sizeof(FAREntry),
+                getEntry(*_pMappedFile, pos).nameLength);
+}
+//-------------------------------------------------------------------------
+unsigned long A::getFeatureCount(unsigned long i) const
+{ return (unsigned long)getEntry(*_pMappedFile, _entryOffsets[i])
+                                 .featureCount; }
+//-------------------------------------------------------------------------
+unsigned long A::getVectSize(unsigned long i) const
+{ return getEntry(*_pMappedFile, _entryOffsets[i]).vectSize; }
+//-------------------------------------------------------------------------
+FeatureFlags A::getFeatureFlags(unsigned long i) const
+{ return FeatureFlags(string(getEntry(*_pMappedFile, _entryOffsets[i])
+                                     .flags)); }
+//-------------------------------------------------------------------------
+real_t A::getSampleRate(unsigned long i) const
+{ return getEntry(*_pMappedFile, _entryOffsets[i]).sampleRate; }
+//-------------------------------------------------------------------------
+const float* A::getFeatures(unsigned long i) const
+{
+  return reinterpret_cast<const float*>(_pMappedFile->getData()
+               + getEntry(*_pMappedFile, _entryOffsets[i]).offset);
+}
+//-------------------------------------------------------------------------
+const FileName& A::getFileName() const { return _fileName; }
+//-------------------------------------------------------------------------
+string A::getClassName() const { return "FeatureArchive"; }
+//-------------------------------------------------------------------------
+string A::toString() const
+{
+  return Object::toString()
+    + "\n  file name = '" + _fileName + "'"
+    + "\n  utterances = " + std::to_string(getEntryCount());
+}
+//-------------------------------------------------------------------------
+A::~FeatureArchive() { delete _pMappedFile; }
+//-------------------------------------------------------------------------
+#endif // !defined(ALIZE_FeatureArchive_cpp)
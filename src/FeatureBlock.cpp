@@ -0,0 +1,142 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_FeatureBlock_cpp)
+#define ALIZE_FeatureBlock_cpp
+
+#include "FeatureBlock.h"
+#include "Feature.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef FeatureBlock B;
+
+//-------------------------------------------------------------------------
+B::FeatureBlock(unsigned long vectSize)
+:Object(), _vect(), _pData(NULL), _frameCount(0), _vectSize(vectSize),
+ _alias(false) {}
+//-------------------------------------------------------------------------
+void B::setDimensions(unsigned long frameCount, unsigned long vectSize)
+{
+  _vect.setSize(frameCount*vectSize);
+  _pData = _vect.getArray();
+  _frameCount = frameCount;
+  _vectSize = vectSize;
+  _alias = false;
+}
+//-------------------------------------------------------------------------
+void B::setAlias(const float* frames, unsigned long frameCount,
+                 unsigned long vectSize)
+{
+  _pData = frames;
+  _frameCount = frameCount;
+  _vectSize = vectSize;
+  _alias = true;
+}
+//-------------------------------------------------------------------------
+bool B::isAlias() const { return _alias; }
+//-------------------------------------------------------------------------
+const float* B::getArray() const { return _pData; }
+//-------------------------------------------------------------------------
+float* B::getWritableArray()
+{
+  if (_alias)
+    throw Exception("Cannot write the frames of an alias",
+                    __FILE__, __LINE__);
+  return _vect.getArray();
+}
+//-------------------------------------------------------------------------
+const float* B::getFrame(unsigned long n) const
+{
+  assertIsInBounds(__FILE__, __LINE__, n, _frameCount);
+  return _pData + n*_vectSize;
+}
+//-------------------------------------------------------------------------
+void B::setFrame(unsigned long n, const Feature& f)
+{
+  if (f.getVectSize() != _vectSize)
+    throw Exception("block vectSize (" + std::to_string(_vectSize)
+        + ") != feature vectSize (" + std::to_string(f.getVectSize())
+        + ")", __FILE__, __LINE__);
+  assertIsInBounds(__FILE__, __LINE__, n, _frameCount);
+  float* p = getWritableArray() + n*_vectSize;
+  for (unsigned long i=0; i<_vectSize; i++)
+    p[i] = (float)f[i];
+}
+//-------------------------------------------------------------------------
+void B::getFeature(unsigned long n, Feature& f) const
+{
+  f.setVectSize(K::k, _vectSize);
+  f.setData(getFrame(n));
+}
+//-------------------------------------------------------------------------
+unsigned long B::getFrameCount() const { return _frameCount; }
+//-------------------------------------------------------------------------
+unsigned long B::getVectSize() const { return _vectSize; }
+//-------------------------------------------------------------------------
+string B::getClassName() const { return "FeatureBlock"; }
+//-------------------------------------------------------------------------
+string B::toString() const
+{
+  return Object::toString()
+    + "\n  frameCount = " + std::to_string(_frameCount)
+    + "\n  vectSize   = " + std::to_string(_vectSize)
+    + "\n  alias      = " + (_alias ? "true" : "false");
+}
+//-------------------------------------------------------------------------
+B::~FeatureBlock() {}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_FeatureBlock_cpp)
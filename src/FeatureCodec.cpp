@@ -0,0 +1,368 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_FeatureCodec_cpp)
+#define ALIZE_FeatureCodec_cpp
+
+// see GDKernel.cpp. No FMA in the AVX2 version : all the versions compute
+// offset + scale*code with the same roundings.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+  #define ALIZE_FEATURECODEC_X86
+  #define ALIZE_FEATURECODEC_AVX
+  #define TARGET_SSE2   __attribute__((target("sse2")))
+  #define TARGET_AVX2   __attribute__((target("avx2")))
+  #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+  #define ALIZE_FEATURECODEC_X86
+  #define TARGET_SSE2
+  #include <emmintrin.h>
+#endif
+
+#include <cstring>
+#include <cmath>
+#include "FeatureCodec.h"
+#include "FeatureFlags.h"
+#include "FeatureBlock.h"
+#include "FeatureInputStream.h"
+#include "StatServer.h"
+#include "Mixture.h"
+#include "GDKernel.h"
+#include "Matrix.h"
+#include "RealVector.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef FeatureCodec C;
+
+static const char CFF_MAGIC[8] = {'A','L','I','Z','E','C','F','F'};
+static const uint32_t CFF_VERSION = 1;
+static const uint32_t CFF_BYTE_ORDER_MARK = 0x01020304;
+
+static_assert(sizeof(FeatureCodec::FileHeader) == 64,
+              "wrong size of FeatureCodec::FileHeader");
+
+const unsigned long C::BLOCK_FRAME_COUNT = 256;
+
+//-------------------------------------------------------------------------
+// Decoding of one block : out[t][j] = offset[j] + scale[j]*code[t][j]
+//-------------------------------------------------------------------------
+template <class T>
+static void decodeScalar(const float* scale, const float* offset,
+                         const T* codes, unsigned long frameCount,
+                         unsigned long vectSize, float* out)
+{
+  for (unsigned long t=0; t<frameCount; t++, codes+=vectSize, out+=vectSize)
+    for (unsigned long j=0; j<vectSize; j++)
+    {
+      const float v = scale[j]*(float)codes[j];
+      out[j] = offset[j] + v;
+    }
+}
+#if defined(ALIZE_FEATURECODEC_X86)
+//-------------------------------------------------------------------------
+// 8 codes -> 8 unsigned 16-bit integers
+TARGET_SSE2 static inline __m128i load8(const uint16_t* p)
+{ return _mm_loadu_si128((const __m128i*)p); }
+TARGET_SSE2 static inline __m128i load8(const uint8_t* p)
+{ return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)p),
+                           _mm_setzero_si128()); }
+//-------------------------------------------------------------------------
+template <class T>
+TARGET_SSE2 static void decodeSSE2(const float* scale, const float* offset,
+                                   const T* codes, unsigned long frameCount,
+                                   unsigned long vectSize, float* out)
+{
+  const __m128i zero = _mm_setzero_si128();
+  for (unsigned long t=0; t<frameCount; t++, codes+=vectSize, out+=vectSize)
+  {
+    unsigned long j = 0;
+    for (; j+8<=vectSize; j+=8)
+    {
+      const __m128i x = load8(codes+j);
+      const __m128 lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(x, zero));
+      const __m128 hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(x, zero));
+      _mm_storeu_ps(out+j, _mm_add_ps(_mm_loadu_ps(offset+j),
+                           _mm_mul_ps(_mm_loadu_ps(scale+j), lo)));
+      _mm_storeu_ps(out+j+4, _mm_add_ps(_mm_loadu_ps(offset+j+4),
+                             _mm_mul_ps(_mm_loadu_ps(scale+j+4), hi)));
+    }
+    for (; j<vectSize; j++)
+    {
+      const float v = scale[j]*(float)codes[j];
+      out[j] = offset[j] + v;
+    }
+  }
+}
+#endif
+#if defined(ALIZE_FEATURECODEC_AVX)
+//-------------------------------------------------------------------------
+// 8 codes -> 8 floats
+TARGET_AVX2 static inline __m256 load8Float(const uint16_t* p)
+{ return _mm256_cvtepi32_ps(
+         _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)p))); }
+TARGET_AVX2 static inline __m256 load8Float(const uint8_t* p)
+{ return _mm256_cvtepi32_ps(
+         _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)p))); }
+//-------------------------------------------------------------------------
+template <class T>
+TARGET_AVX2 static void decodeAVX2(const float* scale, const float* offset,
+                                   const T* codes, unsigned long frameCount,
+                                   unsigned long vectSize, float* out)
+{
+  for (unsigned long t=0; t<frameCount; t++, codes+=vectSize, out+=vectSize)
+  {
+    unsigned long j = 0;
+    for (; j+16<=vectSize; j+=16)
+    {
+      const __m256 a = load8Float(codes+j);
+      const __m256 b = load8Float(codes+j+8);
+      _mm256_storeu_ps(out+j, _mm256_add_ps(_mm256_loadu_ps(offset+j),
+                              _mm256_mul_ps(_mm256_loadu_ps(scale+j), a)));
+      _mm256_storeu_ps(out+j+8, _mm256_add_ps(_mm256_loadu_ps(offset+j+8),
+                              _mm256_mul_ps(_mm256_loadu_ps(scale+j+8), b)));
+    }
+    for (; j+8<=vectSize; j+=8)
+      _mm256_storeu_ps(out+j, _mm256_add_ps(_mm256_loadu_ps(offset+j),
+          _mm256_mul_ps(_mm256_loadu_ps(scale+j), load8Float(codes+j))));
+    for (; j<vectSize; j++)
+    {
+      const float v = scale[j]*(float)codes[j];
+      out[j] = offset[j] + v;
+    }
+  }
+}
+#endif
+//-------------------------------------------------------------------------
+template <class T>
+static void decode(const float* scale, const float* offset, const T* codes,
+                   unsigned long frameCount, unsigned long vectSize,
+                   float* out)
+{
+  switch (GDKernel::getSimdLevel())
+  {
+#if defined(ALIZE_FEATURECODEC_AVX)
+    case SimdLevel_AVX512:
+    case SimdLevel_AVX2:
+      decodeAVX2(scale, offset, codes, frameCount, vectSize, out);
+      return;
+#endif
+#if defined(ALIZE_FEATURECODEC_X86)
+    case SimdLevel_SSE2:
+      decodeSSE2(scale, offset, codes, frameCount, vectSize, out);
+      return;
+#endif
+    default:
+      decodeScalar(scale, offset, codes, frameCount, vectSize, out);
+  }
+}
+//-------------------------------------------------------------------------
+template <class T>
+static void encode(const float* frames, unsigned long frameCount,
+                   unsigned long vectSize, unsigned long maxCode,
+                   const float* scale, const float* offset, T* codes)
+{
+  for (unsigned long t=0; t<frameCount; t++, frames+=vectSize,
+       codes+=vectSize)
+    for (unsigned long j=0; j<vectSize; j++)
+    {
+      unsigned long c = 0;
+      if (scale[j] > 0)
+      {
+        const float q = (frames[j]-offset[j])/scale[j] + 0.5f;
+        if (q >= (float)maxCode)
+          c = maxCode;
+        else if (q > 0)
+          c = (unsigned long)q;
+      }
+      codes[j] = (T)c;
+    }
+}
+//-------------------------------------------------------------------------
+void C::initHeader(FileHeader& h, unsigned long vectSize,
+                   unsigned long bits, const FeatureFlags& flags,
+                   real_t sampleRate)
+{
+  if (bits != 8 && bits != 16)
+    throw Exception("Compressed features : 8 or 16 bits expected",
+                    __FILE__, __LINE__);
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, CFF_MAGIC, sizeof(h.magic));
+  h.version = CFF_VERSION;
+  h.byteOrderMark = CFF_BYTE_ORDER_MARK;
+  h.vectSize = (uint32_t)vectSize;
+  h.bits = (uint32_t)bits;
+  h.blockFrameCount = (uint32_t)BLOCK_FRAME_COUNT;
+  h.sampleRate = (float)sampleRate;
+  strncpy(h.flags, flags.getString().c_str(), sizeof(h.flags)-1);
+}
+//-------------------------------------------------------------------------
+void C::checkHeader(const FileHeader& h, const string& fileName)
+{
+  if (memcmp(h.magic, CFF_MAGIC, sizeof(h.magic)) != 0)
+    throw InvalidDataException("Not a compressed feature file",
+                               __FILE__, __LINE__, fileName);
+  if (h.byteOrderMark != CFF_BYTE_ORDER_MARK)
+    throw InvalidDataException("Compressed feature file written with "
+               "another byte order", __FILE__, __LINE__, fileName);
+  if (h.version != CFF_VERSION)
+    throw InvalidDataException("Unsupported version of compressed "
+               "feature file", __FILE__, __LINE__, fileName);
+  if ((h.bits != 8 && h.bits != 16) || h.vectSize == 0
+      || h.blockFrameCount == 0 || h.flags[sizeof(h.flags)-1] != 0)
+    throw InvalidDataException("Wrong header", __FILE__, __LINE__,
+                               fileName);
+}
+//-------------------------------------------------------------------------
+unsigned long C::getBlockSize(unsigned long frameCount,
+                              unsigned long vectSize, unsigned long bits)
+{
+  const unsigned long codeSize = (frameCount*vectSize*(bits/8)+3)/4*4;
+  return 2*vectSize*sizeof(float) + codeSize;
+}
+//-------------------------------------------------------------------------
+void C::encodeBlock(const float* frames, unsigned long frameCount,
+                    unsigned long vectSize, unsigned long bits, char* block)
+{
+  float* scale = reinterpret_cast<float*>(block);
+  float* offset = scale + vectSize;
+  char* codes = reinterpret_cast<char*>(offset + vectSize);
+  const unsigned long maxCode = (1UL << bits) - 1;
+  for (unsigned long j=0; j<vectSize; j++)
+  {
+    float min = frameCount > 0 ? frames[j] : 0.0f;
+    float max = min;
+    for (unsigned long t=1; t<frameCount; t++)
+    {
+      const float x = frames[t*vectSize+j];
+      if (x < min)
+        min = x;
+      else if (x > max)
+        max = x;
+    }
+    offset[j] = min;
+    scale[j] = (max-min)/(float)maxCode;
+    if (!(scale[j] > 0)) // constant values (or NaN)
+      scale[j] = 0.0f;
+  }
+  const unsigned long n = frameCount*vectSize*(bits/8);
+  memset(codes+n, 0, getBlockSize(frameCount, vectSize, bits)
+                     - 2*vectSize*sizeof(float) - n);
+  if (bits == 8)
+    encode(frames, frameCount, vectSize, maxCode, scale, offset,
+           reinterpret_cast<uint8_t*>(codes));
+  else
+    encode(frames, frameCount, vectSize, maxCode, scale, offset,
+           reinterpret_cast<uint16_t*>(codes));
+}
+//-------------------------------------------------------------------------
+void C::decodeBlock(const char* block, unsigned long frameCount,
+                    unsigned long vectSize, unsigned long bits,
+                    float* frames)
+{
+  const float* scale = reinterpret_cast<const float*>(block);
+  const float* offset = scale + vectSize;
+  const char* codes = reinterpret_cast<const char*>(offset + vectSize);
+  if (bits == 8)
+    decode(scale, offset, reinterpret_cast<const uint8_t*>(codes),
+           frameCount, vectSize, frames);
+  else
+    decode(scale, offset, reinterpret_cast<const uint16_t*>(codes),
+           frameCount, vectSize, frames);
+}
+//-------------------------------------------------------------------------
+unsigned long C::measureLLKError(StatServer& ss, const Mixture& m,
+                   FeatureInputStream& s, unsigned long bits,
+                   real_t& scoreError, real_t& meanFrameError,
+                   real_t& maxFrameError)
+{
+  if (bits != 8 && bits != 16)
+    throw Exception("Compressed features : 8 or 16 bits expected",
+                    __FILE__, __LINE__);
+  FeatureBlock b, q;
+  DoubleMatrix llkMatrix;
+  DoubleVector llk, llkq;
+  FloatVector block;
+  double sum = 0.0, sumq = 0.0, sumError = 0.0, maxError = 0.0;
+  unsigned long count = 0, n;
+  s.reset();
+  while ((n = s.readFeatures(b, BLOCK_FRAME_COUNT)) > 0)
+  {
+    const unsigned long vectSize = b.getVectSize();
+    block.setSize(getBlockSize(n, vectSize, bits)/sizeof(float));
+    char* p = reinterpret_cast<char*>(block.getArray());
+    encodeBlock(b.getArray(), n, vectSize, bits, p);
+    q.setDimensions(n, vectSize);
+    decodeBlock(p, n, vectSize, bits, q.getWritableArray());
+    ss.computeLLK(m, b, llkMatrix, llk);
+    ss.computeLLK(m, q, llkMatrix, llkq);
+    for (unsigned long t=0; t<n; t++)
+    {
+      const double e = fabs(llkq[t]-llk[t]);
+      sum += llk[t];
+      sumq += llkq[t];
+      sumError += e;
+      if (e > maxError)
+        maxError = e;
+    }
+    count += n;
+  }
+  scoreError = count > 0 ? fabs(sumq-sum)/count : 0.0;
+  meanFrameError = count > 0 ? sumError/count : 0.0;
+  maxFrameError = maxError;
+  return count;
+}
+//-------------------------------------------------------------------------
+#endif // !defined(ALIZE_FeatureCodec_cpp)
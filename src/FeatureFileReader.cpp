@@ -62,7 +62,10 @@
 #include "FeatureFileReaderSPro3.h"
 #include "FeatureFileReaderSPro4.h"
 #include "FeatureFileReaderHTK.h"
+#include "FeatureFileReaderCompressed.h"
+#include "FeatureFileReaderArchive.h"
 #include "Feature.h"
+#include "FeatureBlock.h"
 #include "Exception.h"
 #include "LabelServer.h"
 #include "Label.h"
@@ -121,6 +124,10 @@ FeatureFileReaderAbstract& R::createStream(const FileName& f,
         return FeatureFileReaderHTK::create(f, c, p, be, b, bufferSize, h, historicSize);
     case FeatureFileReaderFormat_RAW:
         return FeatureFileReaderRaw::create(f, c, p, be, b, bufferSize, h, historicSize);
+    case FeatureFileReaderFormat_COMPRESSED:
+        return FeatureFileReaderCompressed::create(f, c, p, b, bufferSize, h, historicSize);
+    case FeatureFileReaderFormat_ARCHIVE:
+        return FeatureFileReaderArchive::create(f, c, p, b, bufferSize, h, historicSize);
     }
   throw Exception("Param 'loadFeatureFileFormat' expected in the config",
                   __FILE__, __LINE__);
@@ -172,6 +179,23 @@ bool R::readFeature(Feature& f, unsigned long step)
   return ok;
 }
 //-------------------------------------------------------------------------
+unsigned long R::readFeatures(FeatureBlock& b, unsigned long maxFrames)
+{
+  if (_pFeatureReader == NULL)
+  {
+    b.setDimensions(0, b.getVectSize());
+    return 0;
+  }
+  if (_seekWanted)
+  {
+    _seekWanted = false;
+    _pFeatureReader->seekFeature(_seekWantedIdx, _seekWantedSrcName);
+  }
+  unsigned long n = _pFeatureReader->readFeatures(b, maxFrames);
+  _error = _pFeatureReader->getError();
+  return n;
+}
+//-------------------------------------------------------------------------
 bool R::addFeature(const Feature& f)
 {
   if (_pFeatureReader == NULL)
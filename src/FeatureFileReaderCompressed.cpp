@@ -0,0 +1,246 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_FeatureFileReaderCompressed_cpp)
+#define ALIZE_FeatureFileReaderCompressed_cpp
+
+#include <new>
+#include <cstring>
+#include "FeatureFileReaderCompressed.h"
+#include "FeatureCodec.h"
+#include "FileReader.h"
+#include "Exception.h"
+#include "FeatureFlags.h"
+#include "Config.h"
+
+using namespace std;
+using namespace alize;
+typedef FeatureFileReaderCompressed R;
+
+// no block decoded in _frames (or no block at the position of the file)
+static const unsigned long NO_BLOCK_INDEX = ~0UL;
+
+//-------------------------------------------------------------------------
+R::FeatureFileReaderCompressed(const FileName& f, const Config& c,
+      LabelServer* l, BufferUsage b, unsigned long bufferSize,
+      HistoricUsage h, unsigned long historicSize)
+:FeatureFileReaderSingle(&FileReader::create(f, getPath(f, c),
+ getExt(f, c), false), NULL, c, l, b, bufferSize, h, historicSize),
+ _paramDefined(false), _bits(0), _blockFrameCount(0),
+ _framesBlockIndex(NO_BLOCK_INDEX)
+{
+  // the frames are decoded : no mapping of the file
+  _mappingWanted = false;
+  _featuresAreWritable = (c.existsParam_featureServerMode &&
+                          c.getParam_featureServerMode()
+                          == "FEATURE_WRITABLE");
+  _readAheadWanted = (c.existsParam("loadFeatureFileReadAhead")
+                      && c.getParam("loadFeatureFileReadAhead") == "true");
+}
+//-------------------------------------------------------------------------
+R& R::create(const FileName& f, const Config& c, LabelServer* l,
+             BufferUsage b, unsigned long bufferSize,
+             HistoricUsage h, unsigned long historicSize)
+{
+  R* p = new (std::nothrow)
+         FeatureFileReaderCompressed(f, c, l, b, bufferSize, h, historicSize);
+  assertMemoryIsAllocated(p, __FILE__, __LINE__);
+  return *p;
+}
+//-------------------------------------------------------------------------
+void R::readParams() // private
+{
+  assert(_pReader != NULL);
+  _pReader->open(); // can throw FileNotFoundException
+  const string& fileName = _pReader->getFullFileName();
+  FeatureCodec::FileHeader h;
+  _pReader->readBytes(&h, sizeof(h));
+  FeatureCodec::checkHeader(h, fileName);
+
+  _featureCount = (unsigned long)h.featureCount;
+  _vectSize = h.vectSize;
+  _bits = h.bits;
+  _blockFrameCount = h.blockFrameCount;
+  _sampleRate = (real_t)h.sampleRate;
+  _flags = FeatureFlags(string(h.flags));
+  _headerLength = sizeof(h);
+
+  const unsigned long blockCount = (_featureCount+_blockFrameCount-1)
+                                   /_blockFrameCount;
+  const unsigned long long length = _pReader->getFileLength();
+  if (h.indexOffset < sizeof(h) || h.indexOffset > length
+      || blockCount > (length-h.indexOffset)/sizeof(uint64_t))
+    throw InvalidDataException("Wrong index of blocks", __FILE__,
+                               __LINE__, fileName);
+  _pReader->seek(h.indexOffset);
+  _blockOffsets.setSize(blockCount);
+  _pReader->readBytes(_blockOffsets.getArray(), blockCount*sizeof(uint64_t));
+  _fileFeatureIndex = NO_BLOCK_INDEX; // the file is not at a block
+  _framesBlockIndex = NO_BLOCK_INDEX;
+  _paramDefined = true;
+}
+//-------------------------------------------------------------------------
+// Reads a block in _block and returns its number of frames
+//-------------------------------------------------------------------------
+unsigned long R::readBlock(unsigned long blockIndex) // private
+{
+  const unsigned long first = blockIndex*_blockFrameCount;
+  const unsigned long frameCount = getBlockFrameCount(blockIndex);
+  const unsigned long size = FeatureCodec::getBlockSize(frameCount,
+                                                        _vectSize, _bits);
+  // _fileFeatureIndex : first frame of the block at the position of the
+  // file
+  if (_fileFeatureIndex != first)
+    _pReader->seek(_blockOffsets[blockIndex]);
+  _block.setSize(size/sizeof(float));
+  _pReader->readBytes(_block.getArray(), size);
+  if (blockIndex+1 < _blockOffsets.size()
+      && _blockOffsets[blockIndex+1] == _blockOffsets[blockIndex]+size)
+    _fileFeatureIndex = first + frameCount;
+  else
+    _fileFeatureIndex = NO_BLOCK_INDEX;
+  return frameCount;
+}
+//-------------------------------------------------------------------------
+unsigned long R::getBlockFrameCount(unsigned long blockIndex) const
+{ // private
+  const unsigned long n = _featureCount - blockIndex*_blockFrameCount;
+  return n < _blockFrameCount ? n : _blockFrameCount;
+}
+//-------------------------------------------------------------------------
+// Full blocks are decoded directly in the vector. The first and the last
+// blocks can be partial : they are decoded in _frames, which is kept for
+// the next call.
+//-------------------------------------------------------------------------
+unsigned long R::loadFrames(FloatVector& v, unsigned long start) // protected
+{
+  const unsigned long vectSize = getVectSize(); // reads the header
+  if (start >= _featureCount)
+    return 0;
+  unsigned long n = v.size()/vectSize;
+  if (n > _featureCount-start)
+    n = _featureCount-start;
+  const unsigned long end = start + n;
+  for (unsigned long t=start; t<end; )
+  {
+    const unsigned long blockIndex = t/_blockFrameCount;
+    const unsigned long first = blockIndex*_blockFrameCount;
+    float* out = v.getArray() + (t-start)*vectSize;
+    if (t == first && end-first >= getBlockFrameCount(blockIndex)
+        && blockIndex != _framesBlockIndex)
+    {
+      const unsigned long frameCount = readBlock(blockIndex);
+      FeatureCodec::decodeBlock((const char*)_block.getArray(), frameCount,
+                                vectSize, _bits, out);
+      t += frameCount;
+      continue;
+    }
+    if (blockIndex != _framesBlockIndex)
+    {
+      const unsigned long frameCount = readBlock(blockIndex);
+      _frames.setSize(frameCount*vectSize);
+      FeatureCodec::decodeBlock((const char*)_block.getArray(), frameCount,
+                                vectSize, _bits, _frames.getArray());
+      _framesBlockIndex = blockIndex;
+    }
+    unsigned long last = first + _frames.size()/vectSize;
+    if (last > end)
+      last = end;
+    memcpy(out, _frames.getArray() + (t-first)*vectSize,
+           (last-t)*vectSize*sizeof(float));
+    t = last;
+  }
+  return n;
+}
+//-------------------------------------------------------------------------
+unsigned long R::getFeatureCount()
+{
+  if (!_paramDefined)
+    readParams();  // can throw FileNotFoundException
+  return _featureCount;
+}
+//-------------------------------------------------------------------------
+unsigned long R::getVectSize()
+{
+  if (!_paramDefined)
+    readParams(); // can throw FileNotFoundException
+  return _vectSize;
+}
+//-------------------------------------------------------------------------
+const FeatureFlags& R::getFeatureFlags()
+{
+  if (!_paramDefined)
+    readParams(); // can throw FileNotFoundException
+  return _flags;
+}
+//-------------------------------------------------------------------------
+real_t R::getSampleRate()
+{
+  if (!_paramDefined)
+    readParams(); // can throw FileNotFoundException
+  return _sampleRate;
+}
+//-------------------------------------------------------------------------
+unsigned long R::getHeaderLength()
+{
+  if (!_paramDefined)
+    readParams(); // can throw FileNotFoundException
+  return _headerLength;
+}
+//-------------------------------------------------------------------------
+string R::getClassName() const { return "FeatureFileReaderCompressed";}
+//-------------------------------------------------------------------------
+R::~FeatureFileReaderCompressed() { stopReadAhead(); } // before the members
+//-------------------------------------------------------------------------
+#endif // !defined(ALIZE_FeatureFileReaderCompressed_cpp)
@@ -192,7 +192,7 @@ bool R::readHeader()
 //-------------------------------------------------------------------------
 unsigned long R::getHeaderLength() { return 12; }
 //-------------------------------------------------------------------------
-R::~FeatureFileReaderHTK() {}
+R::~FeatureFileReaderHTK() { stopReadAhead(); }
 //-------------------------------------------------------------------------
 
 #endif // !defined(ALIZE_FeatureFileReaderHTK_cpp)
@@ -122,7 +122,7 @@ real_t R::getSampleRate() { return getConfig().getParam_sampleRate(); }
 //-------------------------------------------------------------------------
 string R::getClassName() const { return "FeatureFileReaderRaw"; }
 //-------------------------------------------------------------------------
-R::~FeatureFileReaderRaw() {}
+R::~FeatureFileReaderRaw() { stopReadAhead(); }
 //-------------------------------------------------------------------------
 
 #endif // !defined(ALIZE_FeatureFileReaderRaw_cpp)
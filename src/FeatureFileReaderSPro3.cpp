@@ -533,7 +533,7 @@ bool R::readHeader()
     return false; // la y'a un probleme !
 }
 //-------------------------------------------------------------------------
-R::~FeatureFileReaderSPro3() {}
+R::~FeatureFileReaderSPro3() { stopReadAhead(); }
 //-------------------------------------------------------------------------
 
 #endif // !defined(ALIZE_FeatureFileReaderSPro3_cpp)
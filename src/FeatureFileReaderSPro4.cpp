@@ -247,7 +247,7 @@ bool R::readHeader()
   return true;
 }
 //-------------------------------------------------------------------------
-R::~FeatureFileReaderSPro4() {}
+R::~FeatureFileReaderSPro4() { stopReadAhead(); }
 //-------------------------------------------------------------------------
 /*
 Format en-tete fichier SPRO 4.0
@@ -56,8 +56,15 @@
 #define ALIZE_FeatureFileReaderSingle_cpp
 
 #include <new>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include "FeatureFileReaderSingle.h"
 #include "FileReader.h"
+#include "MappedFile.h"
+#include "FeatureBlock.h"
 #include "Exception.h"
 #include "LabelServer.h"
 #include "Label.h"
@@ -73,6 +80,86 @@ using namespace std;
 using namespace alize;
 typedef FeatureFileReaderSingle R;
 
+// position of the file unknown : the next load seeks
+static const unsigned long NO_FEATURE_INDEX = ~0UL;
+
+//-------------------------------------------------------------------------
+// Background thread which loads a block of features into a second buffer
+//-------------------------------------------------------------------------
+struct R::ReadAhead
+{
+  std::thread             thread;
+  std::mutex              mutex;
+  std::condition_variable condition;
+  FeatureFileReaderSingle& owner;
+  FloatVector*            pBuffer;
+  unsigned long           start;    // index of the first feature
+  unsigned long           count;    // number of features read
+  bool                    requested; // block requested and not yet used
+  bool                    pending;   // block not yet read
+  bool                    stop;
+  std::exception_ptr      error;
+
+  explicit ReadAhead(FeatureFileReaderSingle& o)
+  :owner(o), pBuffer(&FloatVector::create()), start(0),
+   count(0), requested(false), pending(false), stop(false)
+  { thread = std::thread(&ReadAhead::work, this); }
+
+  ~ReadAhead()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    condition.notify_all();
+    thread.join();
+    delete pBuffer;
+  }
+
+  void request(unsigned long first)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      start = first;
+      error = std::exception_ptr();
+      pending = true;
+    }
+    requested = true;
+    condition.notify_all();
+  }
+
+  // waits for the block requested and throws again the exception of the
+  // thread, if any
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return !pending; });
+    requested = false;
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  void work()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+      condition.wait(lock, [this] { return stop || pending; });
+      if (stop)
+        return;
+      lock.unlock();
+      try
+      {
+        count = owner.loadFrames(*pBuffer, start);
+      }
+      catch (...) { error = std::current_exception(); }
+      lock.lock();
+      pending = false;
+      condition.notify_all();
+    }
+  }
+};
+
 //-------------------------------------------------------------------------
 R::FeatureFileReaderSingle(FileReader* r, FeatureInputStream* st, 
                            const Config& c, LabelServer* p,
@@ -81,8 +168,20 @@ R::FeatureFileReaderSingle(FileReader* r, FeatureInputStream* st,
 :FeatureFileReaderAbstract(NULL, c, p, b, bufferSize, h, historicSize),
  _pReader(r), _pFeatureInputStream(st), _pFeature(NULL), _featureIndex(0),
  _lastFeatureIndex(0),
- _featureIndexOfBuffer(0), _nbStored(0), _pBuffer(&FloatVector::create())
-{}
+ _featureIndexOfBuffer(0), _nbStored(0), _pBuffer(&FloatVector::create()),
+ _fileFeatureIndex(NO_FEATURE_INDEX),
+ _mappingWanted(r != NULL && c.existsParam("loadFeatureFileMapping")
+                && c.getParam("loadFeatureFileMapping") == "true"),
+ _pMappedFile(NULL),
+ _readAheadWanted(r != NULL && !_mappingWanted
+                  && c.existsParam("loadFeatureFileReadAhead")
+                  && c.getParam("loadFeatureFileReadAhead") == "true"),
+ _labelCode(0), _labelCodeDefined(false), _labelServerRevision(0),
+ _pReadAhead(NULL)
+{
+  if (_mappingWanted)
+    _featuresAreWritable = false;
+}
 //-------------------------------------------------------------------------
 string R::getPath(const FileName& f, const Config& c) const
 {  // protected method
@@ -112,12 +211,68 @@ bool R::getBigEndian(const Config& c, BigEndian b) const // protected
   return false;
 }
 //-------------------------------------------------------------------------
+void R::stopReadAhead() // protected
+{
+  if (_pReadAhead != NULL)
+  {
+    delete _pReadAhead; // waits for the thread
+    _pReadAhead = NULL;
+  }
+}
+//-------------------------------------------------------------------------
 void R::close()
 {
+  stopReadAhead();
+  if (_pMappedFile != NULL)
+  {
+    delete _pMappedFile;
+    _pMappedFile = NULL;
+  }
   if (_pReader != NULL)
     _pReader->close();
   if (_pFeatureInputStream != NULL)
     _pFeatureInputStream->close();
+  _fileFeatureIndex = NO_FEATURE_INDEX;
+}
+//-------------------------------------------------------------------------
+// Loads the features from 'start' in the vector (as many as it can hold)
+// and returns the number of features loaded. The file is read from where
+// the previous call stopped when possible. Called by the read-ahead
+// thread too : only the file and the vector are used.
+//-------------------------------------------------------------------------
+unsigned long R::loadFrames(FloatVector& v, unsigned long start) // protected
+{
+  unsigned long n = 0;
+  if (_pReader != NULL)
+  {
+    const unsigned long vectSize = getVectSize();
+    if (start != _fileFeatureIndex)
+      _pReader->seek(getHeaderLength() + start*vectSize*sizeof(float));
+    const unsigned long m = _pReader->readSomeFloats(v);
+    n = m/vectSize;
+    if (m%vectSize != 0) // stopped inside a frame
+    {
+      _fileFeatureIndex = NO_FEATURE_INDEX;
+      return n;
+    }
+  }
+  else
+  {
+    if (start != _fileFeatureIndex)
+      _pFeatureInputStream->seekFeature(start);
+    const unsigned long vectSize = _pFeatureInputStream->getVectSize();
+    // Pas performant. A améliorer
+    while ((n+1)*vectSize <= v.size()
+            && _pFeatureInputStream->readFeature(_f))
+    {
+      unsigned long ii = n*vectSize;
+      for (unsigned long j=0; j<vectSize; j++)
+        v[ii+j] = (float) _f[j];
+      n++;
+    }
+  }
+  _fileFeatureIndex = start + n;
+  return n;
 }
 //-------------------------------------------------------------------------
 bool R::readFeature(Feature& f, unsigned long step)
@@ -139,8 +294,11 @@ bool R::readFeature(Feature& f, unsigned long step)
   unsigned long featureCount = getFeatureCount();
   if (_featureIndex >= featureCount)
     return false;
+  // fichier projete en memoire : pas de buffer
+  if (_mappingWanted)
+    setMappedData(f);
   // si on demande une feature hors du buffer
-  if (_featureIndex < _featureIndexOfBuffer ||
+  else if (_featureIndex < _featureIndexOfBuffer ||
       _featureIndex >= _featureIndexOfBuffer + _nbStored)
   {
     if (!_bufferSizeDefined)
@@ -163,57 +321,34 @@ bool R::readFeature(Feature& f, unsigned long step)
       }
       if (m < getVectSize()) // minimum size
         m = getVectSize();
-      _pBuffer->setSize(m);
+      // whole frames only : the next block follows the last frame read
+      _pBuffer->setSize(m - m%getVectSize());
       _bufferSizeDefined = true;
     }
-    unsigned long start = _featureIndex;
-    if (featureCount-_featureIndex < _pBuffer->size()/getVectSize())
-    {
-      unsigned long x = _pBuffer->size()/getVectSize() -
-                        (featureCount-_featureIndex);
-      if (x < _featureIndex)
-        start -= x;
-      else
-        start = 0;
-    }
+    unsigned long start = getBufferStart(_featureIndex, featureCount);
+    // sauf si le bloc a deja ete lu par le thread de lecture anticipee,
     // si le bloc de donnees a charger ne suit pas le bloc deja en memoire
     // on se repositionne dans le fichier
-    if (start != _featureIndexOfBuffer + _nbStored /*+ 1*/) {
-      if (_pReader != NULL) {
-        _pReader->seek(getHeaderLength() + start*getVectSize()*sizeof(float));
-      }
-      else {
-        _pFeatureInputStream->seekFeature(start);
-      }
-    }
-    // chargement des donnees dans le buffer
-    if (_pReader != NULL)
-      _nbStored = _pReader->readSomeFloats(*_pBuffer)/getVectSize();
-    else
-    {
-      // Pas performant. A améliorer
-      _nbStored = 0;
-      unsigned long vectSize = _pFeatureInputStream->getVectSize();
-      while ((_nbStored+1)*vectSize <= _pBuffer->size()
-              && _pFeatureInputStream->readFeature(_f))
-      {
-        unsigned long ii = _nbStored*vectSize;
-        for (unsigned long j=0; j<vectSize; j++)
-          (*_pBuffer)[ii+j] = (float) _f[j];
-        _nbStored++;
-      }
-    }
+    if (!useReadAhead(start))
+      _nbStored = loadFrames(*_pBuffer, start);
 
     _featureIndexOfBuffer = start;
+    _labelCodeDefined = false;
     // if all the features are loaded in the buffer, we close the file
     if (_nbStored == featureCount)
       close();
     else
+    {
       // données pas toutes en mémoire -> interdit le writeFeature()
       _featuresAreWritable = false;
+      startReadAhead(featureCount);
+    }
+  }
+  if (!_mappingWanted)
+  {
+    f.setVectSize(K::k, getVectSize());
+    f.setData(*_pBuffer, (_featureIndex-_featureIndexOfBuffer)*getVectSize());
   }
-  f.setVectSize(K::k, getVectSize());
-  f.setData(*_pBuffer, (_featureIndex-_featureIndexOfBuffer)*getVectSize());
   f.setValidity(true);
 
   _featureIndex += step;
@@ -221,17 +356,183 @@ bool R::readFeature(Feature& f, unsigned long step)
     _lastFeatureIndex = _featureIndex;
   if (_pLabelServer != NULL)
   {
-    Label l;
-    if (_pReader != NULL)
-      l.setSourceName(_pReader->getFileName());
-    else
-      l.setSourceName(_pFeatureInputStream->getNameOfASource(0)); // TODO : not always 0 ?
-    f.setLabelCode(_pLabelServer->addLabel(l));
+    // the label is searched once for the frames of a buffer, and again
+    // if the labels of the server have been replaced or deleted
+    if (!_labelCodeDefined
+        || _labelServerRevision != _pLabelServer->getRevision())
+    {
+      Label l;
+      if (_pReader != NULL)
+        l.setSourceName(_pReader->getFileName());
+      else
+        l.setSourceName(_pFeatureInputStream->getNameOfASource(0)); // TODO : not always 0 ?
+      _labelCode = _pLabelServer->addLabel(l);
+      _labelCodeDefined = true;
+      _labelServerRevision = _pLabelServer->getRevision();
+    }
+    f.setLabelCode(_labelCode);
   }
   _error = NO_ERROR;
   return true;
 }
 //-------------------------------------------------------------------------
+// Index of the first feature of the block loaded to read a feature : the
+// block ends at the end of the file if possible, to fill the buffer
+//-------------------------------------------------------------------------
+unsigned long R::getBufferStart(unsigned long featureIndex,
+                                unsigned long featureCount) // private
+{
+  const unsigned long bufferFeatureCount = _pBuffer->size()/getVectSize();
+  if (featureCount-featureIndex >= bufferFeatureCount)
+    return featureIndex;
+  const unsigned long x = bufferFeatureCount - (featureCount-featureIndex);
+  return x < featureIndex ? featureIndex-x : 0;
+}
+//-------------------------------------------------------------------------
+// Uses the block read ahead if it starts at 'start'. Otherwise the block
+// is dropped (loadFrames() seeks again from where the thread stopped).
+//-------------------------------------------------------------------------
+bool R::useReadAhead(unsigned long start) // private
+{
+  if (_pReadAhead == NULL || !_pReadAhead->requested)
+    return false;
+  waitReadAhead();
+  if (_pReadAhead->start != start)
+    return false;
+  _pBuffer->swap(*_pReadAhead->pBuffer); // the buffer may be external
+  _nbStored = _pReadAhead->count;
+  return true;
+}
+//-------------------------------------------------------------------------
+// Requests the block which follows the buffer
+//-------------------------------------------------------------------------
+void R::startReadAhead(unsigned long featureCount) // private
+{
+  if (!_readAheadWanted)
+    return;
+  const unsigned long next = _featureIndexOfBuffer + _nbStored;
+  if (next >= featureCount)
+    return;
+  if (_pReadAhead == NULL)
+  {
+    _pReadAhead = new (std::nothrow) ReadAhead(*this);
+    assertMemoryIsAllocated(_pReadAhead, __FILE__, __LINE__);
+  }
+  _pReadAhead->pBuffer->setSize(_pBuffer->size());
+  _pReadAhead->request(getBufferStart(next, featureCount));
+}
+//-------------------------------------------------------------------------
+void R::waitReadAhead() // private
+{
+  if (_pReadAhead != NULL && _pReadAhead->requested)
+    _pReadAhead->wait();
+}
+//-------------------------------------------------------------------------
+unsigned long R::readFeatures(FeatureBlock& b, unsigned long maxFrames)
+{
+  const unsigned long vectSize = getVectSize();
+  // the first feature is read as usual (seek, loading of the buffer or
+  // mapping of the file, label)
+  if (maxFrames == 0 || !readFeature(_f) || !_f.isValid())
+  {
+    b.setDimensions(0, vectSize);
+    return 0;
+  }
+  unsigned long first = _featureIndex-1;
+  const unsigned long end = _mappingWanted ? getFeatureCount()
+                            : _featureIndexOfBuffer + _nbStored;
+  unsigned long n = end-first < maxFrames ? end-first : maxFrames;
+  if (_mappingWanted)
+  {
+    const char* p = _pMappedFile->getData() + getHeaderLength()
+                    + first*vectSize*sizeof(float);
+    if (!_pReader->swap() && (size_t)p % sizeof(float) == 0)
+      b.setAlias(reinterpret_cast<const float*>(p), n, vectSize);
+    else
+    {
+      b.setDimensions(n, vectSize);
+      char* q = reinterpret_cast<char*>(b.getWritableArray());
+      memcpy(q, p, n*vectSize*sizeof(float));
+      if (_pReader->swap())
+        for (unsigned long i=0; i<n*vectSize; i++, q+=4)
+          _pReader->swap4Bytes(q);
+    }
+  }
+  else if (n == maxFrames || end == getFeatureCount())
+    b.setAlias(_pBuffer->getArray() + (first-_featureIndexOfBuffer)
+               *vectSize, n, vectSize);
+  else
+  {
+    // the buffer is smaller than the block : the frames are copied
+    b.setDimensions(maxFrames, vectSize);
+    float* q = b.getWritableArray();
+    unsigned long count = 0, i = first, k = n;
+    for (;;)
+    {
+      memcpy(q+count*vectSize, _pBuffer->getArray()
+             + (i-_featureIndexOfBuffer)*vectSize, k*vectSize*sizeof(float));
+      count += k;
+      _featureIndex = i + k;
+      if (count == maxFrames || !readFeature(_f) || !_f.isValid())
+        break;
+      i = _featureIndex-1;
+      k = _featureIndexOfBuffer + _nbStored - i;
+      if (k > maxFrames-count)
+        k = maxFrames-count;
+    }
+    b.setDimensions(count, vectSize);
+    n = count;
+    first = _featureIndex - n;
+  }
+  _featureIndex = first + n;
+  if (_featureIndex > _lastFeatureIndex)
+    _lastFeatureIndex = _featureIndex;
+  return n;
+}
+//-------------------------------------------------------------------------
+void R::mapFile() // private
+{
+  assert(_pReader != NULL);
+  const unsigned long headerLength = getHeaderLength(); // reads the header
+  const unsigned long dataLength = getFeatureCount()*getVectSize()
+                                   *sizeof(float);
+  _pMappedFile = new (std::nothrow) MappedFile(_pReader->getFullFileName());
+  assertMemoryIsAllocated(_pMappedFile, __FILE__, __LINE__);
+  if (_pMappedFile->getLength() < headerLength + dataLength)
+  {
+    delete _pMappedFile;
+    _pMappedFile = NULL;
+    throw InvalidDataException("Wrong number of data", __FILE__, __LINE__,
+                               _pReader->getFullFileName());
+  }
+  _pReader->close(); // the file is not read any more
+}
+//-------------------------------------------------------------------------
+// Sets the feature _featureIndex from the mapped file
+//-------------------------------------------------------------------------
+void R::setMappedData(Feature& f) // private
+{
+  if (_pMappedFile == NULL)
+    mapFile();
+  const unsigned long vectSize = getVectSize();
+  const char* p = _pMappedFile->getData() + getHeaderLength()
+                  + _featureIndex*vectSize*sizeof(float);
+  f.setVectSize(K::k, vectSize);
+  if (!_pReader->swap() && (size_t)p % sizeof(float) == 0)
+  {
+    f.setData(reinterpret_cast<const float*>(p));
+    return;
+  }
+  // big endian file or unaligned frame (header with an odd length)
+  _frameVect.setSize(vectSize);
+  char* q = reinterpret_cast<char*>(_frameVect.getArray());
+  memcpy(q, p, vectSize*sizeof(float));
+  if (_pReader->swap())
+    for (unsigned long i=0; i<vectSize; i++, q+=4)
+      _pReader->swap4Bytes(q);
+  f.setData(_frameVect.getArray());
+}
+//-------------------------------------------------------------------------
 bool R::addFeature(const Feature& f) {
 	/* if not yet read --> not charged in memory */
 	if (_nbStored == 0) {
@@ -258,7 +559,7 @@ bool R::addFeature(const Feature& f) {
 //-------------------------------------------------------------------------
 bool R::writeFeature(const Feature& f, unsigned long step)
 {
-  if (!_featuresAreWritable)
+  if (!_featuresAreWritable || _mappingWanted)
     throw Exception("Feature writing forbidden", __FILE__, __LINE__);
   assert(_pReader != NULL || _pFeatureInputStream != NULL);
   if (_seekWanted)
@@ -310,33 +611,7 @@ bool R::writeFeature(const Feature& f, unsigned long step)
       else
         start = 0;
     }
-    // si le bloc de donnees a charger ne suit pas le bloc deja en memoire
-    // on se repositionne dans le fichier
-    if (start != _featureIndexOfBuffer + _nbStored + 1) {
-      if (_pReader != NULL) {
-        _pReader->seek(getHeaderLength() + start*getVectSize()*sizeof(float));
-      }
-      else {
-        _pFeatureInputStream->seekFeature(start);
-      }
-    }
-    // chargement des donnees dans le buffer
-    if (_pReader != NULL)
-      _nbStored = _pReader->readSomeFloats(*_pBuffer)/getVectSize();
-    else
-    {
-      // Pas performant. A améliorer
-      _nbStored = 0;
-      unsigned long vectSize = _pFeatureInputStream->getVectSize();
-      while ((_nbStored+1)*vectSize <= _pBuffer->size()
-              && _pFeatureInputStream->readFeature(_f))
-      {
-        unsigned long ii = _nbStored*vectSize;
-        for (unsigned long j=0; j<vectSize; j++)
-          (*_pBuffer)[ii+j] = (float) _f[j];
-        _nbStored++;
-      }
-    }
+    _nbStored = loadFrames(*_pBuffer, start);
 
     _featureIndexOfBuffer = start;
     // if all the features are loaded in the buffer, we close the file
@@ -371,6 +646,7 @@ bool R::featureWantedIsInHistoric() const
 //-------------------------------------------------------------------------
 void R::setExternalBufferToUse(FloatVector& v)
 {
+  stopReadAhead();
   if (_bufferIsInternal && _pBuffer != NULL )
     delete _pBuffer;
   _pBuffer = &v;
@@ -464,6 +740,9 @@ string R::toString() const
 //-------------------------------------------------------------------------
 R::~FeatureFileReaderSingle()
 {
+  stopReadAhead(); // already stopped by the destructor of the subclass
+  if (_pMappedFile != NULL)
+    delete _pMappedFile;
   if (_pReader != NULL)
     delete _pReader;
   // do not delete _pFeatureInputStream
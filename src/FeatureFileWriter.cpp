@@ -57,6 +57,8 @@
 
 #include <new>
 #include "FeatureFileWriter.h"
+#include "FeatureCodec.h"
+#include "FeatureFlags.h"
 #include "Feature.h"
 #include "Exception.h"
 #include "Config.h"
@@ -70,7 +72,7 @@ typedef FeatureFileWriter W;
 W::FeatureFileWriter(const FileName& f, const Config& c)
 :FileWriter(getFullFileName(c, f)),
  _format(c.getParam_saveFeatureFileFormat()), _vectSizeDefined(false),
- _headerWritten(false), _config(c) {}
+ _headerWritten(false), _config(c), _bits(16), _blockFrameCount(0) {}
 //-------------------------------------------------------------------------
 W& W::create(const FileName& f, const Config& c)
 {
@@ -173,10 +175,68 @@ void W::writeFeature(const Feature& f)
     for (unsigned long i=0; i<_vectSize; i++)
     { writeFloat((float)f[i]); }
   }
+  else if (_format == FeatureFileWriterFormat_COMPRESSED) // **************************************
+  {
+    if (!_headerWritten)
+    {
+      _bits = 16;
+      if (_config.existsParam("saveFeatureFileCompressionBits"))
+        _bits = (unsigned long)_config.getIntegerParam(
+                                     "saveFeatureFileCompressionBits");
+      _featureCount = 0;
+      writeCompressedHeader(0); // rewritten by close()
+      _frames.setSize(FeatureCodec::BLOCK_FRAME_COUNT*_vectSize);
+      _blockFrameCount = 0;
+      _blockOffsets.clear();
+      _headerWritten = true;
+    }
+    float* p = _frames.getArray() + _blockFrameCount*_vectSize;
+    for (unsigned long i=0; i<_vectSize; i++)
+      p[i] = (float)f[i];
+    _featureCount++;
+    if (++_blockFrameCount == FeatureCodec::BLOCK_FRAME_COUNT)
+      writeBlock();
+  }
   else
      ;
 }
 //-------------------------------------------------------------------------
+void W::writeBlock() // private
+{
+  if (_blockFrameCount == 0)
+    return;
+  const unsigned long size = FeatureCodec::getBlockSize(_blockFrameCount,
+                                                        _vectSize, _bits);
+  _block.setSize(size/sizeof(float));
+  char* p = reinterpret_cast<char*>(_block.getArray());
+  FeatureCodec::encodeBlock(_frames.getArray(), _blockFrameCount,
+                            _vectSize, _bits, p);
+  _blockOffsets.addValue(tell());
+  writeBytes(p, size);
+  _blockFrameCount = 0;
+}
+//-------------------------------------------------------------------------
+uint64_t W::tell() // private
+{
+  const long long pos = ALIZE_FTELL64(_pFileStruct);
+  if (pos < 0)
+    throw IOException("ftell", __FILE__, __LINE__, _fileName);
+  return (uint64_t)pos;
+}
+//-------------------------------------------------------------------------
+// The feature count and the position of the index are known after the
+// last block only
+//-------------------------------------------------------------------------
+void W::writeCompressedHeader(uint64_t indexOffset) // private
+{
+  FeatureCodec::FileHeader h;
+  FeatureCodec::initHeader(h, _vectSize, _bits,
+               _config.getParam_featureFlags(), _config.getParam_sampleRate());
+  h.featureCount = _featureCount;
+  h.indexOffset = indexOffset;
+  writeBytes(&h, sizeof(h));
+}
+//-------------------------------------------------------------------------
 void W::close()
 {
   if (_format == FeatureFileWriterFormat_SPRO3 && isOpen() && _headerWritten)
@@ -186,6 +246,18 @@ void W::close()
       throw IOException("", __FILE__, __LINE__, _fileName);
     writeUInt4(_featureCount);
   }
+  if (_format == FeatureFileWriterFormat_COMPRESSED && isOpen()
+      && _headerWritten)
+  {
+    writeBlock(); // last block
+    const uint64_t indexOffset = tell();
+    writeBytes(_blockOffsets.getArray(),
+               _blockOffsets.size()*sizeof(uint64_t));
+    if (::fseek(_pFileStruct, 0, SEEK_SET) != 0) // if error
+      throw IOException("", __FILE__, __LINE__, _fileName);
+    writeCompressedHeader(indexOffset);
+    _headerWritten = false;
+  }
   FileWriter::close();
 }
 //-------------------------------------------------------------------------
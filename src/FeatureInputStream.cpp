@@ -58,6 +58,7 @@
 #include "FeatureInputStream.h"
 #include "Exception.h"
 #include "Feature.h"
+#include "FeatureBlock.h"
 #include "LabelServer.h"
 #include "Config.h"
 
@@ -97,6 +98,22 @@ S::Error FeatureInputStream::getError() { return _error; }
 bool FeatureInputStream::writeFeature(const Feature& f, unsigned long step)
 { throw Exception("Feature writing forbidden", __FILE__, __LINE__); }
 //-------------------------------------------------------------------------
+unsigned long S::readFeatures(FeatureBlock& b, unsigned long maxFrames)
+{
+  const unsigned long vectSize = getVectSize();
+  Feature f(vectSize);
+  unsigned long n = 0;
+  b.setDimensions(maxFrames, vectSize);
+  while (n < maxFrames && readFeature(f))
+  {
+    if (!f.isValid())
+      break;
+    b.setFrame(n++, f);
+  }
+  b.setDimensions(n, vectSize);
+  return n;
+}
+//-------------------------------------------------------------------------
 S::~FeatureInputStream() {}
 //-------------------------------------------------------------------------
 
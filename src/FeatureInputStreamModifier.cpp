@@ -173,6 +173,27 @@ bool M::readFeature(Feature& f, unsigned long step)
   return ok;
 }
 //-------------------------------------------------------------------------
+unsigned long M::readFeatures(FeatureBlock& b, unsigned long maxFrames)
+{
+  unsigned long n;
+  if (!_useMask)
+    n = _pInput->readFeatures(b, maxFrames);
+  else
+  {
+    n = _pInput->readFeatures(_block, maxFrames);
+    const unsigned long inputVectSize = _block.getVectSize();
+    b.setDimensions(n, _selectionSize);
+    const float* p = _block.getArray();
+    float* q = b.getWritableArray();
+    const unsigned long* selection = _selection.getArray();
+    for (unsigned long t=0; t<n; t++, p+=inputVectSize, q+=_selectionSize)
+      for (unsigned long i=0; i<_selectionSize; i++)
+        q[i] = p[selection[i]];
+  }
+  _error = _pInput->getError();
+  return n;
+}
+//-------------------------------------------------------------------------
 bool M::addFeature(const Feature& f)
 {
   bool ok;
@@ -58,6 +58,7 @@
 #include <new>
 #include "FeatureMultipleFileReader.h"
 #include "Feature.h"
+#include "FeatureBlock.h"
 #include "Exception.h"
 #include "FeatureFlags.h"
 #include "LabelServer.h"
@@ -107,7 +108,18 @@ R& R::create(const XLine& list, const Config& c,
   return *p;
 }
 //-------------------------------------------------------------------------
-bool R::readFeature(Feature& f, unsigned long s) { return rw(true, f, s); }
+bool R::readFeature(Feature& f, unsigned long s)
+{ return rw(true, &f, NULL, s); }
+//-------------------------------------------------------------------------
+unsigned long R::readFeatures(FeatureBlock& b, unsigned long maxFrames)
+{
+  if (maxFrames == 0 || !rw(true, NULL, &b, maxFrames))
+  {
+    b.setDimensions(0, b.getVectSize());
+    return 0;
+  }
+  return b.getFrameCount();
+}
 //-------------------------------------------------------------------------
 bool R::addFeature(const Feature& f) { throw Exception ("featureMultipleFileReader::addFeature not yet implemented", __FILE__, __LINE__); }
 //-------------------------------------------------------------------------
@@ -132,10 +144,14 @@ bool R::writeFeature(const Feature& f, unsigned long step)
   if (!_featuresAreWritable)
     throw Exception("Feature writing forbidden", __FILE__, __LINE__);
 
-  return rw(false, const_cast<Feature&>(f), step);
+  return rw(false, const_cast<Feature*>(&f), NULL, step);
 }
 //-------------------------------------------------------------------------
-bool R::rw(bool read, Feature& f, unsigned long s) // private
+// Reads or writes one feature, or reads a block of at most s features
+// if pBlock is not NULL
+//-------------------------------------------------------------------------
+bool R::rw(bool read, Feature* pFeature, FeatureBlock* pBlock,
+           unsigned long s) // private
 {
   // _fileCounter = n° du PROCHAIN fichier à lire
   unsigned long featureNbr = 0;
@@ -171,9 +187,11 @@ bool R::rw(bool read, Feature& f, unsigned long s) // private
       {
         if (!read) // if write
           throw Exception("Feature out of historic", __FILE__, __LINE__);
-        f.setVectSize(K::k, getVectSize());
-        f.setValidity(false);
         _error = FEATURE_OUT_OF_HISTORY;
+        if (pBlock != NULL)
+          return false;
+        pFeature->setVectSize(K::k, getVectSize());
+        pFeature->setValidity(false);
         return true;
       }
       if (featureNbrGlobal > futureLastFeatureIndex)
@@ -196,16 +214,22 @@ bool R::rw(bool read, Feature& f, unsigned long s) // private
       seekWantedInCurrentFile = false;
     }
     bool ok;
-    if (read)
-      ok = r.readFeature(f, s);
+    if (pBlock != NULL)
+      ok = r.readFeatures(*pBlock, s) != 0;
+    else if (read)
+      ok = r.readFeature(*pFeature, s);
     else
-      ok = r.writeFeature(f, s);
+      ok = r.writeFeature(*pFeature, s);
     _error = r.getError();
     if (ok)
     {
       _lastFeatureIndex = futureLastFeatureIndex;
+      if (pBlock != NULL)
+        _lastFeatureIndex += pBlock->getFrameCount()-1;
       return true;
     }
+    if (pBlock != NULL && _error != NO_ERROR) // invalid first feature
+      return false;
     _fileCounter++;
     featureNbr = 0;
     seekWantedInCurrentFile = true;
@@ -58,6 +58,7 @@
 #include <new>
 #include "FeatureServer.h"
 #include "Feature.h"
+#include "FeatureBlock.h"
 
 #include "FeatureFileReader.h"
 #include "FeatureInputStreamModifier.h"
@@ -253,6 +254,18 @@ bool S::readFeature(Feature& f, unsigned long step)
   return ok;
 }
 //-------------------------------------------------------------------------
+unsigned long S::readFeatures(FeatureBlock& b, unsigned long maxFrames)
+{
+  if (_pInputStream == NULL)
+  {
+    b.setDimensions(0, b.getVectSize());
+    return 0;
+  }
+  unsigned long n = inputStream().readFeatures(b, maxFrames);
+  _error = inputStream().getError();
+  return n;
+}
+//-------------------------------------------------------------------------
 bool S::addFeature(const Feature& f)
 {
   if (_pInputStream == NULL)
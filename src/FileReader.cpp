@@ -114,17 +114,17 @@ const FileName& R::getFullFileName() const { return _fullFileName; }
 //-------------------------------------------------------------------------
 const FileName& R::getFileName() const { return _fileName; }
 //-------------------------------------------------------------------------
-unsigned long R::getFileLength()
+unsigned long long R::getFileLength()
 {
   if (!_fileLengthDefined)
   {
     bool wasOpened = isOpen();
-    long pos;
-    long l;
+    long long pos;
+    long long l;
 
     if (wasOpened)
     {
-      if ( (pos = ::ftell(_pFileStruct)) < 0)
+      if ( (pos = ALIZE_FTELL64(_pFileStruct)) < 0)
         throw IOException("ftell", __FILE__, __LINE__, _fullFileName);
     }
     else
@@ -132,23 +132,23 @@ unsigned long R::getFileLength()
       open();
       pos = 0;
     }
-    if (::fseek(_pFileStruct, 0, SEEK_END) != 0)
+    if (ALIZE_FSEEK64(_pFileStruct, 0, SEEK_END) != 0)
       throw IOException("fseek", __FILE__, __LINE__, _fullFileName);
-    if ( (l = ::ftell(_pFileStruct)) < 0)
+    if ( (l = ALIZE_FTELL64(_pFileStruct)) < 0)
       throw IOException("ftell", __FILE__, __LINE__, _fullFileName);
     _fileLengthDefined = true;
     _fileLength = l;
-    if (::fseek(_pFileStruct, pos, SEEK_SET) != 0)
+    if (ALIZE_FSEEK64(_pFileStruct, pos, SEEK_SET) != 0)
       throw IOException("fseek", __FILE__, __LINE__, _fullFileName);
   }
   return _fileLength;
 }
 //-------------------------------------------------------------------------
-void R::seek(unsigned long pos) // protected
+void R::seek(unsigned long long pos) // protected
 {
   if (!isOpen())
     open();
-  if (::fseek(_pFileStruct, pos, SEEK_SET) != 0 )
+  if (ALIZE_FSEEK64(_pFileStruct, (long long)pos, SEEK_SET) != 0 )
     throw IOException("seek out of bounds",
           __FILE__, __LINE__, _fullFileName);
 }
@@ -169,6 +169,9 @@ void R::read(void* buffer, unsigned long length) // private
   throw IOException("Cannot read file", __FILE__, __LINE__, _fullFileName);
 }
 //-------------------------------------------------------------------------
+void R::readBytes(void* buffer, unsigned long length)
+{ read(buffer, length); }
+//-------------------------------------------------------------------------
 char R::readChar()
 {
   char byte;
@@ -155,6 +155,16 @@ void FileWriter::writeString(const string& string)
                _fileName);
 }
 //-------------------------------------------------------------------------
+void FileWriter::writeBytes(const void* buffer, unsigned long length)
+{
+  if (length == 0)
+    return;
+  assert(_pFileStruct != NULL);
+  if (::fwrite(buffer, length, 1, _pFileStruct) != 1)
+    throw IOException("Cannot write in file", __FILE__, __LINE__,
+               _fileName);
+}
+//-------------------------------------------------------------------------
 void FileWriter::writeAttribute(const string& name, const string& value)
 {
   //assert(false); // transformer les < > &... idem pour FileReader
@@ -0,0 +1,322 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_GDAccumulator_cpp)
+#define ALIZE_GDAccumulator_cpp
+
+#include <cstring>
+#include "GDAccumulator.h"
+#include "GDKernel.h"
+#include "MixtureGDPacked.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef GDAccumulator A;
+
+//-------------------------------------------------------------------------
+A::GDAccumulator(unsigned long distribCount, unsigned long vectSize)
+:Object(), _distribCount(0), _vectSize(0), _stride(0), _capacity(0),
+ _zeroCapacity(0), _zeroArray(NULL), _firstArray(NULL), _secondArray(NULL),
+ _featureCount(0.0), _exact(false), _synchronized(true)
+{
+  setDimensions(distribCount, vectSize);
+}
+//-------------------------------------------------------------------------
+void A::setDimensions(unsigned long distribCount, unsigned long vectSize)
+{
+  // rows aligned like the arrays of MixtureGDPacked
+  const unsigned long align = MixtureGDPacked::ALIGNMENT/sizeof(real_t);
+  const unsigned long stride = (vectSize+align-1)/align*align;
+  if (distribCount*stride > _capacity || _firstArray == NULL)
+  {
+    if (_firstArray != NULL)
+    {
+      GDKernel::deleteAlignedArray(_firstArray);
+      GDKernel::deleteAlignedArray(_secondArray);
+    }
+    _capacity = distribCount*stride;
+    _firstArray = GDKernel::createAlignedArray(_capacity);
+    _secondArray = GDKernel::createAlignedArray(_capacity);
+  }
+  if (distribCount > _zeroCapacity || _zeroArray == NULL)
+  {
+    if (_zeroArray != NULL)
+      GDKernel::deleteAlignedArray(_zeroArray);
+    _zeroCapacity = distribCount;
+    _zeroArray = GDKernel::createAlignedArray(_zeroCapacity);
+  }
+  _distribCount = distribCount;
+  _vectSize = vectSize;
+  _stride = stride;
+  _exactAcc.setSize(_exact ? distribCount*(2*vectSize+1)+1 : 0);
+  reset();
+}
+//-------------------------------------------------------------------------
+void A::reset()
+{
+  memset(_zeroArray, 0, _distribCount*sizeof(occ_t));
+  memset(_firstArray, 0, _distribCount*_stride*sizeof(real_t));
+  memset(_secondArray, 0, _distribCount*_stride*sizeof(real_t));
+  _featureCount = 0.0;
+  _exactAcc.reset();
+  _synchronized = true;
+}
+//-------------------------------------------------------------------------
+void A::setExact(bool exact)
+{
+  _exact = exact;
+  setDimensions(_distribCount, _vectSize);
+}
+//-------------------------------------------------------------------------
+bool A::isExact() const { return _exact; }
+//-------------------------------------------------------------------------
+// F : type of the frame (real_t or float)
+//-------------------------------------------------------------------------
+template <class F> static void accumulateFrame(occ_t occ, const F* x,
+                 unsigned long vectSize, real_t* first, real_t* second)
+{
+  for (unsigned long i=0; i<vectSize; i++)
+  {
+    const real_t xi = x[i];
+    const real_t t = occ * xi;
+    second[i] += t * xi;
+    first[i]  += t;
+  }
+}
+//-------------------------------------------------------------------------
+void A::accumulate(unsigned long c, occ_t occ, const real_t* x)
+{
+  assertIsInBounds(__FILE__, __LINE__, c, _distribCount);
+  if (_exact)
+  {
+    // same products as accumulateFrame()
+    _exactAcc.addMoments(c*(2*_vectSize+1), &occ, x, _vectSize, 1);
+    _synchronized = false;
+    return;
+  }
+  accumulateFrame(occ, x, _vectSize, _firstArray + c*_stride,
+                  _secondArray + c*_stride);
+  _zeroArray[c] += occ;
+}
+//-------------------------------------------------------------------------
+void A::accumulate(unsigned long c, occ_t occ, const float* x)
+{
+  assertIsInBounds(__FILE__, __LINE__, c, _distribCount);
+  if (_exact)
+  {
+    // same products as accumulateFrame()
+    _exactAcc.addMoments(c*(2*_vectSize+1), &occ, x, _vectSize, 1);
+    _synchronized = false;
+    return;
+  }
+  accumulateFrame(occ, x, _vectSize, _firstArray + c*_stride,
+                  _secondArray + c*_stride);
+  _zeroArray[c] += occ;
+}
+//-------------------------------------------------------------------------
+void A::accumulate(unsigned long c, const occ_t* occ, const float* x,
+                   unsigned long frameCount)
+{
+  assertIsInBounds(__FILE__, __LINE__, c, _distribCount);
+  if (_exact)
+  {
+    _exactAcc.addMoments(c*(2*_vectSize+1), occ, x, _vectSize, frameCount);
+    _synchronized = false;
+    return;
+  }
+  real_t* first = _firstArray + c*_stride;
+  real_t* second = _secondArray + c*_stride;
+  for (unsigned long n=0; n<frameCount; n++, x+=_vectSize)
+  {
+    accumulateFrame(occ[n], x, _vectSize, first, second);
+    _zeroArray[c] += occ[n];
+  }
+}
+//-------------------------------------------------------------------------
+void A::add(const GDAccumulator& a)
+{
+  if (a._distribCount != _distribCount || a._vectSize != _vectSize
+      || a._exact != _exact)
+    throw Exception("GDAccumulator incompatibility", __FILE__, __LINE__);
+  if (_exact)
+  {
+    _exactAcc.add(a._exactAcc);
+    _synchronized = false;
+    return;
+  }
+  const unsigned long n = _distribCount*_stride;
+  unsigned long i;
+  for (i=0; i<_distribCount; i++)
+    _zeroArray[i] += a._zeroArray[i];
+  for (i=0; i<n; i++)
+  {
+    _firstArray[i] += a._firstArray[i];
+    _secondArray[i] += a._secondArray[i];
+  }
+  _featureCount += a._featureCount;
+}
+//-------------------------------------------------------------------------
+void A::synchronize() const // private
+{
+  if (_synchronized)
+    return;
+  const unsigned long k = 2*_vectSize+1;
+  for (unsigned long c=0; c<_distribCount; c++)
+  {
+    real_t* first = _firstArray + c*_stride;
+    real_t* second = _secondArray + c*_stride;
+    _zeroArray[c] = _exactAcc.getValue(c*k);
+    for (unsigned long i=0; i<_vectSize; i++)
+    {
+      first[i] = _exactAcc.getValue(c*k+1+i);
+      second[i] = _exactAcc.getValue(c*k+1+_vectSize+i);
+    }
+  }
+  _synchronized = true;
+}
+//-------------------------------------------------------------------------
+occ_t* A::getZeroOrderArray() { synchronize(); return _zeroArray; }
+//-------------------------------------------------------------------------
+const occ_t* A::getZeroOrderArray() const
+{ synchronize(); return _zeroArray; }
+//-------------------------------------------------------------------------
+real_t* A::getFirstOrderArray() { synchronize(); return _firstArray; }
+//-------------------------------------------------------------------------
+const real_t* A::getFirstOrderArray() const
+{ synchronize(); return _firstArray; }
+//-------------------------------------------------------------------------
+real_t* A::getSecondOrderArray() { synchronize(); return _secondArray; }
+//-------------------------------------------------------------------------
+const real_t* A::getSecondOrderArray() const
+{ synchronize(); return _secondArray; }
+//-------------------------------------------------------------------------
+const real_t* A::getFirstOrder(unsigned long c) const
+{
+  assertIsInBounds(__FILE__, __LINE__, c, _distribCount);
+  synchronize();
+  return _firstArray + c*_stride;
+}
+//-------------------------------------------------------------------------
+const real_t* A::getSecondOrder(unsigned long c) const
+{
+  assertIsInBounds(__FILE__, __LINE__, c, _distribCount);
+  synchronize();
+  return _secondArray + c*_stride;
+}
+//-------------------------------------------------------------------------
+real_t A::getFeatureCount() const
+{
+  if (_exact)
+    return _exactAcc.getValue(_exactAcc.getSize()-1);
+  return _featureCount;
+}
+//-------------------------------------------------------------------------
+void A::addFeatureCount(real_t w)
+{
+  if (_exact)
+    _exactAcc.add(_exactAcc.getSize()-1, w);
+  else
+    _featureCount += w;
+}
+//-------------------------------------------------------------------------
+void A::setFeatureCount(real_t n)
+{
+  if (_exact)
+    throw Exception("Cannot set the frame count in exact mode",
+                    __FILE__, __LINE__);
+  _featureCount = n;
+}
+//-------------------------------------------------------------------------
+unsigned long A::getExactStateSize() const
+{ return _exactAcc.getSize()*ExactAccumulator::LIMB_COUNT; }
+//-------------------------------------------------------------------------
+void A::writeExactState(double* p) const { _exactAcc.write(p); }
+//-------------------------------------------------------------------------
+void A::readExactState(const double* p)
+{
+  _exactAcc.read(p);
+  _synchronized = false;
+}
+//-------------------------------------------------------------------------
+unsigned long A::getDistribCount() const { return _distribCount; }
+//-------------------------------------------------------------------------
+unsigned long A::getVectSize() const { return _vectSize; }
+//-------------------------------------------------------------------------
+unsigned long A::getStride() const { return _stride; }
+//-------------------------------------------------------------------------
+string A::getClassName() const { return "GDAccumulator"; }
+//-------------------------------------------------------------------------
+string A::toString() const
+{
+  return Object::toString()
+    + "\n  distribCount = " + std::to_string(_distribCount)
+    + "\n  vectSize     = " + std::to_string(_vectSize)
+    + "\n  featureCount = " + std::to_string(getFeatureCount())
+    + "\n  exact        = " + (_exact ? "true" : "false");
+}
+//-------------------------------------------------------------------------
+A::~GDAccumulator()
+{
+  if (_zeroArray != NULL)
+    GDKernel::deleteAlignedArray(_zeroArray);
+  if (_firstArray != NULL)
+  {
+    GDKernel::deleteAlignedArray(_firstArray);
+    GDKernel::deleteAlignedArray(_secondArray);
+  }
+}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_GDAccumulator_cpp)
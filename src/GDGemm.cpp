@@ -0,0 +1,434 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_GDGemm_cpp)
+#define ALIZE_GDGemm_cpp
+
+#if defined(_WIN32)
+  #include <cfloat> // for _isnan()
+  #define ISNAN(x) _isnan(x)
+#elif defined(linux) || defined(__linux) || defined(__CYGWIN__) || defined(__APPLE__)
+  #define ISNAN(x) isnan(x)
+#else
+  #error "Unsupported OS\n"
+#endif
+
+// see GDKernel.cpp
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+  #define ALIZE_GDGEMM_X86
+  #define ALIZE_GDGEMM_AVX
+  #define TARGET_SSE2   __attribute__((target("sse2")))
+  #define TARGET_AVX2   __attribute__((target("avx2,fma")))
+  #define TARGET_AVX512 __attribute__((target("avx512f")))
+  #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+  #define ALIZE_GDGEMM_X86
+  #define TARGET_SSE2
+  #include <emmintrin.h>
+#endif
+
+#if defined(ALIZE_USE_BLAS)
+  #include <cblas.h>
+#endif
+
+#include <cmath>
+#include "GDGemm.h"
+#include "GDKernel.h"
+#include "MixtureGDPacked.h"
+
+using namespace alize;
+using namespace std;
+
+//-------------------------------------------------------------------------
+// Blocking of the product C = A x B
+// > B is copied by blocks of KC rows x NC columns (L2 cache), cut into
+//   panels of NR columns stored contiguously (L1 cache)
+// > each micro-kernel computes a tile of MR rows x NR columns of C in
+//   registers, reading one row of a panel for each k
+//-------------------------------------------------------------------------
+static const unsigned long MR_MAX = 8;
+static const unsigned long KC = 256;
+static const unsigned long NC = 512;
+static const unsigned long MC = 128;
+static const unsigned long NR_MAX = 16;
+// frames scored by a single product in computeWeightedLogLK()
+static const unsigned long FRAME_BLOCK = 256;
+
+static const double LOG_EPS_LK = -460.51701859880913680; // log(EPS_LK)
+
+typedef void (*MicroKernel)(unsigned long kc, const real_t* const* a,
+                   const real_t* b, real_t* c, unsigned long ldc, bool add);
+
+//-------------------------------------------------------------------------
+// Micro-kernels : a[r] points on the kc values of the row r of A, b on the
+// panel (kc x NR), c on the tile of C. If add is true, the product is
+// added to C (second and next blocks of KC rows)
+//-------------------------------------------------------------------------
+static void microScalar(unsigned long kc, const real_t* const* a,
+                   const real_t* b, real_t* c, unsigned long ldc, bool add)
+{
+  const unsigned long MR = 4, NR = 4;
+  real_t acc[MR][NR] = {{0.0}};
+  unsigned long k, r, j;
+  for (k=0; k<kc; k++, b+=NR)
+    for (r=0; r<MR; r++)
+    {
+      const real_t ar = a[r][k];
+      for (j=0; j<NR; j++)
+        acc[r][j] += ar*b[j];
+    }
+  for (r=0; r<MR; r++, c+=ldc)
+    for (j=0; j<NR; j++)
+      c[j] = add ? c[j]+acc[r][j] : acc[r][j];
+}
+#if defined(ALIZE_GDGEMM_X86)
+//-------------------------------------------------------------------------
+TARGET_SSE2 static void microSSE2(unsigned long kc, const real_t* const* a,
+                   const real_t* b, real_t* c, unsigned long ldc, bool add)
+{
+  __m128d c00 = _mm_setzero_pd(), c01 = c00, c10 = c00, c11 = c00,
+          c20 = c00, c21 = c00, c30 = c00, c31 = c00;
+  const real_t *a0 = a[0], *a1 = a[1], *a2 = a[2], *a3 = a[3];
+  for (unsigned long k=0; k<kc; k++, b+=4)
+  {
+    const __m128d b0 = _mm_load_pd(b), b1 = _mm_load_pd(b+2);
+    __m128d ar = _mm_set1_pd(a0[k]);
+    c00 = _mm_add_pd(c00, _mm_mul_pd(ar, b0));
+    c01 = _mm_add_pd(c01, _mm_mul_pd(ar, b1));
+    ar = _mm_set1_pd(a1[k]);
+    c10 = _mm_add_pd(c10, _mm_mul_pd(ar, b0));
+    c11 = _mm_add_pd(c11, _mm_mul_pd(ar, b1));
+    ar = _mm_set1_pd(a2[k]);
+    c20 = _mm_add_pd(c20, _mm_mul_pd(ar, b0));
+    c21 = _mm_add_pd(c21, _mm_mul_pd(ar, b1));
+    ar = _mm_set1_pd(a3[k]);
+    c30 = _mm_add_pd(c30, _mm_mul_pd(ar, b0));
+    c31 = _mm_add_pd(c31, _mm_mul_pd(ar, b1));
+  }
+  if (add)
+  {
+    c00 = _mm_add_pd(c00, _mm_loadu_pd(c));
+    c01 = _mm_add_pd(c01, _mm_loadu_pd(c+2));
+    c10 = _mm_add_pd(c10, _mm_loadu_pd(c+ldc));
+    c11 = _mm_add_pd(c11, _mm_loadu_pd(c+ldc+2));
+    c20 = _mm_add_pd(c20, _mm_loadu_pd(c+2*ldc));
+    c21 = _mm_add_pd(c21, _mm_loadu_pd(c+2*ldc+2));
+    c30 = _mm_add_pd(c30, _mm_loadu_pd(c+3*ldc));
+    c31 = _mm_add_pd(c31, _mm_loadu_pd(c+3*ldc+2));
+  }
+  _mm_storeu_pd(c, c00);         _mm_storeu_pd(c+2, c01);
+  _mm_storeu_pd(c+ldc, c10);     _mm_storeu_pd(c+ldc+2, c11);
+  _mm_storeu_pd(c+2*ldc, c20);   _mm_storeu_pd(c+2*ldc+2, c21);
+  _mm_storeu_pd(c+3*ldc, c30);   _mm_storeu_pd(c+3*ldc+2, c31);
+}
+#endif // ALIZE_GDGEMM_X86
+#if defined(ALIZE_GDGEMM_AVX)
+//-------------------------------------------------------------------------
+TARGET_AVX2 static void microAVX2(unsigned long kc, const real_t* const* a,
+                   const real_t* b, real_t* c, unsigned long ldc, bool add)
+{
+  __m256d c00 = _mm256_setzero_pd(), c01 = c00, c10 = c00, c11 = c00,
+          c20 = c00, c21 = c00, c30 = c00, c31 = c00;
+  const real_t *a0 = a[0], *a1 = a[1], *a2 = a[2], *a3 = a[3];
+  for (unsigned long k=0; k<kc; k++, b+=8)
+  {
+    const __m256d b0 = _mm256_load_pd(b), b1 = _mm256_load_pd(b+4);
+    __m256d ar = _mm256_broadcast_sd(a0+k);
+    c00 = _mm256_fmadd_pd(ar, b0, c00);
+    c01 = _mm256_fmadd_pd(ar, b1, c01);
+    ar = _mm256_broadcast_sd(a1+k);
+    c10 = _mm256_fmadd_pd(ar, b0, c10);
+    c11 = _mm256_fmadd_pd(ar, b1, c11);
+    ar = _mm256_broadcast_sd(a2+k);
+    c20 = _mm256_fmadd_pd(ar, b0, c20);
+    c21 = _mm256_fmadd_pd(ar, b1, c21);
+    ar = _mm256_broadcast_sd(a3+k);
+    c30 = _mm256_fmadd_pd(ar, b0, c30);
+    c31 = _mm256_fmadd_pd(ar, b1, c31);
+  }
+  if (add)
+  {
+    c00 = _mm256_add_pd(c00, _mm256_loadu_pd(c));
+    c01 = _mm256_add_pd(c01, _mm256_loadu_pd(c+4));
+    c10 = _mm256_add_pd(c10, _mm256_loadu_pd(c+ldc));
+    c11 = _mm256_add_pd(c11, _mm256_loadu_pd(c+ldc+4));
+    c20 = _mm256_add_pd(c20, _mm256_loadu_pd(c+2*ldc));
+    c21 = _mm256_add_pd(c21, _mm256_loadu_pd(c+2*ldc+4));
+    c30 = _mm256_add_pd(c30, _mm256_loadu_pd(c+3*ldc));
+    c31 = _mm256_add_pd(c31, _mm256_loadu_pd(c+3*ldc+4));
+  }
+  _mm256_storeu_pd(c, c00);       _mm256_storeu_pd(c+4, c01);
+  _mm256_storeu_pd(c+ldc, c10);   _mm256_storeu_pd(c+ldc+4, c11);
+  _mm256_storeu_pd(c+2*ldc, c20); _mm256_storeu_pd(c+2*ldc+4, c21);
+  _mm256_storeu_pd(c+3*ldc, c30); _mm256_storeu_pd(c+3*ldc+4, c31);
+}
+//-------------------------------------------------------------------------
+#define GDGEMM_ROW512(r) \
+    ar = _mm512_set1_pd(a##r[k]); \
+    c##r##0 = _mm512_fmadd_pd(ar, b0, c##r##0); \
+    c##r##1 = _mm512_fmadd_pd(ar, b1, c##r##1);
+#define GDGEMM_STORE512(r) \
+    if (add) \
+    { \
+      c##r##0 = _mm512_add_pd(c##r##0, _mm512_loadu_pd(c+r*ldc)); \
+      c##r##1 = _mm512_add_pd(c##r##1, _mm512_loadu_pd(c+r*ldc+8)); \
+    } \
+    _mm512_storeu_pd(c+r*ldc, c##r##0); \
+    _mm512_storeu_pd(c+r*ldc+8, c##r##1);
+//-------------------------------------------------------------------------
+// 8 rows x 16 columns : 16 accumulators out of 32 registers
+TARGET_AVX512 static void microAVX512(unsigned long kc,
+                                      const real_t* const* a,
+                   const real_t* b, real_t* c, unsigned long ldc, bool add)
+{
+  __m512d c00 = _mm512_setzero_pd(), c01 = c00, c10 = c00, c11 = c00,
+          c20 = c00, c21 = c00, c30 = c00, c31 = c00,
+          c40 = c00, c41 = c00, c50 = c00, c51 = c00,
+          c60 = c00, c61 = c00, c70 = c00, c71 = c00;
+  const real_t *a0 = a[0], *a1 = a[1], *a2 = a[2], *a3 = a[3],
+               *a4 = a[4], *a5 = a[5], *a6 = a[6], *a7 = a[7];
+  for (unsigned long k=0; k<kc; k++, b+=16)
+  {
+    const __m512d b0 = _mm512_load_pd(b), b1 = _mm512_load_pd(b+8);
+    __m512d ar;
+    GDGEMM_ROW512(0) GDGEMM_ROW512(1) GDGEMM_ROW512(2) GDGEMM_ROW512(3)
+    GDGEMM_ROW512(4) GDGEMM_ROW512(5) GDGEMM_ROW512(6) GDGEMM_ROW512(7)
+  }
+  GDGEMM_STORE512(0) GDGEMM_STORE512(1) GDGEMM_STORE512(2)
+  GDGEMM_STORE512(3) GDGEMM_STORE512(4) GDGEMM_STORE512(5)
+  GDGEMM_STORE512(6) GDGEMM_STORE512(7)
+}
+#undef GDGEMM_ROW512
+#undef GDGEMM_STORE512
+#endif // ALIZE_GDGEMM_AVX
+//-------------------------------------------------------------------------
+// Copies the block B[k0..k0+kc][j0..j0+nc] in panels of NR columns. The
+// last panel is padded with zeros
+//-------------------------------------------------------------------------
+static void packB(const real_t* b, unsigned long ldb, unsigned long kc,
+                  unsigned long nc, unsigned long NR, real_t* bp)
+{
+  for (unsigned long jr=0; jr<nc; jr+=NR)
+  {
+    const unsigned long nr = nc-jr < NR ? nc-jr : NR;
+    for (unsigned long k=0; k<kc; k++, bp+=NR)
+    {
+      const real_t* row = b + k*ldb + jr;
+      unsigned long j;
+      for (j=0; j<nr; j++)
+        bp[j] = row[j];
+      for (; j<NR; j++)
+        bp[j] = 0.0;
+    }
+  }
+}
+//-------------------------------------------------------------------------
+static void multiplyBlocked(unsigned long n, unsigned long m,
+                  unsigned long k, const real_t* a, unsigned long lda,
+                  const real_t* b, unsigned long ldb, real_t* c,
+                  unsigned long ldc, bool addToC)
+{
+  MicroKernel micro = microScalar;
+  unsigned long MR = 4, NR = 4;
+  switch (GDKernel::getSimdLevel())
+  {
+#if defined(ALIZE_GDGEMM_AVX)
+    case SimdLevel_AVX512: micro = microAVX512; MR = 8; NR = 16; break;
+    case SimdLevel_AVX2:   micro = microAVX2;   NR = 8;  break;
+#endif
+#if defined(ALIZE_GDGEMM_X86)
+    case SimdLevel_SSE2:   micro = microSSE2;   NR = 4;  break;
+#endif
+    default: break;
+  }
+  const unsigned long kcMax = k < KC ? k : KC;
+  const unsigned long ncMax = (m < NC ? (m+NR-1)/NR*NR : NC);
+  real_t* bp = GDKernel::createAlignedArray(kcMax*ncMax);
+  real_t tile[MR_MAX*NR_MAX]; // partial tiles of C
+  const real_t* aRow[MR_MAX];
+
+  for (unsigned long jc=0; jc<m; jc+=NC)
+  {
+    const unsigned long nc = m-jc < NC ? m-jc : NC;
+    for (unsigned long pc=0; pc<k; pc+=KC)
+    {
+      const unsigned long kc = k-pc < KC ? k-pc : KC;
+      const bool add = addToC || pc != 0;
+      packB(b+pc*ldb+jc, ldb, kc, nc, NR, bp);
+      for (unsigned long ic=0; ic<n; ic+=MC)
+      {
+        const unsigned long mc = n-ic < MC ? n-ic : MC;
+        for (unsigned long jr=0; jr<nc; jr+=NR)
+        {
+          const unsigned long nr = nc-jr < NR ? nc-jr : NR;
+          const real_t* panel = bp + jr*kc;
+          for (unsigned long ir=0; ir<mc; ir+=MR)
+          {
+            const unsigned long mr = mc-ir < MR ? mc-ir : MR;
+            unsigned long r, j;
+            // missing rows repeat the last one, their result is dropped
+            for (r=0; r<MR; r++)
+              aRow[r] = a + (ic+ir+(r<mr ? r : mr-1))*lda + pc;
+            real_t* ct = c + (ic+ir)*ldc + jc+jr;
+            if (mr == MR && nr == NR)
+            {
+              micro(kc, aRow, panel, ct, ldc, add);
+              continue;
+            }
+            for (r=0; r<mr && add; r++)
+              for (j=0; j<nr; j++)
+                tile[r*NR+j] = ct[r*ldc+j];
+            micro(kc, aRow, panel, tile, NR, add);
+            for (r=0; r<mr; r++)
+              for (j=0; j<nr; j++)
+                ct[r*ldc+j] = tile[r*NR+j];
+          }
+        }
+      }
+    }
+  }
+  GDKernel::deleteAlignedArray(bp);
+}
+//-------------------------------------------------------------------------
+void GDGemm::multiply(unsigned long n, unsigned long m, unsigned long k,
+                      const real_t* a, unsigned long lda,
+                      const real_t* b, unsigned long ldb,
+                      real_t* c, unsigned long ldc, bool add)
+{
+  if (n == 0 || m == 0)
+    return;
+  if (k == 0)
+  {
+    for (unsigned long i=0; i<n && !add; i++)
+      for (unsigned long j=0; j<m; j++)
+        c[i*ldc+j] = 0.0;
+    return;
+  }
+#if defined(ALIZE_USE_BLAS)
+  cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, (int)n, (int)m,
+              (int)k, 1.0, a, (int)lda, b, (int)ldb, add ? 1.0 : 0.0, c,
+              (int)ldc);
+#else
+  multiplyBlocked(n, m, k, a, lda, b, ldb, c, ldc, add);
+#endif
+}
+//-------------------------------------------------------------------------
+// F : type of the frames (real_t or float), converted when the left
+// operand is built
+//-------------------------------------------------------------------------
+template <class F> static void computeLogLK(const MixtureGDPacked& m,
+                 const F* frames, unsigned long frameCount, lk_t* llk)
+{
+  const unsigned long distribCount = m.getDistribCount();
+  const unsigned long vectSize = m.getVectSize();
+  const unsigned long k = 2*vectSize+1; // [x^2 | x | 1]
+  const unsigned long blockSize = frameCount < FRAME_BLOCK ?
+                                  frameCount : FRAME_BLOCK;
+  if (frameCount == 0 || distribCount == 0)
+    return;
+  const weight_t* logW = m.getLogWeightArray();
+  real_t* a = GDKernel::createAlignedArray(blockSize*k);
+  bool nanFrame[FRAME_BLOCK];
+
+  for (unsigned long n0=0; n0<frameCount; n0+=FRAME_BLOCK)
+  {
+    const unsigned long nb = frameCount-n0 < FRAME_BLOCK ?
+                             frameCount-n0 : FRAME_BLOCK;
+    unsigned long n, i, c;
+    for (n=0; n<nb; n++)
+    {
+      const F* x = frames + (n0+n)*vectSize;
+      real_t* row = a + n*k;
+      nanFrame[n] = false;
+      for (i=0; i<vectSize; i++)
+      {
+        const real_t xi = x[i];
+        if (ISNAN(xi))
+          nanFrame[n] = true;
+        row[i] = xi*xi;
+        row[vectSize+i] = xi;
+      }
+      row[2*vectSize] = 1.0;
+    }
+    lk_t* out = llk + n0*distribCount;
+    GDGemm::multiply(nb, distribCount, k, a, k, m.getGemmArray(),
+                     m.getStride(), out, distribCount);
+    for (n=0; n<nb; n++)
+      if (nanFrame[n])
+        for (c=0; c<distribCount; c++)
+          out[n*distribCount+c] = logW[c] + LOG_EPS_LK;
+  }
+  GDKernel::deleteAlignedArray(a);
+}
+//-------------------------------------------------------------------------
+void GDGemm::computeWeightedLogLK(const MixtureGDPacked& m,
+                 const real_t* frames, unsigned long frameCount, lk_t* llk)
+{ computeLogLK(m, frames, frameCount, llk); }
+//-------------------------------------------------------------------------
+void GDGemm::computeWeightedLogLK(const MixtureGDPacked& m,
+                 const float* frames, unsigned long frameCount, lk_t* llk)
+{ computeLogLK(m, frames, frameCount, llk); }
+//-------------------------------------------------------------------------
+bool GDGemm::isBlasUsed()
+{
+#if defined(ALIZE_USE_BLAS)
+  return true;
+#else
+  return false;
+#endif
+}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_GDGemm_cpp)
@@ -0,0 +1,826 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_GDKernel_cpp)
+#define ALIZE_GDKernel_cpp
+
+#if defined(_WIN32)
+  #include <cfloat> // for _isnan()
+  #include <malloc.h> // for _aligned_malloc()
+  #define ISNAN(x) _isnan(x)
+#elif defined(linux) || defined(__linux) || defined(__CYGWIN__) || defined(__APPLE__)
+  #define ISNAN(x) isnan(x)
+#else
+  #error "Unsupported OS\n"
+#endif
+
+// SIMD versions are only compiled for x86 targets. With gcc and clang each
+// version is compiled for its own instruction set (target attribute) so the
+// library does not need any special compiler flag.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+  #define ALIZE_GDKERNEL_X86
+  #define ALIZE_GDKERNEL_AVX
+  #define TARGET_SSE2   __attribute__((target("sse2")))
+  #define TARGET_AVX2   __attribute__((target("avx2,fma")))
+  #define TARGET_AVX512 __attribute__((target("avx512f")))
+  #include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+  #define ALIZE_GDKERNEL_X86
+  #define TARGET_SSE2
+  #include <emmintrin.h>
+#endif
+
+#include <new>
+#include <cmath>
+#include <cstdlib>
+#include <memory.h>
+#include "GDKernel.h"
+#include "MixtureGDPacked.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+
+//-------------------------------------------------------------------------
+// Constants of the exponential (Cephes library)
+//-------------------------------------------------------------------------
+static const double EXP_LOG2E = 1.4426950408889634073599;
+static const double EXP_C1    = 6.93145751953125E-1;
+static const double EXP_C2    = 1.42860682030941723212E-6;
+static const double EXP_P0    = 1.26177193074810590878E-4;
+static const double EXP_P1    = 3.02994407707441961300E-2;
+static const double EXP_P2    = 9.99999999999999999910E-1;
+static const double EXP_Q0    = 3.00198505138664455042E-6;
+static const double EXP_Q1    = 2.52448340349684104192E-3;
+static const double EXP_Q2    = 2.27265548208155028766E-1;
+static const double EXP_Q3    = 2.00000000000000000009E0;
+// below this value, exp(x) is rounded to 0 (denormals are computed)
+static const double EXP_MIN   = -745.13321910194110842;
+
+static const double EPS_LK_VALUE = 1e-200; // same as Object::EPS_LK
+
+SimdLevel GDKernel::_simdLevel = GDKernel::detectSimdLevel();
+
+static const double LOG_EPS_LK = -460.51701859880913680; // log(EPS_LK)
+
+const lk_t GDKernel::LOG_ZERO = -1e300;
+
+//-------------------------------------------------------------------------
+// All the kernels exist in two versions :
+// LOG == false : w[c]*lk(c,x), with the same operations, in the same
+//                order, as DistribGD::computeLK() for the scalar version
+// LOG == true  : log(w[c]) + log(cst[c]) - 0.5*q(c,x)
+// A NaN is replaced by w*EPS_LK (log(w)+log(EPS_LK)) as in
+// DistribGD::computeLK()
+//-------------------------------------------------------------------------
+// Scalar version
+//-------------------------------------------------------------------------
+template <bool LOG, class F> static void computeScalar(
+                 const MixtureGDPacked& m, const F* frames, unsigned long frameCount, lk_t* lk)
+{
+  const unsigned long distribCount = m.getDistribCount();
+  const unsigned long vectSize = m.getVectSize();
+  const unsigned long stride = m.getStride();
+  const real_t* meanArray = m.getMeanArray();
+  const real_t* covInvArray = m.getCovInvArray();
+  const real_t* cst = LOG ? m.getLogCstArray() : m.getCstArray();
+  const weight_t* w = LOG ? m.getLogWeightArray() : m.getWeightArray();
+  unsigned long c, i;
+
+  for (unsigned long n=0; n<frameCount; n++)
+  {
+    const F* f = frames + n*vectSize;
+    lk_t* tmp = lk + n*distribCount;
+    for (c=0; c<distribCount; c++)
+      tmp[c] = 0.0;
+    for (i=0; i<vectSize; i++)
+    {
+      const real_t* mean = meanArray + i*stride;
+      const real_t* covInv = covInvArray + i*stride;
+      const real_t fi = f[i];
+      for (c=0; c<distribCount; c++)
+        tmp[c] += (fi - mean[c]) * (fi - mean[c]) * covInv[c];
+    }
+    if (LOG)
+      for (c=0; c<distribCount; c++)
+      {
+        if (ISNAN(tmp[c]))
+          tmp[c] = w[c] + LOG_EPS_LK;
+        else
+          tmp[c] = w[c] + (cst[c] - 0.5*tmp[c]);
+      }
+    else
+      for (c=0; c<distribCount; c++)
+      {
+        real_t l = cst[c] * exp(-0.5*tmp[c]);
+        if (ISNAN(l))
+          l = EPS_LK_VALUE;
+        tmp[c] = w[c] * l;
+      }
+  }
+}
+
+#if defined(ALIZE_GDKERNEL_X86)
+//-------------------------------------------------------------------------
+// SSE2 version : 2 doubles per register
+//-------------------------------------------------------------------------
+TARGET_SSE2 static inline __m128d pow2SSE2(__m128i n) // n : 2 x int32
+{
+  __m128i e = _mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(1023)), 20);
+  return _mm_castsi128_pd(_mm_unpacklo_epi32(_mm_setzero_si128(), e));
+}
+//-------------------------------------------------------------------------
+TARGET_SSE2 static inline __m128d expSSE2(__m128d x)
+{
+  const __m128d xMin = _mm_set1_pd(EXP_MIN);
+  const __m128d underflow = _mm_cmplt_pd(x, xMin);
+  x = _mm_max_pd(x, xMin);
+  __m128i n = _mm_cvtpd_epi32(_mm_mul_pd(x, _mm_set1_pd(EXP_LOG2E)));
+  __m128d fn = _mm_cvtepi32_pd(n);
+  x = _mm_sub_pd(x, _mm_mul_pd(fn, _mm_set1_pd(EXP_C1)));
+  x = _mm_sub_pd(x, _mm_mul_pd(fn, _mm_set1_pd(EXP_C2)));
+  __m128d xx = _mm_mul_pd(x, x);
+  __m128d px = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(EXP_P0), xx),
+                          _mm_set1_pd(EXP_P1));
+  px = _mm_mul_pd(x, _mm_add_pd(_mm_mul_pd(px, xx), _mm_set1_pd(EXP_P2)));
+  __m128d qx = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(EXP_Q0), xx),
+                          _mm_set1_pd(EXP_Q1));
+  qx = _mm_add_pd(_mm_mul_pd(qx, xx), _mm_set1_pd(EXP_Q2));
+  qx = _mm_add_pd(_mm_mul_pd(qx, xx), _mm_set1_pd(EXP_Q3));
+  __m128d e = _mm_div_pd(px, _mm_sub_pd(qx, px));
+  e = _mm_add_pd(_mm_set1_pd(1.0), _mm_add_pd(e, e));
+  // 2^n is split in two factors to compute denormal results
+  __m128i n1 = _mm_srai_epi32(n, 1);
+  e = _mm_mul_pd(_mm_mul_pd(e, pow2SSE2(n1)),
+                 pow2SSE2(_mm_sub_epi32(n, n1)));
+  return _mm_andnot_pd(underflow, e);
+}
+//-------------------------------------------------------------------------
+TARGET_SSE2 static inline __m128d blendSSE2(__m128d a, __m128d b,
+                                            __m128d mask)
+{ return _mm_or_pd(_mm_andnot_pd(mask, a), _mm_and_pd(mask, b)); }
+//-------------------------------------------------------------------------
+template <bool LOG> TARGET_SSE2 static inline __m128d finishSSE2(__m128d q,
+                                       const real_t* cst, const weight_t* w)
+{
+  const __m128d nan = _mm_cmpunord_pd(q, q);
+  const __m128d vw = _mm_load_pd(w);
+  if (LOG)
+    return blendSSE2(_mm_add_pd(vw, _mm_sub_pd(_mm_load_pd(cst),
+                                        _mm_mul_pd(_mm_set1_pd(0.5), q))),
+                     _mm_add_pd(vw, _mm_set1_pd(LOG_EPS_LK)), nan);
+  __m128d l = _mm_mul_pd(_mm_load_pd(cst),
+                         expSSE2(_mm_mul_pd(_mm_set1_pd(-0.5), q)));
+  l = blendSSE2(l, _mm_set1_pd(EPS_LK_VALUE), nan);
+  return _mm_mul_pd(vw, l);
+}
+//-------------------------------------------------------------------------
+template <bool LOG, class F> TARGET_SSE2 static void computeSSE2(
+                 const MixtureGDPacked& m, const F* frames,
+                 unsigned long frameCount, lk_t* lk)
+{
+  const unsigned long distribCount = m.getDistribCount();
+  const unsigned long vectSize = m.getVectSize();
+  const unsigned long stride = m.getStride();
+  const real_t* meanArray = m.getMeanArray();
+  const real_t* covInvArray = m.getCovInvArray();
+  const real_t* cst = LOG ? m.getLogCstArray() : m.getCstArray();
+  const weight_t* w = LOG ? m.getLogWeightArray() : m.getWeightArray();
+  const unsigned long W = 4; // distributions per block
+  double tmp[W];
+
+  for (unsigned long c=0; c<distribCount; c+=W)
+  {
+    const unsigned long nc = distribCount-c < W ? distribCount-c : W;
+    for (unsigned long n=0; n<frameCount; n++)
+    {
+      const F* f = frames + n*vectSize;
+      __m128d q0 = _mm_setzero_pd(), q1 = _mm_setzero_pd();
+      for (unsigned long i=0; i<vectSize; i++)
+      {
+        const real_t* mean = meanArray + i*stride + c;
+        const real_t* covInv = covInvArray + i*stride + c;
+        const __m128d fi = _mm_set1_pd(f[i]);
+        __m128d d0 = _mm_sub_pd(fi, _mm_load_pd(mean));
+        __m128d d1 = _mm_sub_pd(fi, _mm_load_pd(mean+2));
+        q0 = _mm_add_pd(q0, _mm_mul_pd(_mm_mul_pd(d0, d0),
+                                       _mm_load_pd(covInv)));
+        q1 = _mm_add_pd(q1, _mm_mul_pd(_mm_mul_pd(d1, d1),
+                                       _mm_load_pd(covInv+2)));
+      }
+      _mm_storeu_pd(tmp, finishSSE2<LOG>(q0, cst+c, w+c));
+      _mm_storeu_pd(tmp+2, finishSSE2<LOG>(q1, cst+c+2, w+c+2));
+      memcpy(lk + n*distribCount + c, tmp, nc*sizeof(lk_t));
+    }
+  }
+}
+#endif // ALIZE_GDKERNEL_X86
+
+#if defined(ALIZE_GDKERNEL_AVX)
+//-------------------------------------------------------------------------
+// AVX2 + FMA version : 4 doubles per register, 4 frames x 8 distributions
+// per block
+//-------------------------------------------------------------------------
+TARGET_AVX2 static inline __m256d pow2AVX2(__m128i n) // n : 4 x int32
+{
+  __m256i e = _mm256_add_epi64(_mm256_cvtepi32_epi64(n),
+                               _mm256_set1_epi64x(1023));
+  return _mm256_castsi256_pd(_mm256_slli_epi64(e, 52));
+}
+//-------------------------------------------------------------------------
+TARGET_AVX2 static inline __m256d expAVX2(__m256d x)
+{
+  const __m256d xMin = _mm256_set1_pd(EXP_MIN);
+  const __m256d underflow = _mm256_cmp_pd(x, xMin, _CMP_LT_OQ);
+  x = _mm256_max_pd(x, xMin);
+  __m256d fn = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(EXP_LOG2E)),
+                         _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  x = _mm256_fnmadd_pd(fn, _mm256_set1_pd(EXP_C1), x);
+  x = _mm256_fnmadd_pd(fn, _mm256_set1_pd(EXP_C2), x);
+  __m256d xx = _mm256_mul_pd(x, x);
+  __m256d px = _mm256_fmadd_pd(_mm256_set1_pd(EXP_P0), xx,
+                               _mm256_set1_pd(EXP_P1));
+  px = _mm256_mul_pd(x, _mm256_fmadd_pd(px, xx, _mm256_set1_pd(EXP_P2)));
+  __m256d qx = _mm256_fmadd_pd(_mm256_set1_pd(EXP_Q0), xx,
+                               _mm256_set1_pd(EXP_Q1));
+  qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(EXP_Q2));
+  qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(EXP_Q3));
+  __m256d e = _mm256_div_pd(px, _mm256_sub_pd(qx, px));
+  e = _mm256_fmadd_pd(e, _mm256_set1_pd(2.0), _mm256_set1_pd(1.0));
+  __m128i n = _mm256_cvtpd_epi32(fn);
+  __m128i n1 = _mm_srai_epi32(n, 1);
+  e = _mm256_mul_pd(_mm256_mul_pd(e, pow2AVX2(n1)),
+                    pow2AVX2(_mm_sub_epi32(n, n1)));
+  return _mm256_andnot_pd(underflow, e);
+}
+//-------------------------------------------------------------------------
+template <bool LOG> TARGET_AVX2 static inline void finishAVX2(__m256d q,
+         const real_t* cst, const weight_t* w, lk_t* lk, unsigned long nc)
+{
+  const __m256d nan = _mm256_cmp_pd(q, q, _CMP_UNORD_Q);
+  const __m256d vw = _mm256_load_pd(w);
+  __m256d l;
+  if (LOG)
+    l = _mm256_blendv_pd(_mm256_add_pd(vw, _mm256_fnmadd_pd(
+                  _mm256_set1_pd(0.5), q, _mm256_load_pd(cst))),
+                  _mm256_add_pd(vw, _mm256_set1_pd(LOG_EPS_LK)), nan);
+  else
+  {
+    l = _mm256_mul_pd(_mm256_load_pd(cst),
+                       expAVX2(_mm256_mul_pd(_mm256_set1_pd(-0.5), q)));
+    l = _mm256_blendv_pd(l, _mm256_set1_pd(EPS_LK_VALUE), nan);
+    l = _mm256_mul_pd(vw, l);
+  }
+  if (nc >= 4)
+    _mm256_storeu_pd(lk, l);
+  else
+  {
+    double tmp[4];
+    _mm256_storeu_pd(tmp, l);
+    memcpy(lk, tmp, nc*sizeof(lk_t));
+  }
+}
+//-------------------------------------------------------------------------
+template <bool LOG, class F> TARGET_AVX2 static void computeAVX2(
+                 const MixtureGDPacked& m, const F* frames,
+                 unsigned long frameCount, lk_t* lk)
+{
+  const unsigned long distribCount = m.getDistribCount();
+  const unsigned long vectSize = m.getVectSize();
+  const unsigned long stride = m.getStride();
+  const real_t* meanArray = m.getMeanArray();
+  const real_t* covInvArray = m.getCovInvArray();
+  const real_t* cst = LOG ? m.getLogCstArray() : m.getCstArray();
+  const weight_t* w = LOG ? m.getLogWeightArray() : m.getWeightArray();
+  const unsigned long W = 8; // distributions per block
+  unsigned long n, i, k;
+
+  for (unsigned long c=0; c<distribCount; c+=W)
+  {
+    const unsigned long nc = distribCount-c;
+    const unsigned long nc1 = nc > 4 ? nc-4 : 0;
+    // 4 frames at a time : means and inverse covariances are loaded once
+    for (n=0; n+4<=frameCount; n+=4)
+    {
+      const F* f = frames + n*vectSize;
+      __m256d q[4][2];
+      for (k=0; k<4; k++)
+        q[k][0] = q[k][1] = _mm256_setzero_pd();
+      for (i=0; i<vectSize; i++)
+      {
+        const real_t* mean = meanArray + i*stride + c;
+        const real_t* covInv = covInvArray + i*stride + c;
+        const __m256d m0 = _mm256_load_pd(mean);
+        const __m256d m1 = _mm256_load_pd(mean+4);
+        const __m256d i0 = _mm256_load_pd(covInv);
+        const __m256d i1 = _mm256_load_pd(covInv+4);
+        for (k=0; k<4; k++)
+        {
+          const __m256d fi = _mm256_set1_pd(f[k*vectSize + i]);
+          const __m256d d0 = _mm256_sub_pd(fi, m0);
+          const __m256d d1 = _mm256_sub_pd(fi, m1);
+          q[k][0] = _mm256_fmadd_pd(_mm256_mul_pd(d0, d0), i0, q[k][0]);
+          q[k][1] = _mm256_fmadd_pd(_mm256_mul_pd(d1, d1), i1, q[k][1]);
+        }
+      }
+      for (k=0; k<4; k++)
+      {
+        lk_t* l = lk + (n+k)*distribCount + c;
+        finishAVX2<LOG>(q[k][0], cst+c, w+c, l, nc);
+        if (nc1 != 0)
+          finishAVX2<LOG>(q[k][1], cst+c+4, w+c+4, l+4, nc1);
+      }
+    }
+    for (; n<frameCount; n++)
+    {
+      const F* f = frames + n*vectSize;
+      __m256d q0 = _mm256_setzero_pd(), q1 = _mm256_setzero_pd();
+      for (i=0; i<vectSize; i++)
+      {
+        const real_t* mean = meanArray + i*stride + c;
+        const real_t* covInv = covInvArray + i*stride + c;
+        const __m256d fi = _mm256_set1_pd(f[i]);
+        const __m256d d0 = _mm256_sub_pd(fi, _mm256_load_pd(mean));
+        const __m256d d1 = _mm256_sub_pd(fi, _mm256_load_pd(mean+4));
+        q0 = _mm256_fmadd_pd(_mm256_mul_pd(d0, d0),
+                             _mm256_load_pd(covInv), q0);
+        q1 = _mm256_fmadd_pd(_mm256_mul_pd(d1, d1),
+                             _mm256_load_pd(covInv+4), q1);
+      }
+      lk_t* l = lk + n*distribCount + c;
+      finishAVX2<LOG>(q0, cst+c, w+c, l, nc);
+      if (nc1 != 0)
+        finishAVX2<LOG>(q1, cst+c+4, w+c+4, l+4, nc1);
+    }
+  }
+}
+//-------------------------------------------------------------------------
+// AVX-512 version : 8 doubles per register, 4 frames x 16 distributions
+// per block.
+// The unmasked forms of some intrinsics take an undefined source vector
+// (uninitialized warnings with gcc) : their zero-masked forms are used
+// with a full mask.
+//-------------------------------------------------------------------------
+static const __mmask8 ALL8 = 0xFF;
+//-------------------------------------------------------------------------
+TARGET_AVX512 static inline __m512d pow2AVX512(__m256i n) // n : 8 x int32
+{
+  __m512i e = _mm512_add_epi64(_mm512_maskz_cvtepi32_epi64(ALL8, n),
+                               _mm512_set1_epi64(1023));
+  return _mm512_castsi512_pd(_mm512_maskz_slli_epi64(ALL8, e, 52));
+}
+//-------------------------------------------------------------------------
+TARGET_AVX512 static inline __m512d expAVX512(__m512d x)
+{
+  const __m512d xMin = _mm512_set1_pd(EXP_MIN);
+  const __mmask8 valid = _mm512_cmp_pd_mask(x, xMin, _CMP_GE_OQ);
+  x = _mm512_maskz_max_pd(ALL8, x, xMin);
+  __m512d fn = _mm512_maskz_roundscale_pd(ALL8,
+                     _mm512_mul_pd(x, _mm512_set1_pd(EXP_LOG2E)),
+                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  x = _mm512_fnmadd_pd(fn, _mm512_set1_pd(EXP_C1), x);
+  x = _mm512_fnmadd_pd(fn, _mm512_set1_pd(EXP_C2), x);
+  __m512d xx = _mm512_mul_pd(x, x);
+  __m512d px = _mm512_fmadd_pd(_mm512_set1_pd(EXP_P0), xx,
+                               _mm512_set1_pd(EXP_P1));
+  px = _mm512_mul_pd(x, _mm512_fmadd_pd(px, xx, _mm512_set1_pd(EXP_P2)));
+  __m512d qx = _mm512_fmadd_pd(_mm512_set1_pd(EXP_Q0), xx,
+                               _mm512_set1_pd(EXP_Q1));
+  qx = _mm512_fmadd_pd(qx, xx, _mm512_set1_pd(EXP_Q2));
+  qx = _mm512_fmadd_pd(qx, xx, _mm512_set1_pd(EXP_Q3));
+  __m512d e = _mm512_div_pd(px, _mm512_sub_pd(qx, px));
+  e = _mm512_fmadd_pd(e, _mm512_set1_pd(2.0), _mm512_set1_pd(1.0));
+  __m256i n = _mm512_maskz_cvtpd_epi32(ALL8, fn);
+  __m256i n1 = _mm256_srai_epi32(n, 1);
+  e = _mm512_mul_pd(_mm512_mul_pd(e, pow2AVX512(n1)),
+                    pow2AVX512(_mm256_sub_epi32(n, n1)));
+  return _mm512_maskz_mov_pd(valid, e);
+}
+//-------------------------------------------------------------------------
+template <bool LOG> TARGET_AVX512 static inline void finishAVX512(
+                  __m512d q, const real_t* cst, const weight_t* w, lk_t* lk,
+                  unsigned long nc)
+{
+  const __mmask8 nan = _mm512_cmp_pd_mask(q, q, _CMP_UNORD_Q);
+  const __m512d vw = _mm512_load_pd(w);
+  __m512d l;
+  if (LOG)
+    l = _mm512_mask_mov_pd(_mm512_add_pd(vw, _mm512_fnmadd_pd(
+                  _mm512_set1_pd(0.5), q, _mm512_load_pd(cst))), nan,
+                  _mm512_add_pd(vw, _mm512_set1_pd(LOG_EPS_LK)));
+  else
+  {
+    l = _mm512_mul_pd(_mm512_load_pd(cst),
+                       expAVX512(_mm512_mul_pd(_mm512_set1_pd(-0.5), q)));
+    l = _mm512_mask_mov_pd(l, nan, _mm512_set1_pd(EPS_LK_VALUE));
+    l = _mm512_mul_pd(vw, l);
+  }
+  if (nc >= 8)
+    _mm512_storeu_pd(lk, l);
+  else
+    _mm512_mask_storeu_pd(lk, (__mmask8)((1u<<nc)-1), l);
+}
+//-------------------------------------------------------------------------
+template <bool LOG, class F> TARGET_AVX512 static void computeAVX512(
+                 const MixtureGDPacked& m, const F* frames,
+                 unsigned long frameCount, lk_t* lk)
+{
+  const unsigned long distribCount = m.getDistribCount();
+  const unsigned long vectSize = m.getVectSize();
+  const unsigned long stride = m.getStride();
+  const real_t* meanArray = m.getMeanArray();
+  const real_t* covInvArray = m.getCovInvArray();
+  const real_t* cst = LOG ? m.getLogCstArray() : m.getCstArray();
+  const weight_t* w = LOG ? m.getLogWeightArray() : m.getWeightArray();
+  const unsigned long W = 16; // distributions per block
+  unsigned long n, i, k;
+
+  for (unsigned long c=0; c<distribCount; c+=W)
+  {
+    const unsigned long nc = distribCount-c;
+    const unsigned long nc1 = nc > 8 ? nc-8 : 0;
+    for (n=0; n+4<=frameCount; n+=4)
+    {
+      const F* f = frames + n*vectSize;
+      __m512d q[4][2];
+      for (k=0; k<4; k++)
+        q[k][0] = q[k][1] = _mm512_setzero_pd();
+      for (i=0; i<vectSize; i++)
+      {
+        const real_t* mean = meanArray + i*stride + c;
+        const real_t* covInv = covInvArray + i*stride + c;
+        const __m512d m0 = _mm512_load_pd(mean);
+        const __m512d m1 = _mm512_load_pd(mean+8);
+        const __m512d i0 = _mm512_load_pd(covInv);
+        const __m512d i1 = _mm512_load_pd(covInv+8);
+        for (k=0; k<4; k++)
+        {
+          const __m512d fi = _mm512_set1_pd(f[k*vectSize + i]);
+          const __m512d d0 = _mm512_sub_pd(fi, m0);
+          const __m512d d1 = _mm512_sub_pd(fi, m1);
+          q[k][0] = _mm512_fmadd_pd(_mm512_mul_pd(d0, d0), i0, q[k][0]);
+          q[k][1] = _mm512_fmadd_pd(_mm512_mul_pd(d1, d1), i1, q[k][1]);
+        }
+      }
+      for (k=0; k<4; k++)
+      {
+        lk_t* l = lk + (n+k)*distribCount + c;
+        finishAVX512<LOG>(q[k][0], cst+c, w+c, l, nc);
+        if (nc1 != 0)
+          finishAVX512<LOG>(q[k][1], cst+c+8, w+c+8, l+8, nc1);
+      }
+    }
+    for (; n<frameCount; n++)
+    {
+      const F* f = frames + n*vectSize;
+      __m512d q0 = _mm512_setzero_pd(), q1 = _mm512_setzero_pd();
+      for (i=0; i<vectSize; i++)
+      {
+        const real_t* mean = meanArray + i*stride + c;
+        const real_t* covInv = covInvArray + i*stride + c;
+        const __m512d fi = _mm512_set1_pd(f[i]);
+        const __m512d d0 = _mm512_sub_pd(fi, _mm512_load_pd(mean));
+        const __m512d d1 = _mm512_sub_pd(fi, _mm512_load_pd(mean+8));
+        q0 = _mm512_fmadd_pd(_mm512_mul_pd(d0, d0),
+                             _mm512_load_pd(covInv), q0);
+        q1 = _mm512_fmadd_pd(_mm512_mul_pd(d1, d1),
+                             _mm512_load_pd(covInv+8), q1);
+      }
+      lk_t* l = lk + n*distribCount + c;
+      finishAVX512<LOG>(q0, cst+c, w+c, l, nc);
+      if (nc1 != 0)
+        finishAVX512<LOG>(q1, cst+c+8, w+c+8, l+8, nc1);
+    }
+  }
+}
+#endif // ALIZE_GDKERNEL_AVX
+
+//-------------------------------------------------------------------------
+// Log-sum-exp and posteriors
+//-------------------------------------------------------------------------
+static lk_t logSumExpScalar(const lk_t* v, unsigned long n)
+{
+  unsigned long i;
+  lk_t max = v[0], sum = 0.0;
+  for (i=1; i<n; i++)
+    if (v[i] > max)
+      max = v[i];
+  for (i=0; i<n; i++)
+    sum += exp(v[i]-max);
+  return max + log(sum);
+}
+//-------------------------------------------------------------------------
+static void expShiftScalar(const lk_t* v, unsigned long n, lk_t shift,
+                           lk_t* out)
+{
+  for (unsigned long i=0; i<n; i++)
+    out[i] = exp(v[i]-shift);
+}
+#if defined(ALIZE_GDKERNEL_X86)
+//-------------------------------------------------------------------------
+TARGET_SSE2 static lk_t logSumExpSSE2(const lk_t* v, unsigned long n)
+{
+  unsigned long i;
+  __m128d vmax = _mm_set1_pd(v[0]);
+  for (i=0; i+2<=n; i+=2)
+    vmax = _mm_max_pd(vmax, _mm_loadu_pd(v+i));
+  lk_t max = v[0], t[2];
+  _mm_storeu_pd(t, vmax);
+  for (unsigned long k=0; k<2; k++)
+    if (t[k] > max)
+      max = t[k];
+  for (; i<n; i++)
+    if (v[i] > max)
+      max = v[i];
+  const __m128d vshift = _mm_set1_pd(max);
+  __m128d vsum = _mm_setzero_pd();
+  for (i=0; i+2<=n; i+=2)
+    vsum = _mm_add_pd(vsum, expSSE2(_mm_sub_pd(_mm_loadu_pd(v+i), vshift)));
+  _mm_storeu_pd(t, vsum);
+  lk_t sum = t[0] + t[1];
+  for (; i<n; i++)
+    sum += exp(v[i]-max);
+  return max + log(sum);
+}
+//-------------------------------------------------------------------------
+TARGET_SSE2 static void expShiftSSE2(const lk_t* v, unsigned long n,
+                                     lk_t shift, lk_t* out)
+{
+  unsigned long i;
+  const __m128d vshift = _mm_set1_pd(shift);
+  for (i=0; i+2<=n; i+=2)
+    _mm_storeu_pd(out+i, expSSE2(_mm_sub_pd(_mm_loadu_pd(v+i), vshift)));
+  for (; i<n; i++)
+    out[i] = exp(v[i]-shift);
+}
+#endif // ALIZE_GDKERNEL_X86
+#if defined(ALIZE_GDKERNEL_AVX)
+//-------------------------------------------------------------------------
+TARGET_AVX2 static lk_t logSumExpAVX2(const lk_t* v, unsigned long n)
+{
+  unsigned long i;
+  __m256d vmax = _mm256_set1_pd(v[0]);
+  for (i=0; i+4<=n; i+=4)
+    vmax = _mm256_max_pd(vmax, _mm256_loadu_pd(v+i));
+  lk_t max = v[0], t[4];
+  _mm256_storeu_pd(t, vmax);
+  for (unsigned long k=0; k<4; k++)
+    if (t[k] > max)
+      max = t[k];
+  for (; i<n; i++)
+    if (v[i] > max)
+      max = v[i];
+  const __m256d vshift = _mm256_set1_pd(max);
+  __m256d vsum = _mm256_setzero_pd();
+  for (i=0; i+4<=n; i+=4)
+    vsum = _mm256_add_pd(vsum,
+                  expAVX2(_mm256_sub_pd(_mm256_loadu_pd(v+i), vshift)));
+  _mm256_storeu_pd(t, vsum);
+  lk_t sum = (t[0] + t[1]) + (t[2] + t[3]);
+  for (; i<n; i++)
+    sum += exp(v[i]-max);
+  return max + log(sum);
+}
+//-------------------------------------------------------------------------
+TARGET_AVX2 static void expShiftAVX2(const lk_t* v, unsigned long n,
+                                     lk_t shift, lk_t* out)
+{
+  unsigned long i;
+  const __m256d vshift = _mm256_set1_pd(shift);
+  for (i=0; i+4<=n; i+=4)
+    _mm256_storeu_pd(out+i,
+                   expAVX2(_mm256_sub_pd(_mm256_loadu_pd(v+i), vshift)));
+  for (; i<n; i++)
+    out[i] = exp(v[i]-shift);
+}
+//-------------------------------------------------------------------------
+TARGET_AVX512 static lk_t logSumExpAVX512(const lk_t* v, unsigned long n)
+{
+  unsigned long i;
+  __m512d vmax = _mm512_set1_pd(v[0]);
+  for (i=0; i+8<=n; i+=8)
+    vmax = _mm512_maskz_max_pd(ALL8, vmax, _mm512_loadu_pd(v+i));
+  lk_t max = v[0], t[8];
+  _mm512_storeu_pd(t, vmax);
+  for (unsigned long k=0; k<8; k++)
+    if (t[k] > max)
+      max = t[k];
+  for (; i<n; i++)
+    if (v[i] > max)
+      max = v[i];
+  const __m512d vshift = _mm512_set1_pd(max);
+  __m512d vsum = _mm512_setzero_pd();
+  for (i=0; i+8<=n; i+=8)
+    vsum = _mm512_add_pd(vsum,
+                  expAVX512(_mm512_sub_pd(_mm512_loadu_pd(v+i), vshift)));
+  _mm512_storeu_pd(t, vsum);
+  lk_t sum = ((t[0] + t[4]) + (t[2] + t[6]))
+            + ((t[1] + t[5]) + (t[3] + t[7]));
+  for (; i<n; i++)
+    sum += exp(v[i]-max);
+  return max + log(sum);
+}
+//-------------------------------------------------------------------------
+TARGET_AVX512 static void expShiftAVX512(const lk_t* v, unsigned long n,
+                                         lk_t shift, lk_t* out)
+{
+  unsigned long i;
+  const __m512d vshift = _mm512_set1_pd(shift);
+  for (i=0; i+8<=n; i+=8)
+    _mm512_storeu_pd(out+i,
+                   expAVX512(_mm512_sub_pd(_mm512_loadu_pd(v+i), vshift)));
+  for (; i<n; i++)
+    out[i] = exp(v[i]-shift);
+}
+#endif // ALIZE_GDKERNEL_AVX
+
+//-------------------------------------------------------------------------
+// F : type of the frames (real_t or float). Float frames are converted in
+// the registers, the computations are always done in double precision.
+//-------------------------------------------------------------------------
+template <bool LOG, class F> static void compute(SimdLevel l,
+                 const MixtureGDPacked& m, const F* frames,
+                 unsigned long frameCount, lk_t* lk)
+{
+  switch (l)
+  {
+#if defined(ALIZE_GDKERNEL_AVX)
+    case SimdLevel_AVX512:
+      computeAVX512<LOG>(m, frames, frameCount, lk); return;
+    case SimdLevel_AVX2:
+      computeAVX2<LOG>(m, frames, frameCount, lk); return;
+#endif
+#if defined(ALIZE_GDKERNEL_X86)
+    case SimdLevel_SSE2:
+      computeSSE2<LOG>(m, frames, frameCount, lk); return;
+#endif
+    default:
+      computeScalar<LOG>(m, frames, frameCount, lk);
+  }
+}
+//-------------------------------------------------------------------------
+void GDKernel::computeWeightedLK(const MixtureGDPacked& m,
+                  const real_t* frames, unsigned long frameCount, lk_t* lk)
+{ compute<false>(_simdLevel, m, frames, frameCount, lk); }
+//-------------------------------------------------------------------------
+void GDKernel::computeWeightedLK(const MixtureGDPacked& m,
+                  const float* frames, unsigned long frameCount, lk_t* lk)
+{ compute<false>(_simdLevel, m, frames, frameCount, lk); }
+//-------------------------------------------------------------------------
+void GDKernel::computeWeightedLogLK(const MixtureGDPacked& m,
+                  const real_t* frames, unsigned long frameCount, lk_t* llk)
+{ compute<true>(_simdLevel, m, frames, frameCount, llk); }
+//-------------------------------------------------------------------------
+void GDKernel::computeWeightedLogLK(const MixtureGDPacked& m,
+                  const float* frames, unsigned long frameCount, lk_t* llk)
+{ compute<true>(_simdLevel, m, frames, frameCount, llk); }
+//-------------------------------------------------------------------------
+lk_t GDKernel::logSumExp(const lk_t* v, unsigned long n)
+{
+  if (n == 0)
+    return LOG_ZERO;
+  switch (_simdLevel)
+  {
+#if defined(ALIZE_GDKERNEL_AVX)
+    case SimdLevel_AVX512: return logSumExpAVX512(v, n);
+    case SimdLevel_AVX2:   return logSumExpAVX2(v, n);
+#endif
+#if defined(ALIZE_GDKERNEL_X86)
+    case SimdLevel_SSE2:   return logSumExpSSE2(v, n);
+#endif
+    default:               return logSumExpScalar(v, n);
+  }
+}
+//-------------------------------------------------------------------------
+lk_t GDKernel::computePosteriors(const lk_t* llk, unsigned long n,
+                                 occ_t* post)
+{
+  const lk_t lse = logSumExp(llk, n);
+  switch (_simdLevel)
+  {
+#if defined(ALIZE_GDKERNEL_AVX)
+    case SimdLevel_AVX512: expShiftAVX512(llk, n, lse, post); break;
+    case SimdLevel_AVX2:   expShiftAVX2(llk, n, lse, post); break;
+#endif
+#if defined(ALIZE_GDKERNEL_X86)
+    case SimdLevel_SSE2:   expShiftSSE2(llk, n, lse, post); break;
+#endif
+    default:               expShiftScalar(llk, n, lse, post);
+  }
+  return lse;
+}
+//-------------------------------------------------------------------------
+SimdLevel GDKernel::detectSimdLevel()
+{
+#if defined(ALIZE_GDKERNEL_AVX)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return SimdLevel_AVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return SimdLevel_AVX2;
+  if (__builtin_cpu_supports("sse2"))
+    return SimdLevel_SSE2;
+  return SimdLevel_SCALAR;
+#elif defined(ALIZE_GDKERNEL_X86)
+  return SimdLevel_SSE2; // always available on x86-64
+#else
+  return SimdLevel_SCALAR;
+#endif
+}
+//-------------------------------------------------------------------------
+SimdLevel GDKernel::getSimdLevel() { return _simdLevel; }
+//-------------------------------------------------------------------------
+void GDKernel::setSimdLevel(SimdLevel l)
+{
+  SimdLevel best = detectSimdLevel();
+  _simdLevel = l > best ? best : l;
+}
+//-------------------------------------------------------------------------
+string GDKernel::getSimdLevelName(SimdLevel l)
+{
+  switch (l)
+  {
+    case SimdLevel_AVX512: return "AVX512";
+    case SimdLevel_AVX2:   return "AVX2";
+    case SimdLevel_SSE2:   return "SSE2";
+    default:               return "SCALAR";
+  }
+}
+//-------------------------------------------------------------------------
+real_t* GDKernel::createAlignedArray(unsigned long size)
+{
+  const size_t bytes = (size!=0?size:1)*sizeof(real_t);
+#if defined(_WIN32)
+  void* p = _aligned_malloc(bytes, MixtureGDPacked::ALIGNMENT);
+#else
+  void* p = NULL;
+  if (posix_memalign(&p, MixtureGDPacked::ALIGNMENT, bytes) != 0)
+    p = NULL;
+#endif
+  Object::assertMemoryIsAllocated(p, __FILE__, __LINE__);
+  return static_cast<real_t*>(p);
+}
+//-------------------------------------------------------------------------
+void GDKernel::deleteAlignedArray(real_t* p)
+{
+#if defined(_WIN32)
+  _aligned_free(p);
+#else
+  free(p);
+#endif
+}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_GDKernel_cpp)
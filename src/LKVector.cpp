@@ -59,6 +59,7 @@
 #include <math.h>
 #include <memory.h>
 #include <cstdlib>
+#include <algorithm>
 #include "LKVector.h"
 
 #include "Exception.h"
@@ -188,6 +189,60 @@ void LKVector::descendingSort() const
   qsort(_array, _size, sizeof(type), compare);
 }
 //-------------------------------------------------------------------------
+template <bool STABLE> static inline bool isGreater(
+         const LKVector::type& a, const LKVector::type& b)
+{
+  return a.lk > b.lk || (STABLE && a.lk == b.lk && a.idx < b.idx);
+}
+//-------------------------------------------------------------------------
+// Bounded selection : the first n values are kept sorted and a value
+// enters them only if it is greater than the smallest one (v[n-1]).
+// Most values are rejected by a single comparison.
+//-------------------------------------------------------------------------
+template <bool STABLE> static void selectTop(LKVector::type* v,
+                                   unsigned long size, unsigned long n)
+{
+  unsigned long i, j;
+  LKVector::type t;
+  for (i=1; i<size; i++) // insertion sort of the first n values
+  {
+    if (i == n)
+      break;
+    t = v[i];
+    for (j=i; j>0 && isGreater<STABLE>(t, v[j-1]); j--)
+      v[j] = v[j-1];
+    v[j] = t;
+  }
+  for (i=n; i<size; i++)
+  {
+    if (!isGreater<STABLE>(v[i], v[n-1]))
+      continue;
+    t = v[i];
+    v[i] = v[n-1]; // the smallest value leaves the top
+    for (j=n-1; j>0 && isGreater<STABLE>(t, v[j-1]); j--)
+      v[j] = v[j-1];
+    v[j] = t;
+  }
+}
+//-------------------------------------------------------------------------
+void LKVector::descendingSort(unsigned long n, bool stable) const
+{
+  assert(_array != NULL);
+  if (n == 0 || _size < 2)
+    return;
+  if (n >= _size) // complete sort (merge sort : safe with NaN values)
+  {
+    if (stable)
+      std::stable_sort(_array, _array+_size, isGreater<true>);
+    else
+      std::stable_sort(_array, _array+_size, isGreater<false>);
+  }
+  else if (stable)
+    selectTop<true>(_array, _size, n);
+  else
+    selectTop<false>(_array, _size, n);
+}
+//-------------------------------------------------------------------------
 LKVector::type* LKVector::getArray() const { return _array; }
 //-------------------------------------------------------------------------
 void LKVector::clear() { _size = 0; }
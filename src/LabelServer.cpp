@@ -67,7 +67,7 @@ using namespace alize;
 
 //-------------------------------------------------------------------------
 LabelServer::LabelServer(bool usePredefinedLabels)
-:Object(), _first(0), _lastAdded(0)
+:Object(), _first(0), _lastAdded(0), _revision(0)
 {
   if (usePredefinedLabels)
   {
@@ -79,6 +79,32 @@ LabelServer::LabelServer(bool usePredefinedLabels)
   _first = size();
 }
 //-------------------------------------------------------------------------
+// Key of a label in the index : the length of the string makes it unique
+//-------------------------------------------------------------------------
+string LabelServer::getKey(const Label& l) // private
+{
+  return std::to_string(l.getString().size()) + ":" + l.getString()
+         + l.getSourceName();
+}
+//-------------------------------------------------------------------------
+// Index of the first label identical to l, or -1
+//-------------------------------------------------------------------------
+long LabelServer::findLabel(const Label& l) const // private
+{
+  std::map<string, unsigned long>::const_iterator it
+                                                = _indexMap.find(getKey(l));
+  if (it == _indexMap.end())
+    return -1;
+  return (long)it->second;
+}
+//-------------------------------------------------------------------------
+void LabelServer::updateIndex() const // private
+{
+  _indexMap.clear();
+  for (unsigned long i=0; i<size(); i++)
+    _indexMap.insert(std::make_pair(getKey(getLabel(i)), i));
+}
+//-------------------------------------------------------------------------
 unsigned long LabelServer::addLabel(const Label& l, bool forceAdd)
 {
   if (size() != 0 && !forceAdd)
@@ -87,19 +113,17 @@ unsigned long LabelServer::addLabel(const Label& l, bool forceAdd)
     if (l == getLabel(_lastAdded)) // operator!= overloaded
       return _lastAdded;
     // search for an identical label
-    unsigned long s = size();
-    for (unsigned long i=0; i<s; i++)
+    const long i = findLabel(l);
+    if (i != -1)
     {
-      if (getLabel(i) == l) // if an identical label exists
-      {
-        _lastAdded = i;
-        return _lastAdded;
-      }
+      _lastAdded = (unsigned long)i;
+      return _lastAdded;
     }
   }
   // adds a new label
   _vect.addObject(l.duplicate());
   _lastAdded = size()-1;
+  _indexMap.insert(std::make_pair(getKey(l), _lastAdded)); // first index
   return _lastAdded;
 }
 //-------------------------------------------------------------------------
@@ -107,9 +131,11 @@ void LabelServer::setLabel(const Label& l, unsigned long i) const
 {
   delete &_vect.getObject(i); // can throw IndexOutOfBoundsException
   _vect.setObject(l.duplicate(), i);
+  updateIndex();
+  _revision++;
 }
 //-------------------------------------------------------------------------
-Label& LabelServer::getLabel(unsigned long index) const
+const Label& LabelServer::getLabel(unsigned long index) const
 {
   return _vect.getObject(index);
   // can throw IndexOutOfBoundsException
@@ -129,10 +155,15 @@ void LabelServer::clear(bool deletePreDefined)
   if (deletePreDefined)
     _first = 0;
   _vect.deleteAllObjects(_first);
+  updateIndex();
+  _lastAdded = 0;
+  _revision++;
 }
 //-------------------------------------------------------------------------
 unsigned long LabelServer::size() const { return _vect.size(); }
 //-------------------------------------------------------------------------
+unsigned long long LabelServer::getRevision() const { return _revision; }
+//-------------------------------------------------------------------------
 string LabelServer::getClassName() const { return "LabelServer"; }
 //-------------------------------------------------------------------------
 LabelServer::~LabelServer() { clear(true); }
@@ -0,0 +1,247 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_LinearScorer_cpp)
+#define ALIZE_LinearScorer_cpp
+
+#include <new>
+#include <cstring>
+#include "LinearScorer.h"
+#include "MixtureGD.h"
+#include "DistribGD.h"
+#include "GDGemm.h"
+#include "MeanOffsetStore.h"
+#include "FeatureInputStream.h"
+#include "Config.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef LinearScorer L;
+
+//-------------------------------------------------------------------------
+L::LinearScorer(const Config& c, StatServer& ss, const MixtureGD& world)
+:Object(), _world(world), _extractor(c, ss, 1),
+ _rowSize(world.getDistribCount()*(world.getVectSize()+1)),
+ _targetCount(0), _targetCapacity(0)
+{
+  _extractor.setCentered(true);
+}
+//-------------------------------------------------------------------------
+unsigned long L::addTarget(const MixtureGD& m)
+{
+  const unsigned long distribCount = _world.getDistribCount();
+  const unsigned long vectSize = _world.getVectSize();
+  if (m.getDistribCount() != distribCount || m.getVectSize() != vectSize)
+    throw Exception("LinearScorer : the model '" + m.getId() + "' has not"
+                    " the dimensions of the world model", __FILE__, __LINE__);
+  DoubleVector offsets(distribCount*vectSize, distribCount*vectSize);
+  real_t* p = offsets.getArray();
+  for (unsigned long c=0; c<distribCount; c++, p+=vectSize)
+  {
+    const real_t* wMeanVect = _world.getDistrib(c).getMeanVect().getArray();
+    const real_t* meanVect = m.getDistrib(c).getMeanVect().getArray();
+    for (unsigned long i=0; i<vectSize; i++)
+      p[i] = meanVect[i] - wMeanVect[i];
+  }
+  return addTarget(m.getId(), offsets.getArray());
+}
+//-------------------------------------------------------------------------
+unsigned long L::addTargets(const MeanOffsetStore& s)
+{
+  const unsigned long distribCount = _world.getDistribCount();
+  const unsigned long vectSize = _world.getVectSize();
+  if (s.getWorld().getDistribCount() != distribCount
+      || s.getWorld().getVectSize() != vectSize)
+    throw Exception("LinearScorer : the world model of the store has not"
+                    " the dimensions of the world model", __FILE__, __LINE__);
+  const unsigned long first = _targetCount;
+  DoubleVector offsets(distribCount*vectSize, distribCount*vectSize);
+  for (unsigned long k=0; k<s.getModelCount(); k++)
+  {
+    s.getOffsets(k, offsets.getArray());
+    addTarget(s.getModelId(k), offsets.getArray());
+  }
+  return first;
+}
+//-------------------------------------------------------------------------
+unsigned long L::addTarget(const string& id, const real_t* offsets) // private
+{
+  const unsigned long distribCount = _world.getDistribCount();
+  const unsigned long vectSize = _world.getVectSize();
+  if (_targetCount == _targetCapacity)
+  {
+    _targetCapacity = _targetCapacity != 0 ? 2*_targetCapacity : 16;
+    _targetArray.setSize(_targetCapacity*_rowSize);
+  }
+  // [covInv d (distribCount*vectSize) | -0.5 d' covInv d (distribCount)]
+  real_t* row = _targetArray.getArray() + _targetCount*_rowSize;
+  real_t* q = row + distribCount*vectSize;
+  for (unsigned long c=0; c<distribCount; c++, row+=vectSize,
+       offsets+=vectSize)
+  {
+    const real_t* covInvVect =
+      _world.getDistrib(c).getCovInvVect().getArray();
+    real_t s = 0.0;
+    for (unsigned long i=0; i<vectSize; i++)
+    {
+      row[i] = covInvVect[i]*offsets[i];
+      s += row[i]*offsets[i];
+    }
+    q[c] = -0.5*s;
+  }
+  _targetIds.addElement(id);
+  return _targetCount++;
+}
+//-------------------------------------------------------------------------
+void L::resetTargets()
+{
+  _targetCount = 0;
+  _targetIds.reset();
+}
+//-------------------------------------------------------------------------
+unsigned long L::getTargetCount() const { return _targetCount; }
+//-------------------------------------------------------------------------
+const string& L::getTargetId(unsigned long k) const
+{
+  assertIsInBounds(__FILE__, __LINE__, k, _targetCount);
+  return _targetIds.getElement(k, false);
+}
+//-------------------------------------------------------------------------
+unsigned long L::getTestStatSize() const { return _rowSize; }
+//-------------------------------------------------------------------------
+unsigned long L::computeTestStat(FeatureInputStream& fs, DoubleVector& stat)
+{
+  const unsigned long distribCount = _world.getDistribCount();
+  const unsigned long fSize = distribCount*_world.getVectSize();
+  const unsigned long n = _extractor.extract(_world, fs, _nVect, _fMatrix);
+  // [F | N] / frameCount
+  const double a = n != 0 ? 1.0/(double)n : 0.0;
+  stat.setSize(_rowSize);
+  real_t* p = stat.getArray();
+  const real_t* f = _fMatrix.getArray();
+  for (unsigned long i=0; i<fSize; i++)
+    p[i] = a*f[i];
+  for (unsigned long c=0; c<distribCount; c++)
+    p[fSize+c] = a*_nVect[c];
+  return n;
+}
+//-------------------------------------------------------------------------
+void L::score(const DoubleVector& stat, DoubleVector& scores) const
+{
+  if (stat.size() != _rowSize)
+    throw Exception("LinearScorer : wrong size of the test statistics",
+                    __FILE__, __LINE__);
+  scores.setSize(_targetCount);
+  if (_targetCount != 0)
+    GDGemm::multiply(_targetCount, 1, _rowSize, _targetArray.getArray(),
+                     _rowSize, stat.getArray(), 1, scores.getArray(), 1);
+}
+//-------------------------------------------------------------------------
+unsigned long L::score(FeatureInputStream& fs, DoubleVector& scores)
+{
+  DoubleVector stat;
+  const unsigned long n = computeTestStat(fs, stat);
+  score(stat, scores);
+  return n;
+}
+//-------------------------------------------------------------------------
+void L::score(const DoubleMatrix& n, const DoubleMatrix& f,
+              const DoubleVector& frameCounts, DoubleMatrix& scores) const
+{
+  const unsigned long testCount = n.rows();
+  const unsigned long distribCount = _world.getDistribCount();
+  const unsigned long fSize = distribCount*_world.getVectSize();
+  if (n.cols() != distribCount || f.cols() != fSize
+      || f.rows() != testCount || frameCounts.size() != testCount)
+    throw Exception("LinearScorer : wrong dimensions of the test"
+                    " statistics", __FILE__, __LINE__);
+  // [F | N] / frameCount, transposed (rowSize x tests)
+  DoubleMatrix stat(_rowSize, testCount);
+  real_t* p = stat.getArray();
+  for (unsigned long t=0; t<testCount; t++)
+  {
+    const double a = frameCounts[t] != 0.0 ? 1.0/frameCounts[t] : 0.0;
+    const real_t* pf = f.getArray() + t*fSize;
+    const real_t* pn = n.getArray() + t*distribCount;
+    for (unsigned long i=0; i<fSize; i++)
+      p[i*testCount+t] = a*pf[i];
+    for (unsigned long c=0; c<distribCount; c++)
+      p[(fSize+c)*testCount+t] = a*pn[c];
+  }
+  // (targets x tests), then transposed
+  DoubleMatrix s(_targetCount, testCount);
+  if (_targetCount != 0 && testCount != 0)
+    GDGemm::multiply(_targetCount, testCount, _rowSize,
+                     _targetArray.getArray(), _rowSize, p, testCount,
+                     s.getArray(), testCount);
+  scores.setDimensions(testCount, _targetCount);
+  for (unsigned long t=0; t<testCount; t++)
+    for (unsigned long k=0; k<_targetCount; k++)
+      scores(t, k) = s(k, t);
+}
+//-------------------------------------------------------------------------
+string L::getClassName() const { return "LinearScorer"; }
+//-------------------------------------------------------------------------
+string L::toString() const
+{
+  return Object::toString()
+    + "\n  world       = '" + _world.getId() + "'"
+    + "\n  targetCount = " + std::to_string(_targetCount);
+}
+//-------------------------------------------------------------------------
+L::~LinearScorer() {}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_LinearScorer_cpp)
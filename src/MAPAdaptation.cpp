@@ -0,0 +1,318 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_MAPAdaptation_cpp)
+#define ALIZE_MAPAdaptation_cpp
+
+#include <new>
+#include <set>
+#include "MAPAdaptation.h"
+#include "StatServer.h"
+#include "MixtureServer.h"
+#include "MixtureGD.h"
+#include "MixtureGDStat.h"
+#include "DistribGD.h"
+#include "GDAccumulator.h"
+#include "FeatureBlock.h"
+#include "FeatureServer.h"
+#include "Config.h"
+#include "XList.h"
+#include "XLine.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef MAPAdaptation P;
+
+// frames read at a time for a speaker
+static const unsigned long FRAME_BLOCK = 512;
+
+//-------------------------------------------------------------------------
+P::MAPAdaptation(const Config& c, StatServer& ss, MixtureServer& ms,
+                 unsigned long threadCount)
+:Object(), _config(c), _statServer(ss), _mixtureServer(ms),
+ _pool(ThreadPool::getThreadCount(c, threadCount)), _relevanceFactor(16.0),
+ _adaptWeight(c.existsParam("MAPAdaptWeight")
+              && c.getBooleanParam("MAPAdaptWeight")),
+ _adaptVar(c.existsParam("MAPAdaptVar") && c.getBooleanParam("MAPAdaptVar"))
+{
+  if (c.existsParam("MAPRelevanceFactor"))
+    setRelevanceFactor(c.getFloatParam("MAPRelevanceFactor"));
+}
+//-------------------------------------------------------------------------
+void P::setRelevanceFactor(real_t r)
+{
+  if (!(r > 0.0))
+    throw Exception("The relevance factor must be > 0", __FILE__, __LINE__);
+  _relevanceFactor = r;
+}
+//-------------------------------------------------------------------------
+real_t P::getRelevanceFactor() const { return _relevanceFactor; }
+//-------------------------------------------------------------------------
+void P::setAdaptedParams(bool weight, bool var)
+{
+  _adaptWeight = weight;
+  _adaptVar = var;
+}
+//-------------------------------------------------------------------------
+bool P::isWeightAdapted() const { return _adaptWeight; }
+//-------------------------------------------------------------------------
+bool P::isVarAdapted() const { return _adaptVar; }
+//-------------------------------------------------------------------------
+void P::adapt(MixtureGD& model, const MixtureGD& world,
+              const GDAccumulator& a) const
+{
+  const unsigned long distribCount = world.getDistribCount();
+  const unsigned long vectSize = world.getVectSize();
+  if (model.getDistribCount() != distribCount
+      || model.getVectSize() != vectSize
+      || a.getDistribCount() != distribCount || a.getVectSize() != vectSize)
+    throw Exception("MAPAdaptation : incompatible dimensions",
+                    __FILE__, __LINE__);
+  const occ_t* occVect = a.getZeroOrderArray();
+  const real_t frameCount = a.getFeatureCount();
+  const bool adaptWeight = _adaptWeight && frameCount > 0.0;
+  weight_t totWeight = 0.0;
+
+  for (unsigned long c=0; c<distribCount; c++)
+  {
+    const occ_t occ = occVect[c];
+    const real_t alpha = occ/(occ + _relevanceFactor);
+    const DistribGD& u = world.getDistrib(c);
+    DistribGD& d = model.getDistrib(c);
+    const real_t* uMeanVect = u.getMeanVect().getArray();
+    const real_t* uCovVect = u.getCovVect().getArray();
+    real_t* dMeanVect = d.getMeanVect().getArray();
+    real_t* dCovVect = d.getCovVect().getArray();
+    const weight_t w = world.weight(c);
+
+    if (occ > 0.0)
+    {
+      const real_t* first = a.getFirstOrder(c);
+      const real_t* second = a.getSecondOrder(c);
+      for (unsigned long i=0; i<vectSize; i++)
+      {
+        const real_t mu = uMeanVect[i];
+        const real_t mean = alpha*first[i]/occ + (1.0-alpha)*mu;
+        real_t cov = uCovVect[i];
+        if (_adaptVar)
+        {
+          cov = alpha*second[i]/occ + (1.0-alpha)*(cov + mu*mu)
+                - mean*mean;
+          if (cov < MIN_COV)
+            cov = MIN_COV;
+        }
+        dMeanVect[i] = mean;
+        dCovVect[i] = cov;
+      }
+    }
+    else if (&d != &u)
+      d = u;
+    d.computeAll();
+    model.weight(c) = adaptWeight ?
+                      alpha*occ/frameCount + (1.0-alpha)*w : w;
+    totWeight += model.weight(c);
+  }
+  if (adaptWeight)
+    for (unsigned long c=0; c<distribCount; c++)
+      model.weight(c) /= totWeight;
+}
+//-------------------------------------------------------------------------
+MixtureGD& P::getModel(const MixtureGD& world, const string& id) // private
+{
+  const long idx = _mixtureServer.getMixtureIndex(id);
+  if (idx == -1)
+  {
+    MixtureGD& m = _mixtureServer.duplicateMixture(world, DUPL_DISTRIB);
+    _mixtureServer.setMixtureId(m, id);
+    return m;
+  }
+  Mixture& m = _mixtureServer.getMixture(idx);
+  if (m.getType() != DistribType_GD
+      || m.getDistribCount() != world.getDistribCount()
+      || m.getVectSize() != world.getVectSize())
+    throw Exception("MAPAdaptation : the model '" + id + "' has not the"
+                    " dimensions of the world model", __FILE__, __LINE__);
+  if (&m == &world)
+    throw Exception("MAPAdaptation : the model '" + id + "' is the world"
+                    " model", __FILE__, __LINE__);
+  // the tasks write the distributions of their model : the shared ones
+  // are duplicated (references of a distribution owned by the model :
+  // the dictionary of the server and the model)
+  MixtureGD& model = static_cast<MixtureGD&>(m);
+  for (unsigned long c=0; c<model.getDistribCount(); c++)
+  {
+    DistribGD& d = model.getDistrib(c);
+    if (d.refCounter(K::k) > 2)
+      _mixtureServer.setDistribToMixture(model,
+                     _mixtureServer.duplicateDistrib(d), model.weight(c), c);
+  }
+  return model;
+}
+//-------------------------------------------------------------------------
+unsigned long P::adapt(const MixtureGD& world, const XList& list)
+{
+  const unsigned long threadCount = _pool.getThreadCount();
+  const unsigned long modelCount = list.getLineCount();
+  unsigned long t, total = 0;
+
+  // the models, the file names and the configurations are prepared by
+  // this thread
+  MixtureGD** modelArray = new (std::nothrow) MixtureGD*[modelCount];
+  assertMemoryIsAllocated(modelArray, __FILE__, __LINE__);
+  XLine* fileArray = new (std::nothrow) XLine[modelCount];
+  assertMemoryIsAllocated(fileArray, __FILE__, __LINE__);
+  unsigned long* countArray = new (std::nothrow) unsigned long[modelCount];
+  assertMemoryIsAllocated(countArray, __FILE__, __LINE__);
+  Config** configArray = new (std::nothrow) Config*[threadCount];
+  assertMemoryIsAllocated(configArray, __FILE__, __LINE__);
+  MixtureGDStat** accArray = new (std::nothrow) MixtureGDStat*[threadCount];
+  assertMemoryIsAllocated(accArray, __FILE__, __LINE__);
+  for (t=0; t<threadCount; t++)
+  {
+    configArray[t] = NULL;
+    accArray[t] = NULL;
+  }
+
+  try
+  {
+    std::set<const MixtureGD*> models;
+    for (unsigned long s=0; s<modelCount; s++)
+    {
+      const XLine& l = list.getLine(s);
+      const unsigned long n = l.getElementCount();
+      if (n == 0)
+        throw Exception("MAPAdaptation : no model id", __FILE__, __LINE__);
+      const string& id = l.getElement(0, false);
+      modelArray[s] = &getModel(world, id);
+      if (!models.insert(modelArray[s]).second)
+        throw Exception("MAPAdaptation : the model '" + id + "' appears"
+                        " twice in the list", __FILE__, __LINE__);
+      for (unsigned long i=1; i<n; i++)
+        fileArray[s].addElement(l.getElement(i, false));
+      countArray[s] = 0;
+    }
+    world.getPacked();
+    for (t=0; t<threadCount; t++)
+    {
+      configArray[t] = new (std::nothrow) Config(_config);
+      assertMemoryIsAllocated(configArray[t], __FILE__, __LINE__);
+      accArray[t] = &static_cast<MixtureGDStat&>(
+                     static_cast<const Mixture&>(world)
+                     .createNewMixtureStatObject(K::k, _statServer, _config));
+    }
+    _pool.run(modelCount, [&](unsigned long s, unsigned long t)
+    {
+      MixtureGDStat& acc = *accArray[t];
+      acc.resetEM();
+      if (fileArray[s].getElementCount() != 0)
+      {
+        FeatureServer fs(*configArray[t], fileArray[s]);
+        FeatureBlock b;
+        unsigned long n;
+        while ((n = fs.readFeatures(b, FRAME_BLOCK)) != 0)
+        {
+          acc.computeAndAccumulateEM(b);
+          countArray[s] += n;
+        }
+      }
+      adapt(*modelArray[s], world, acc.getAccumulator());
+    });
+  }
+  catch (...)
+  {
+    for (t=0; t<threadCount; t++)
+    {
+      delete accArray[t];
+      delete configArray[t];
+    }
+    delete[] accArray;
+    delete[] configArray;
+    delete[] countArray;
+    delete[] fileArray;
+    delete[] modelArray;
+    throw;
+  }
+  for (unsigned long s=0; s<modelCount; s++)
+    total += countArray[s];
+  for (t=0; t<threadCount; t++)
+  {
+    delete accArray[t];
+    delete configArray[t];
+  }
+  delete[] accArray;
+  delete[] configArray;
+  delete[] countArray;
+  delete[] fileArray;
+  delete[] modelArray;
+  return total;
+}
+//-------------------------------------------------------------------------
+unsigned long P::getThreadCount() const { return _pool.getThreadCount(); }
+//-------------------------------------------------------------------------
+string P::getClassName() const { return "MAPAdaptation"; }
+//-------------------------------------------------------------------------
+string P::toString() const
+{
+  return Object::toString()
+    + "\n  threadCount     = " + std::to_string(_pool.getThreadCount())
+    + "\n  relevanceFactor = " + std::to_string(_relevanceFactor)
+    + "\n  adaptWeight     = " + (_adaptWeight ? "true" : "false")
+    + "\n  adaptVar        = " + (_adaptVar ? "true" : "false");
+}
+//-------------------------------------------------------------------------
+P::~MAPAdaptation() {}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_MAPAdaptation_cpp)
@@ -0,0 +1,188 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_MappedFile_cpp)
+#define ALIZE_MappedFile_cpp
+
+#if defined(_WIN32)
+  #define _CRT_SECURE_NO_WARNINGS
+  #include <windows.h>
+#elif defined(linux) || defined(__linux) || defined(__CYGWIN__) || defined(__APPLE__)
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#else
+  #error "Unsupported OS\n"
+#endif
+
+#include <new>
+#include <cstdio>
+#include "MappedFile.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef MappedFile M;
+
+//-------------------------------------------------------------------------
+M::MappedFile(const FileName& f)
+:Object(), _fileName(f), _data(NULL), _length(0), _mapped(false),
+ _handle(NULL)
+{
+#if defined(_WIN32)
+  HANDLE file = ::CreateFileA(f.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                  NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    throw FileNotFoundException("", __FILE__, __LINE__, f);
+  LARGE_INTEGER size;
+  if (!::GetFileSizeEx(file, &size))
+  {
+    ::CloseHandle(file);
+    throw IOException("Cannot get the file size", __FILE__, __LINE__, f);
+  }
+  _length = (unsigned long)size.QuadPart;
+  if (_length != 0)
+  {
+    HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0,
+                                          NULL);
+    if (mapping != NULL)
+    {
+      _data = static_cast<const char*>(::MapViewOfFile(mapping,
+                                       FILE_MAP_READ, 0, 0, 0));
+      if (_data != NULL)
+      {
+        _handle = mapping;
+        _mapped = true;
+      }
+      else
+        ::CloseHandle(mapping);
+    }
+  }
+  ::CloseHandle(file);
+#else
+  const int fd = ::open(f.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw FileNotFoundException("", __FILE__, __LINE__, f);
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    throw IOException("Cannot get the file size", __FILE__, __LINE__, f);
+  }
+  _length = (unsigned long)st.st_size;
+  if (_length != 0)
+  {
+    void* p = ::mmap(NULL, _length, PROT_READ, MAP_SHARED, fd, 0);
+    if (p != MAP_FAILED)
+    {
+      _data = static_cast<const char*>(p);
+      _mapped = true;
+    }
+  }
+  ::close(fd);
+#endif
+  if (_length != 0 && !_mapped) // the file is read into memory
+  {
+    char* p = new (std::nothrow) char[_length];
+    assertMemoryIsAllocated(p, __FILE__, __LINE__);
+    FILE* file = ::fopen(f.c_str(), "rb");
+    if (file == NULL || ::fread(p, 1, _length, file) != _length)
+    {
+      if (file != NULL)
+        ::fclose(file);
+      delete[] p;
+      throw IOException("Cannot read the file", __FILE__, __LINE__, f);
+    }
+    ::fclose(file);
+    _data = p;
+  }
+}
+//-------------------------------------------------------------------------
+const char* M::getData() const { return _data; }
+//-------------------------------------------------------------------------
+unsigned long M::getLength() const { return _length; }
+//-------------------------------------------------------------------------
+bool M::isMapped() const { return _mapped; }
+//-------------------------------------------------------------------------
+const FileName& M::getFileName() const { return _fileName; }
+//-------------------------------------------------------------------------
+string M::getClassName() const { return "MappedFile"; }
+//-------------------------------------------------------------------------
+string M::toString() const
+{
+  return Object::toString()
+    + "\n  fileName = '" + _fileName + "'"
+    + "\n  length   = " + std::to_string(_length)
+    + "\n  mapped   = " + (_mapped ? "true" : "false");
+}
+//-------------------------------------------------------------------------
+M::~MappedFile()
+{
+  if (!_mapped)
+    delete[] _data;
+#if defined(_WIN32)
+  else
+  {
+    ::UnmapViewOfFile(_data);
+    ::CloseHandle(static_cast<HANDLE>(_handle));
+  }
+#else
+  else
+    ::munmap(const_cast<char*>(_data), _length);
+#endif
+}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_MappedFile_cpp)
@@ -0,0 +1,502 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_MeanOffsetStore_cpp)
+#define ALIZE_MeanOffsetStore_cpp
+
+#if defined(_WIN32)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cerrno>
+#include "MeanOffsetStore.h"
+#include "MixtureGD.h"
+#include "DistribGD.h"
+#include "MixtureServer.h"
+#include "MappedFile.h"
+#include "XmlParser.h"
+#include "Config.h"
+#include "Exception.h"
+#include "string_util.h"
+
+using namespace alize;
+using namespace std;
+typedef MeanOffsetStore S;
+
+static const char MOS_MAGIC[8] = {'A','L','I','Z','E','M','O','S'};
+static const uint32_t MOS_VERSION = 1;
+static const uint32_t MOS_BYTE_ORDER_MARK = 0x01020304;
+static const unsigned long long MOS_SINGLE_PRECISION = 1;
+
+struct MOSHeader // 64 bytes
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  unsigned long long distribCount;
+  unsigned long long vectSize;
+  unsigned long long modelCount;
+  unsigned long long flags;
+  char     unused[16];
+};
+
+namespace
+{
+  //-----------------------------------------------------------------------
+  // reads the XML format from the content of a file
+  //-----------------------------------------------------------------------
+  class MeanOffsetXmlReader : private XmlParser
+  {
+  public :
+    MeanOffsetXmlReader(const MappedFile& file, const FileName& f,
+                        MeanOffsetStore& s)
+    :Object(), XmlParser(), _data(file.getData()),
+     _length(file.getLength()), _pos(0), _line(1), _fileName(f),
+     _store(s), _vectSize(s.getWorld().getVectSize()),
+     _offsets(s.getWorld().getDistribCount()*_vectSize,
+              s.getWorld().getDistribCount()*_vectSize) {}
+
+    void read() { parse(); }
+
+    virtual std::string getClassName() const
+    { return "MeanOffsetXmlReader"; }
+
+  private :
+    const char*      _data;
+    unsigned long    _length;
+    unsigned long    _pos;
+    unsigned long    _line;
+    const FileName&  _fileName;
+    MeanOffsetStore& _store;
+    unsigned long    _vectSize;
+    std::string      _char;
+    std::string      _id;
+    DoubleVector     _offsets;
+
+    virtual const std::string& readOneChar()
+    {
+      if (_pos == _length)
+        eventError("Unexpected end of file");
+      _char.assign(1, _data[_pos++]);
+      if (_char == "\n")
+        _line++;
+      return _char;
+    }
+    virtual void eventOpeningElement(const std::string& path)
+    {
+      if (endsWith(path, "<model>"))
+        _id.clear();
+    }
+    virtual void eventClosingElement(const std::string& path,
+                                     const std::string& value)
+    {
+      if (endsWith(path, "<MeanOffsetStore><version>"))
+      {
+        if (value != "1")
+          eventError("invalid version");
+      }
+      else if (endsWith(path, "<MeanOffsetStore><distribCount>"))
+      {
+        if (toCount(value) != _store.getWorld().getDistribCount())
+          eventError("distribCount different from the world model");
+      }
+      else if (endsWith(path, "<MeanOffsetStore><vectSize>"))
+      {
+        if (toCount(value) != _vectSize)
+          eventError("vectSize different from the world model");
+      }
+      else if (endsWith(path, "<model><id>"))
+        _id = value;
+      else if (endsWith(path, "<MeanOffsetStore><model>"))
+      {
+        const char* p = value.c_str();
+        char* end;
+        real_t* offsets = _offsets.getArray();
+        for (unsigned long i=0; i<_offsets.size(); i++, p=end)
+        {
+          offsets[i] = strtod(p, &end);
+          if (end == p)
+            eventError("Missing offsets for the model '" + _id + "'");
+        }
+        if (!isBlank(p))
+          eventError("Too many offsets for the model '" + _id + "'");
+        _store.addModel(_id, offsets);
+      }
+    }
+    virtual void eventError(const std::string& msg)
+    {
+      throw InvalidDataException("Error line " + std::to_string(_line)
+        + " : " + msg, __FILE__, __LINE__, _fileName);
+    }
+    static bool isBlank(const char* p)
+    {
+      while (isspace((unsigned char)*p))
+        p++;
+      return *p == 0;
+    }
+    // value of an element which contains a count : digits only
+    unsigned long toCount(const std::string& value)
+    {
+      const char* p = value.c_str();
+      while (isspace((unsigned char)*p))
+        p++;
+      char* end = const_cast<char*>(p);
+      errno = 0;
+      const unsigned long n = isdigit((unsigned char)*p) ?
+                              strtoul(p, &end, 10) : 0;
+      if (end == p || errno == ERANGE || !isBlank(end))
+        eventError("invalid count '" + value + "'");
+      return n;
+    }
+  };
+}
+//-------------------------------------------------------------------------
+S::MeanOffsetStore(const MixtureGD& world, bool singlePrecision)
+:Object(), _world(world), _singlePrecision(singlePrecision),
+ _offsetCount(world.getDistribCount()*world.getVectSize()),
+ _modelCount(0), _capacity(0) {}
+//-------------------------------------------------------------------------
+const MixtureGD& S::getWorld() const { return _world; }
+//-------------------------------------------------------------------------
+bool S::isSinglePrecision() const { return _singlePrecision; }
+//-------------------------------------------------------------------------
+unsigned long S::addModel(const MixtureGD& m)
+{
+  const unsigned long distribCount = _world.getDistribCount();
+  const unsigned long vectSize = _world.getVectSize();
+  if (m.getDistribCount() != distribCount || m.getVectSize() != vectSize)
+    throw Exception("MeanOffsetStore : the model '" + m.getId() + "' has"
+                    " not the dimensions of the world model",
+                    __FILE__, __LINE__);
+  DoubleVector offsets(_offsetCount, _offsetCount);
+  real_t* p = offsets.getArray();
+  for (unsigned long c=0; c<distribCount; c++, p+=vectSize)
+  {
+    const real_t* meanVect = m.getDistrib(c).getMeanVect().getArray();
+    const real_t* wMeanVect = _world.getDistrib(c).getMeanVect().getArray();
+    for (unsigned long i=0; i<vectSize; i++)
+      p[i] = meanVect[i] - wMeanVect[i];
+  }
+  return addModel(m.getId(), offsets.getArray());
+}
+//-------------------------------------------------------------------------
+unsigned long S::addModel(const string& id, const real_t* offsets)
+{
+  unsigned long k;
+  std::map<string, unsigned long>::const_iterator it = _indexMap.find(id);
+  if (it != _indexMap.end())
+    k = it->second;
+  else
+  {
+    if (_modelCount == _capacity)
+    {
+      _capacity = _capacity != 0 ? 2*_capacity : 16;
+      if (_singlePrecision)
+        _floatArray.setSize(_capacity*_offsetCount);
+      else
+        _doubleArray.setSize(_capacity*_offsetCount);
+    }
+    k = _modelCount++;
+    _ids.addElement(id);
+    _indexMap[id] = k;
+  }
+  if (_singlePrecision)
+  {
+    float* p = _floatArray.getArray() + k*_offsetCount;
+    for (unsigned long i=0; i<_offsetCount; i++)
+      p[i] = (float)offsets[i];
+  }
+  else
+    memcpy(_doubleArray.getArray() + k*_offsetCount, offsets,
+           _offsetCount*sizeof(real_t));
+  return k;
+}
+//-------------------------------------------------------------------------
+void S::reset()
+{
+  _modelCount = 0;
+  _ids.reset();
+  _indexMap.clear();
+}
+//-------------------------------------------------------------------------
+unsigned long S::getModelCount() const { return _modelCount; }
+//-------------------------------------------------------------------------
+const string& S::getModelId(unsigned long k) const
+{
+  assertIsInBounds(__FILE__, __LINE__, k, _modelCount);
+  return _ids.getElement(k, false);
+}
+//-------------------------------------------------------------------------
+long S::getModelIndex(const string& id) const
+{
+  std::map<string, unsigned long>::const_iterator it = _indexMap.find(id);
+  return it != _indexMap.end() ? (long)it->second : -1;
+}
+//-------------------------------------------------------------------------
+void S::getOffsets(unsigned long k, real_t* offsets) const
+{
+  assertIsInBounds(__FILE__, __LINE__, k, _modelCount);
+  if (_singlePrecision)
+  {
+    const float* p = _floatArray.getArray() + k*_offsetCount;
+    for (unsigned long i=0; i<_offsetCount; i++)
+      offsets[i] = p[i];
+  }
+  else
+    memcpy(offsets, _doubleArray.getArray() + k*_offsetCount,
+           _offsetCount*sizeof(real_t));
+}
+//-------------------------------------------------------------------------
+void S::getModel(unsigned long k, MixtureGD& m) const
+{
+  const unsigned long distribCount = _world.getDistribCount();
+  const unsigned long vectSize = _world.getVectSize();
+  if (m.getDistribCount() != distribCount || m.getVectSize() != vectSize)
+    throw Exception("MeanOffsetStore : the mixture '" + m.getId() + "' has"
+                    " not the dimensions of the world model",
+                    __FILE__, __LINE__);
+  DoubleVector offsets(_offsetCount, _offsetCount);
+  getOffsets(k, offsets.getArray());
+  const real_t* p = offsets.getArray();
+  for (unsigned long c=0; c<distribCount; c++, p+=vectSize)
+  {
+    const DistribGD& w = _world.getDistrib(c);
+    DistribGD& d = m.getDistrib(c);
+    d = w;
+    real_t* meanVect = d.getMeanVect().getArray();
+    for (unsigned long i=0; i<vectSize; i++)
+      meanVect[i] += p[i];
+    d.computeAll();
+    m.weight(c) = _world.weight(c);
+  }
+}
+//-------------------------------------------------------------------------
+MixtureGD& S::createModel(unsigned long k, MixtureServer& ms) const
+{
+  assertIsInBounds(__FILE__, __LINE__, k, _modelCount);
+  MixtureGD& m = ms.duplicateMixture(_world, DUPL_DISTRIB);
+  ms.setMixtureId(m, getModelId(k));
+  getModel(k, m);
+  return m;
+}
+//-------------------------------------------------------------------------
+void S::save(const FileName& f, const Config& c) const
+{
+  const FileName fileName = beginsWith(f, "/") || beginsWith(f, "./") ? f
+      : c.getParam_mixtureFilesPath() + f
+        + c.getParam_saveMixtureFileExtension();
+  MixtureFileWriterFormat format;
+  if (!c.existsParam_saveMixtureFileFormat && endsWith(fileName, ".xml"))
+    format = MixtureFileWriterFormat_XML;
+  else
+    format = c.getParam_saveMixtureFileFormat();
+  if (format != MixtureFileWriterFormat_XML
+      && format != MixtureFileWriterFormat_RAW)
+    throw Exception("MeanOffsetStore : only the formats RAW and XML are"
+                    " supported", __FILE__, __LINE__);
+  // the ids are written as they are in the XML attributes (the parser
+  // does not decode the entities)
+  if (format == MixtureFileWriterFormat_XML)
+    for (unsigned long k=0; k<_modelCount; k++)
+      if (getModelId(k).find_first_of("\"<&") != string::npos)
+        throw Exception("MeanOffsetStore : the model id '" + getModelId(k)
+                        + "' cannot be saved in XML", __FILE__, __LINE__);
+
+  FILE* file = ::fopen(fileName.c_str(), "wb");
+  if (file == NULL)
+    throw IOException("Cannot create new file", __FILE__, __LINE__,
+                      fileName);
+  DoubleVector offsets(_offsetCount, _offsetCount);
+  bool ok;
+  if (format == MixtureFileWriterFormat_RAW)
+  {
+    MOSHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, MOS_MAGIC, sizeof(MOS_MAGIC));
+    h.version = MOS_VERSION;
+    h.byteOrderMark = MOS_BYTE_ORDER_MARK;
+    h.distribCount = _world.getDistribCount();
+    h.vectSize = _world.getVectSize();
+    h.modelCount = _modelCount;
+    h.flags = _singlePrecision ? MOS_SINGLE_PRECISION : 0;
+    ok = ::fwrite(&h, sizeof(h), 1, file) == 1;
+    for (unsigned long k=0; ok && k<_modelCount; k++)
+    {
+      const string& id = getModelId(k);
+      const unsigned long long length = id.size();
+      const char pad[8] = {0};
+      const size_t padSize = (8-id.size()%8)%8;
+      ok = ::fwrite(&length, sizeof(length), 1, file) == 1
+        && ::fwrite(id.data(), 1, id.size(), file) == id.size()
+        && ::fwrite(pad, 1, padSize, file) == padSize
+        && (_singlePrecision ?
+            ::fwrite(_floatArray.getArray() + k*_offsetCount, sizeof(float),
+                     _offsetCount, file) == _offsetCount
+          : ::fwrite(_doubleArray.getArray() + k*_offsetCount,
+                     sizeof(double), _offsetCount, file) == _offsetCount);
+    }
+  }
+  else
+  {
+    ok = ::fprintf(file, "<MeanOffsetStore version=\"1\" distribCount=\"%lu\""
+                   " vectSize=\"%lu\" singlePrecision=\"%s\">",
+                   _world.getDistribCount(), _world.getVectSize(),
+                   _singlePrecision ? "true" : "false") > 0;
+    // 9 or 17 digits : the values read are the values written
+    const char* fmt = _singlePrecision ? " %.9g" : " %.17g";
+    for (unsigned long k=0; ok && k<_modelCount; k++)
+    {
+      getOffsets(k, offsets.getArray());
+      ok = ::fprintf(file, "\n\t<model id=\"%s\">",
+                     getModelId(k).c_str()) > 0;
+      for (unsigned long i=0; ok && i<_offsetCount; i++)
+        ok = ::fprintf(file, fmt, offsets[i]) > 0;
+      ok = ok && ::fprintf(file, "</model>") > 0;
+    }
+    ok = ok && ::fprintf(file, "\n</MeanOffsetStore>\n") > 0;
+  }
+  if (::fclose(file) != 0 || !ok)
+    throw IOException("Cannot write in file", __FILE__, __LINE__, fileName);
+}
+//-------------------------------------------------------------------------
+void S::load(const FileName& f, const Config& c)
+{
+  const FileName fileName = beginsWith(f, "/") || beginsWith(f, "./") ? f
+      : c.getParam_mixtureFilesPath() + f
+        + c.getParam_loadMixtureFileExtension();
+  MappedFile file(fileName);
+  if (file.getLength() >= sizeof(MOS_MAGIC)
+      && memcmp(file.getData(), MOS_MAGIC, sizeof(MOS_MAGIC)) == 0)
+    loadRaw(fileName);
+  else
+    loadXml(fileName);
+}
+//-------------------------------------------------------------------------
+void S::loadRaw(const FileName& f) // private
+{
+  MappedFile file(f);
+  const char* p = file.getData();
+  const char* end = p + file.getLength();
+  MOSHeader h;
+  if (file.getLength() < sizeof(h))
+    throw InvalidDataException("Wrong size", __FILE__, __LINE__, f);
+  memcpy(&h, p, sizeof(h));
+  p += sizeof(h);
+  if (h.version != MOS_VERSION || h.byteOrderMark != MOS_BYTE_ORDER_MARK)
+    throw InvalidDataException("Wrong version or byte order",
+                               __FILE__, __LINE__, f);
+  if (h.distribCount != _world.getDistribCount()
+      || h.vectSize != _world.getVectSize())
+    throw InvalidDataException("Dimensions different from the world model",
+                               __FILE__, __LINE__, f);
+  const bool single = (h.flags & MOS_SINGLE_PRECISION) != 0;
+  const unsigned long size = _offsetCount*(single ? sizeof(float)
+                                                  : sizeof(double));
+  DoubleVector offsets(_offsetCount, _offsetCount);
+  FloatVector floatOffsets(_offsetCount, _offsetCount);
+  for (unsigned long long k=0; k<h.modelCount; k++)
+  {
+    unsigned long long length;
+    if ((unsigned long)(end-p) < sizeof(length))
+      throw InvalidDataException("Wrong size", __FILE__, __LINE__, f);
+    memcpy(&length, p, sizeof(length));
+    p += sizeof(length);
+    if (length > (unsigned long)(end-p)) // before padding : no overflow
+      throw InvalidDataException("Wrong size", __FILE__, __LINE__, f);
+    const unsigned long padded = (unsigned long)(length+7)/8*8;
+    if (padded > (unsigned long)(end-p) || (unsigned long)(end-p) - padded
+        < size)
+      throw InvalidDataException("Wrong size", __FILE__, __LINE__, f);
+    const string id(p, (size_t)length);
+    p += padded;
+    if (single)
+    {
+      memcpy(floatOffsets.getArray(), p, size);
+      for (unsigned long i=0; i<_offsetCount; i++)
+        offsets[i] = floatOffsets[i];
+    }
+    else
+      memcpy(offsets.getArray(), p, size);
+    p += size;
+    addModel(id, offsets.getArray());
+  }
+  if (p != end)
+    throw InvalidDataException("Wrong size", __FILE__, __LINE__, f);
+}
+//-------------------------------------------------------------------------
+void S::loadXml(const FileName& f) // private
+{
+  MappedFile file(f);
+  MeanOffsetXmlReader(file, f, *this).read();
+}
+//-------------------------------------------------------------------------
+string S::getClassName() const { return "MeanOffsetStore"; }
+//-------------------------------------------------------------------------
+string S::toString() const
+{
+  return Object::toString()
+    + "\n  world           = '" + _world.getId() + "'"
+    + "\n  modelCount      = " + std::to_string(_modelCount)
+    + "\n  singlePrecision = " + (_singlePrecision ? "true" : "false");
+}
+//-------------------------------------------------------------------------
+S::~MeanOffsetStore() {}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_MeanOffsetStore_cpp)
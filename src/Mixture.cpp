@@ -69,7 +69,8 @@ typedef Mixture M;
 //-------------------------------------------------------------------------
 M::Mixture(const string& id, unsigned long distribCount, unsigned long v)
 :Object(), _vectSize(v), _weightVect(distribCount),
- _distribVect(distribCount), _id(id) {}
+ _distribVect(distribCount), _id(id), _revision(Distrib::newRevision(K::k))
+{}
 //-------------------------------------------------------------------------
 bool M::operator!=(const Mixture& m) const { return !(*this == m); }
 //-------------------------------------------------------------------------
@@ -115,6 +116,7 @@ void M::removeAllDistrib(const K&)
 {
   _distribVect.clear();
   _weightVect.clear();
+  _revision = Distrib::newRevision(K::k);
 }
 //-------------------------------------------------------------------------
 Mixture& M::duplicate(const K&, DuplDistrib d) const
@@ -123,12 +125,14 @@ Mixture& M::duplicate(const K&, DuplDistrib d) const
 void M::setDistrib(const K&, Distrib& d, unsigned long i)
 {
   _distribVect.setDistrib(d, i); // can throw IndexOutOfBoundsException
+  _revision = Distrib::newRevision(K::k);
 }
 //-------------------------------------------------------------------------
 void M::addDistrib(const K&, Distrib& d, weight_t w)
 {
   _distribVect.addDistrib(d);
   _weightVect.addValue(w);
+  _revision = Distrib::newRevision(K::k);
 }
 //-------------------------------------------------------------------------
 Distrib& M::getDistrib(unsigned long i) const
@@ -137,7 +141,10 @@ Distrib& M::getDistrib(unsigned long i) const
 }
 //-------------------------------------------------------------------------
 weight_t& M::weight(unsigned long index)
-{ return _weightVect[index]; /* can throw IndexOutOfBoundsException */ }
+{
+  _revision = Distrib::newRevision(K::k);
+  return _weightVect[index]; /* can throw IndexOutOfBoundsException */
+}
 //-------------------------------------------------------------------------
 weight_t M::weight(unsigned long index) const
 { return _weightVect[index]; /* can throw IndexOutOfBoundsException */}
@@ -145,7 +152,11 @@ weight_t M::weight(unsigned long index) const
 void M::save(const FileName& f, const Config& c) const
 { MixtureFileWriter(f, c).writeMixture(*this); }
 //-------------------------------------------------------------------------
-DoubleVector& M::getTabWeight() { return _weightVect; }
+DoubleVector& M::getTabWeight()
+{
+  _revision = Distrib::newRevision(K::k);
+  return _weightVect;
+}
 //-------------------------------------------------------------------------
 const DoubleVector& M::getTabWeight() const { return _weightVect; }
 //-------------------------------------------------------------------------
@@ -158,6 +169,8 @@ void M::setId(const K&, const string& id) { _id = id; }
 //-------------------------------------------------------------------------
 void M::setId(const string& id) { _id = id; }
 //-------------------------------------------------------------------------
+unsigned long long M::getRevision() const { return _revision; }
+//-------------------------------------------------------------------------
 unsigned long M::getDistribCount() const
 { return _distribVect.size(); }
 //-------------------------------------------------------------------------
@@ -61,6 +61,7 @@
 #include "Exception.h"
 #include "MixtureStat.h"
 #include "MixtureGDStat.h"
+#include "MixtureGDPacked.h"
 //#include "Config.h"
 
 //#include <iostream>
@@ -71,7 +72,7 @@ using namespace alize;
 
 //-------------------------------------------------------------------------
 MixtureGD::MixtureGD(const string& id, unsigned long vs, unsigned long dc)
-:Mixture(id, dc, vs)
+:Mixture(id, dc, vs), _pPacked(NULL)
 {
   for (unsigned long c=0; c<dc; c++)
   { Mixture::addDistrib(K::k, DistribGD::create(K::k, _vectSize)); }
@@ -88,7 +89,7 @@ MixtureGD::MixtureGD(const string& id, unsigned long vs, unsigned long dc)
 }*/
 //-------------------------------------------------------------------------
 MixtureGD::MixtureGD(const MixtureGD& m)
-:Mixture(m._id, m.getDistribCount(), m._vectSize)
+:Mixture(m._id, m.getDistribCount(), m._vectSize), _pPacked(NULL)
 {
   // Attention : les distributions ne sont pas copiees, la copie pointe sur
   // les mêmes distributions que l'original <FRANCAIS>
@@ -221,6 +222,26 @@ MixtureStat& MixtureGD::createNewMixtureStatObject(const K&,
 //-------------------------------------------------------------------------
 DistribType MixtureGD::getType() const { return DistribType_GD; }
 //-------------------------------------------------------------------------
+const MixtureGDPacked& MixtureGD::getPacked() const
+{
+  std::lock_guard<std::mutex> lock(_packedMutex);
+  if (_pPacked == NULL)
+  {
+    _pPacked = new (std::nothrow) MixtureGDPacked(*this);
+    assertMemoryIsAllocated(_pPacked, __FILE__, __LINE__);
+  }
+  else if (!_pPacked->isUpToDate(*this))
+    _pPacked->update(*this);
+  return *_pPacked;
+}
+//-------------------------------------------------------------------------
+void MixtureGD::releasePacked() const
+{
+  std::lock_guard<std::mutex> lock(_packedMutex);
+  delete _pPacked;
+  _pPacked = NULL;
+}
+//-------------------------------------------------------------------------
 string MixtureGD::getClassName() const { return "MixtureGD"; }
 //-------------------------------------------------------------------------
 string MixtureGD::toString() const
@@ -240,7 +261,7 @@ string MixtureGD::toString() const
   return s;
 }
 //-------------------------------------------------------------------------
-MixtureGD::~MixtureGD() {}
+MixtureGD::~MixtureGD() { delete _pPacked; }
 //-------------------------------------------------------------------------
 
 #endif // !defined(ALIZE_MixtureGD_cpp)
@@ -0,0 +1,249 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_MixtureGDPacked_cpp)
+#define ALIZE_MixtureGDPacked_cpp
+
+#include <new>
+#include <cmath>
+#include "MixtureGDPacked.h"
+#include "MixtureGD.h"
+#include "DistribGD.h"
+#include "GDKernel.h"
+#include "Feature.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef MixtureGDPacked P;
+
+const unsigned long P::ALIGNMENT = 64;
+// widest register : 2 x 8 doubles (AVX-512)
+static const unsigned long DISTRIB_BLOCK = 16;
+
+//-------------------------------------------------------------------------
+P::MixtureGDPacked(const MixtureGD& m)
+:Object(), _distribCount(0), _vectSize(0), _stride(0), _meanArray(NULL),
+ _covInvArray(NULL), _meanCovInvArray(NULL), _gemmArray(NULL),
+ _cstArray(NULL),
+ _logCstArray(NULL), _weightArray(NULL), _logWeightArray(NULL),
+ _distribArray(NULL), _revision(0), _checkedRevision(0)
+{ update(m); }
+//-------------------------------------------------------------------------
+void P::update(const MixtureGD& m)
+{
+  const unsigned long distribCount = m.getDistribCount();
+  const unsigned long vectSize = m.getVectSize();
+  const unsigned long stride = (distribCount+DISTRIB_BLOCK-1)
+                               /DISTRIB_BLOCK*DISTRIB_BLOCK;
+  unsigned long c, i;
+
+  // modifications made during the packing will be seen by isUpToDate()
+  _revision = _checkedRevision = Distrib::getLastRevision();
+
+  if (_meanArray == NULL || stride != _stride || vectSize != _vectSize
+      || distribCount != _distribCount)
+  {
+    freeArrays();
+    _meanArray       = GDKernel::createAlignedArray(vectSize*stride);
+    _covInvArray     = GDKernel::createAlignedArray(vectSize*stride);
+    _meanCovInvArray = GDKernel::createAlignedArray(vectSize*stride);
+    _gemmArray       = GDKernel::createAlignedArray((2*vectSize+1)*stride);
+    _cstArray        = GDKernel::createAlignedArray(stride);
+    _logCstArray     = GDKernel::createAlignedArray(stride);
+    _weightArray     = GDKernel::createAlignedArray(stride);
+    _logWeightArray  = GDKernel::createAlignedArray(stride);
+    _distribArray = new (std::nothrow) const Distrib*[stride];
+    assertMemoryIsAllocated(_distribArray, __FILE__, __LINE__);
+  }
+  _distribCount = distribCount;
+  _vectSize = vectSize;
+  _stride = stride;
+
+  for (c=0; c<distribCount; c++)
+  {
+    const DistribGD& d = m.getDistrib(c);
+    const real_t* mean = d.getMeanVect().getArray();
+    const real_t* covInv = d.getCovInvVect().getArray();
+    for (i=0; i<vectSize; i++)
+    {
+      _meanArray[i*stride+c] = mean[i];
+      _covInvArray[i*stride+c] = covInv[i];
+      _meanCovInvArray[i*stride+c] = mean[i]*covInv[i];
+    }
+    _cstArray[c] = d.getCst();
+    _logCstArray[c] = _cstArray[c] > 0.0 ? log(_cstArray[c])
+                                          : GDKernel::LOG_ZERO;
+    _weightArray[c] = m.weight(c);
+    _logWeightArray[c] = _weightArray[c] > 0.0 ? log(_weightArray[c])
+                                                : GDKernel::LOG_ZERO;
+    _distribArray[c] = &d;
+    real_t k = 0.0;
+    for (i=0; i<vectSize; i++)
+    {
+      _gemmArray[i*stride+c] = -0.5*covInv[i];
+      _gemmArray[(vectSize+i)*stride+c] = _meanCovInvArray[i*stride+c];
+      k += mean[i]*_meanCovInvArray[i*stride+c];
+    }
+    _gemmArray[2*vectSize*stride+c] =
+        (_logCstArray[c] == GDKernel::LOG_ZERO
+         || _logWeightArray[c] == GDKernel::LOG_ZERO) ? GDKernel::LOG_ZERO
+        : _logWeightArray[c] + _logCstArray[c] - 0.5*k;
+  }
+  for (c=distribCount; c<stride; c++) // padding
+  {
+    for (i=0; i<vectSize; i++)
+      _meanArray[i*stride+c] = _covInvArray[i*stride+c]
+                             = _meanCovInvArray[i*stride+c] = 0.0;
+    for (i=0; i<2*vectSize; i++)
+      _gemmArray[i*stride+c] = 0.0;
+    _gemmArray[2*vectSize*stride+c] = GDKernel::LOG_ZERO;
+    _cstArray[c] = _weightArray[c] = 0.0;
+    _logCstArray[c] = _logWeightArray[c] = GDKernel::LOG_ZERO;
+    _distribArray[c] = NULL;
+  }
+}
+//-------------------------------------------------------------------------
+bool P::isUpToDate(const MixtureGD& m) const
+{
+  const unsigned long long lastRevision = Distrib::getLastRevision();
+  if (lastRevision == _checkedRevision) // nothing modified at all
+    return true;
+  if (m.getRevision() > _revision || m.getDistribCount() != _distribCount
+      || m.getVectSize() != _vectSize)
+    return false;
+  Distrib** d = m.getTabDistrib();
+  for (unsigned long c=0; c<_distribCount; c++)
+    if (d[c] != _distribArray[c] || d[c]->getRevision() > _revision)
+      return false;
+  _checkedRevision = lastRevision;
+  return true;
+}
+//-------------------------------------------------------------------------
+void P::computeWeightedLK(const Feature& f, lk_t* lk) const
+{
+  if (f.getVectSize() != _vectSize)
+    throw Exception("distrib vectSize ("
+        + std::to_string(_vectSize) + ") != feature vectSize ("
+      + std::to_string(f.getVectSize()) + ")", __FILE__, __LINE__);
+  GDKernel::computeWeightedLK(*this, f.getDataVector(), 1, lk);
+}
+//-------------------------------------------------------------------------
+void P::computeWeightedLogLK(const Feature& f, lk_t* llk) const
+{
+  if (f.getVectSize() != _vectSize)
+    throw Exception("distrib vectSize ("
+        + std::to_string(_vectSize) + ") != feature vectSize ("
+      + std::to_string(f.getVectSize()) + ")", __FILE__, __LINE__);
+  GDKernel::computeWeightedLogLK(*this, f.getDataVector(), 1, llk);
+}
+//-------------------------------------------------------------------------
+void P::computeWeightedLK(const float* x, lk_t* lk) const
+{ GDKernel::computeWeightedLK(*this, x, 1, lk); }
+//-------------------------------------------------------------------------
+void P::computeWeightedLogLK(const float* x, lk_t* llk) const
+{ GDKernel::computeWeightedLogLK(*this, x, 1, llk); }
+//-------------------------------------------------------------------------
+unsigned long P::getDistribCount() const { return _distribCount; }
+//-------------------------------------------------------------------------
+unsigned long P::getVectSize() const { return _vectSize; }
+//-------------------------------------------------------------------------
+unsigned long P::getStride() const { return _stride; }
+//-------------------------------------------------------------------------
+const real_t* P::getMeanArray() const { return _meanArray; }
+//-------------------------------------------------------------------------
+const real_t* P::getCovInvArray() const { return _covInvArray; }
+//-------------------------------------------------------------------------
+const real_t* P::getMeanCovInvArray() const { return _meanCovInvArray; }
+//-------------------------------------------------------------------------
+const real_t* P::getGemmArray() const { return _gemmArray; }
+//-------------------------------------------------------------------------
+const real_t* P::getLogCstArray() const { return _logCstArray; }
+//-------------------------------------------------------------------------
+const weight_t* P::getLogWeightArray() const { return _logWeightArray; }
+//-------------------------------------------------------------------------
+const real_t* P::getCstArray() const { return _cstArray; }
+//-------------------------------------------------------------------------
+const weight_t* P::getWeightArray() const { return _weightArray; }
+//-------------------------------------------------------------------------
+void P::freeArrays()
+{
+  GDKernel::deleteAlignedArray(_meanArray);
+  GDKernel::deleteAlignedArray(_covInvArray);
+  GDKernel::deleteAlignedArray(_meanCovInvArray);
+  GDKernel::deleteAlignedArray(_gemmArray);
+  GDKernel::deleteAlignedArray(_cstArray);
+  GDKernel::deleteAlignedArray(_logCstArray);
+  GDKernel::deleteAlignedArray(_weightArray);
+  GDKernel::deleteAlignedArray(_logWeightArray);
+  delete[] _distribArray;
+  _meanArray = _covInvArray = _meanCovInvArray = _gemmArray = NULL;
+  _cstArray = _logCstArray = _weightArray = _logWeightArray = NULL;
+  _distribArray = NULL;
+}
+//-------------------------------------------------------------------------
+string P::getClassName() const { return "MixtureGDPacked"; }
+//-------------------------------------------------------------------------
+string P::toString() const
+{
+  return Object::toString()
+    + "\n  distribCount = " + std::to_string(_distribCount)
+    + "\n  vectSize     = " + std::to_string(_vectSize)
+    + "\n  stride       = " + std::to_string(_stride);
+}
+//-------------------------------------------------------------------------
+P::~MixtureGDPacked() { freeArrays(); }
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_MixtureGDPacked_cpp)
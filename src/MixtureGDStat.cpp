@@ -56,9 +56,13 @@
 #define ALIZE_MixtureGDStat_cpp
 
 #include <new>
+#include <cstring>
+#include <cmath>
 #include "MixtureGDStat.h"
 
 #include "Feature.h"
+#include "FeatureBlock.h"
+#include "GDGemm.h"
 #include "DistribGD.h"
 #include "Mixture.h"
 #include "MixtureGD.h"
@@ -70,9 +74,15 @@ using namespace std;
 using namespace alize;
 typedef MixtureGDStat M;
 
+// frames of a block processed together by computeAndAccumulateEM()
+static const unsigned long EM_BLOCK = 256;
+
 //-------------------------------------------------------------------------
 M::MixtureGDStat(const K&, StatServer& ss, const MixtureGD& m, const Config& c)
-:MixtureStat(ss, m, c), _pMixForAccumulation(NULL), _pMixtureForEM(NULL) {}
+:MixtureStat(ss, m, c), _accum(), _pMixtureForEM(NULL),
+ _pMixForAccumulation(NULL), _onlineStepExponent(0.6),
+ _onlineStepOffset(2.0), _onlineStepDefined(false), _onlineStepCount(0),
+ _onlineStep(0.0), _onlineLLK(0.0), _onlineLLKWeight(0.0) {}
 //-------------------------------------------------------------------------
 MixtureGDStat& M::create(const K&, StatServer& ss,
                                      const MixtureGD& m, const Config& c)
@@ -87,24 +97,22 @@ void M::resetEM()
   assert(_pMixture->getDistribCount() == _distribCount);
   resetOcc();
 
-  // copy the original mixture and its ditributions
-  if (_pMixtureForEM != NULL)
-    delete _pMixtureForEM;
-  _pMixtureForEM = &static_cast<MixtureGD&>(_pMixture->duplicate(K::k,
-                                            DUPL_DISTRIB));
-  // create and initialize a temporary mixtureGD to accumulate cov and mean
-  if (_pMixForAccumulation != NULL)
-    delete _pMixForAccumulation;
-  _pMixForAccumulation = &MixtureGD::create(K::k, "",
-                      _pMixtureForEM->getVectSize(),
-                      _pMixtureForEM->getDistribCount());
-  for (unsigned long c=0; c<_distribCount; c++)
+  // the accumulators and the mixture given by getEM() are reused
+  const unsigned long vectSize = _pMixture->getVectSize();
+  if (_accum.isExact() != isDeterministicAccumulationActive())
+    _accum.setExact(isDeterministicAccumulationActive());
+  _accum.setDimensions(_distribCount, vectSize);
+  if (_pMixtureForEM != NULL &&
+      (_pMixtureForEM->getDistribCount() != _distribCount
+       || _pMixtureForEM->getVectSize() != vectSize))
   {
-    DistribGD& d = _pMixForAccumulation->getDistrib(c);
-    d.getMeanVect().setAllValues(0.0);
-    d.getCovVect().setAllValues(0.0);
+    delete _pMixtureForEM;
+    _pMixtureForEM = NULL;
   }
-  _featureCounterForEM = 0.0;
+  if (_pMixtureForEM == NULL)
+    _pMixtureForEM = &static_cast<MixtureGD&>(_pMixture->duplicate(K::k,
+                                              DUPL_DISTRIB));
+  resetEMFeatureCount();
   _resetedEM = true;
 }
 //-------------------------------------------------------------------------
@@ -113,24 +121,133 @@ occ_t M::computeAndAccumulateEM(const Feature& f, double w)
   assertResetEMDone();
   real_t sum = computeAndAccumulateOcc(f, w);
 
-  Feature::data_t* dataVect = f.getDataVector();
-  real_t t, *meanVect, *covVect;
-  unsigned long vectSize = _pMixture->getVectSize();
+  const Feature::data_t* dataVect = f.getDataVector();
+  const occ_t* occVect = _occVect.getArray();
 
-  for (unsigned long c=0; c<_distribCount; c++)
+  // with pruned posteriors, only the kept distributions are updated
+  const bool pruned = isPosteriorPruningActive();
+  const unsigned long count = pruned ? _occIndexCount : _distribCount;
+  const unsigned long* idx = _occIndexVect.getArray();
+
+  for (unsigned long j=0; j<count; j++)
   {
-    DistribGD& d = _pMixForAccumulation->getDistrib(c);
-    meanVect = d.getMeanVect().getArray();
-    covVect  = d.getCovVect().getArray();
-    
-    for (unsigned long i=0; i<vectSize; i++)
+    const unsigned long c = pruned ? idx[j] : j;
+    _accum.accumulate(c, occVect[c], dataVect);
+  }
+  _accum.addFeatureCount(w);
+  addEMFeatureCount(w);
+  return sum;
+}
+//-------------------------------------------------------------------------
+occ_t M::computeAndAccumulateEM(const FeatureBlock& b, double w)
+{
+  assertResetEMDone();
+  const unsigned long vectSize = _pMixture->getVectSize();
+  const unsigned long frameCount = b.getFrameCount();
+  if (frameCount == 0)
+    return 0.0;
+  if (b.getVectSize() != vectSize)
+    throw Exception("distrib vectSize (" + std::to_string(vectSize)
+        + ") != block vectSize (" + std::to_string(b.getVectSize()) + ")",
+        __FILE__, __LINE__);
+  const unsigned long k = 2*vectSize+1;
+  const unsigned long nMax = frameCount < EM_BLOCK ? frameCount : EM_BLOCK;
+  _occBlock.setSize(nMax*_distribCount);
+  _occTBlock.setSize(nMax*_distribCount);
+  _dataBlock.setSize(nMax*k);
+  _statBlock.setSize(_distribCount*k);
+  occ_t* occ = _occBlock.getArray();
+  occ_t* occT = _occTBlock.getArray();
+  real_t* data = _dataBlock.getArray();
+  real_t* stat = _statBlock.getArray();
+  occ_t sum = 0.0;
+  unsigned long n, c, i;
+
+  for (unsigned long n0=0; n0<frameCount; n0+=EM_BLOCK)
+  {
+    const unsigned long nb = frameCount-n0 < EM_BLOCK ? frameCount-n0
+                                                       : EM_BLOCK;
+    const float* frames = b.getFrame(n0);
+    sum += computeOccBlock(frames, nb, occ);
+    if (isPosteriorPruningActive())
+    {
+      // few distributions per frame : frame by frame accumulation (the
+      // posteriors of a frame do not depend on the block)
+      unsigned long* idx = _occIndexVect.getArray();
+      for (n=0; n<nb; n++)
+      {
+        occ_t* row = occ + n*_distribCount;
+        const float* x = frames + n*vectSize;
+        addPrunedOcc(w*pruneOcc(row, idx, _occIndexCount));
+        for (unsigned long j=0; j<_occIndexCount; j++)
+        {
+          c = idx[j];
+          const occ_t o = row[c] * w;
+          _accum.accumulate(c, o, x);
+          addOcc(c, o);
+        }
+        addOccFeatureCount(w);
+        addEMFeatureCount(w);
+        _accum.addFeatureCount(w);
+      }
+      continue;
+    }
+    if (isDeterministicAccumulationActive())
+    {
+      // exact sums of the same products as frame by frame, vectorized
+      // for each distribution
+      for (n=0; n<nb; n++)
+      {
+        for (c=0; c<_distribCount; c++)
+          occT[c*nb+n] = occ[n*_distribCount+c] * w;
+        addOccFeatureCount(w);
+        addEMFeatureCount(w);
+        _accum.addFeatureCount(w);
+      }
+      for (c=0; c<_distribCount; c++)
+      {
+        _accum.accumulate(c, occT + c*nb, frames, nb);
+        addOcc(c, occT + c*nb, nb);
+      }
+      continue;
+    }
+    _featureCounterForAccumulatedOcc += w*nb;
+    _featureCounterForEM += w*nb;
+    _accum.addFeatureCount(w*nb);
+    for (n=0; n<nb; n++)
     {
-      t = _occVect[c] * dataVect[i];
-      covVect[i]  += t * dataVect[i];
-      meanVect[i] += t;
+      for (c=0; c<_distribCount; c++)
+        occT[c*nb+n] = occ[n*_distribCount+c] * w;
+      const float* x = frames + n*vectSize;
+      real_t* row = data + n*k;
+      for (i=0; i<vectSize; i++)
+      {
+        row[i] = x[i];
+        row[vectSize+i] = row[i]*row[i];
+      }
+      row[2*vectSize] = 1.0;
+    }
+    GDGemm::multiply(_distribCount, k, nb, occT, nb, data, k, stat, k);
+    occ_t* zero = _accum.getZeroOrderArray();
+    const unsigned long stride = _accum.getStride();
+    for (c=0; c<_distribCount; c++)
+    {
+      real_t* first = _accum.getFirstOrderArray() + c*stride;
+      real_t* second = _accum.getSecondOrderArray() + c*stride;
+      const real_t* s = stat + c*k;
+      for (i=0; i<vectSize; i++)
+      {
+        first[i]  += s[i];
+        second[i] += s[vectSize+i];
+      }
+      zero[c] += s[2*vectSize];
+      _accumulatedOccVect[c] += s[2*vectSize];
     }
   }
-  _featureCounterForEM += w;
+  // occupations of the last frame, like the frame by frame version
+  const unsigned long last = (frameCount-1) % EM_BLOCK;
+  for (c=0; c<_distribCount; c++)
+    _occVect[c] = occ[last*_distribCount+c] * w;
   return sum;
 }
 //-------------------------------------------------------------------------
@@ -143,17 +260,8 @@ void M::addAccEM(const MixtureStat& mx)
     throw Exception("MixtureStat incompatibility", __FILE__, __LINE__);
   const MixtureGDStat& m = static_cast<const MixtureGDStat&>(mx);
 
-  _accumulatedOccVect += m._accumulatedOccVect;
-  _featureCounterForAccumulatedOcc += m._featureCounterForAccumulatedOcc;
-
-  for (unsigned long c=0; c<_distribCount; c++)
-  {
-    DistribGD& d = _pMixForAccumulation->getDistrib(c);
-    const DistribGD& d2 = m._pMixForAccumulation->getDistrib(c);
-    d.getCovVect() += d2.getCovVect();
-    d.getMeanVect() += d2.getMeanVect();
-  }
-  _featureCounterForEM += m._featureCounterForEM;
+  addAccOcc(m);
+  _accum.add(m._accum);
 }
 //-------------------------------------------------------------------------
 const Mixture& M::getEM()
@@ -161,48 +269,233 @@ const Mixture& M::getEM()
   assertResetEMDone();
   unsigned long c;
 
-  occ_t totOcc = _accumulatedOccVect.computeSum();
-  unsigned long vectSize = _pMixture->getVectSize();
+  const occ_t* occVect = _accum.getZeroOrderArray();
+  occ_t totOcc = 0.0;
+  for (c=0; c<_distribCount; c++)
+    totOcc += occVect[c];
 
   for (c=0; c<_distribCount; c++)
+    estimateDistrib(c, occVect[c], _accum.getFirstOrder(c),
+                    _accum.getSecondOrder(c), totOcc);
+  return *_pMixtureForEM;
+}
+//-------------------------------------------------------------------------
+// sets the distribution c of _pMixtureForEM and its weight from its
+// statistics
+//-------------------------------------------------------------------------
+void M::estimateDistrib(unsigned long c, occ_t occ, const real_t* first,
+                        const real_t* second, occ_t totOcc) // private
+{
+  const unsigned long vectSize = _pMixture->getVectSize();
+  DistribGD& d  = _pMixtureForEM->getDistrib(c);
+  if (occ > 0.0)
   {
-    const occ_t occ = _accumulatedOccVect[c];
-    if (occ > 0.0)
-    {
-      DistribGD& dTmp = _pMixForAccumulation->getDistrib(c);
-      real_t* dTmpCovVect  = dTmp.getCovVect().getArray();
-      real_t* dTmpMeanVect = dTmp.getMeanVect().getArray();
+    real_t* dCovVect   = d.getCovVect().getArray();
+    real_t* dMeanVect  = d.getMeanVect().getArray();
 
-      DistribGD& d  = _pMixtureForEM->getDistrib(c);
-      real_t* dCovVect   = d.getCovVect().getArray();
-      real_t* dMeanVect  = d.getMeanVect().getArray();
-
-      real_t mean, cov;
+    real_t mean, cov;
 
+    for (unsigned long i=0; i<vectSize; i++)
+    {
+      mean = first[i] / occ;
+      cov  = second[i] / occ - mean * mean;
+      if (cov >MIN_COV)
+        dCovVect [i] = cov;
+      else
+        dCovVect [i] = MIN_COV;
+      dMeanVect[i] = mean;
+    }
+    _pMixtureForEM->weight(c) = occ/totOcc;
+    d.computeAll();
+  }
+  else // not observed : parameters of the original mixture
+  {
+    const MixtureGD& m = static_cast<const MixtureGD&>(*_pMixture);
+    d = m.getDistrib(c);
+    _pMixtureForEM->weight(c) = m.weight(c);
+  }
+}
+//-------------------------------------------------------------------------
+void M::setOnlineEMStep(real_t exponent, real_t offset)
+{
+  if (!(exponent > 0.5 && exponent <= 1.0) || !(offset >= 1.0))
+    throw Exception("Wrong online EM step (exponent in ]0.5, 1],"
+                    " offset >= 1)", __FILE__, __LINE__);
+  _onlineStepExponent = exponent;
+  _onlineStepOffset = offset;
+  _onlineStepDefined = true;
+}
+//-------------------------------------------------------------------------
+void M::resetOnlineEM()
+{
+  // the parameters are only read (and checked) for an online EM
+  if (!_onlineStepDefined)
+    setOnlineEMStep(_config.existsParam("onlineEMStepExponent") ?
+                    _config.getFloatParam("onlineEMStepExponent") : 0.6,
+                    _config.existsParam("onlineEMStepOffset") ?
+                    _config.getFloatParam("onlineEMStepOffset") : 2.0);
+  resetEM();
+  resetLLK();
+  // statistics of one frame of the current mixture
+  const MixtureGD& m = static_cast<const MixtureGD&>(*_pMixture);
+  const unsigned long vectSize = m.getVectSize();
+  const unsigned long rowSize = 2*vectSize+1;
+  _onlineStat.setSize(_distribCount*rowSize);
+  real_t* s = _onlineStat.getArray();
+  for (unsigned long c=0; c<_distribCount; c++, s+=rowSize)
+  {
+    const DistribGD& d = m.getDistrib(c);
+    const real_t* meanVect = d.getMeanVect().getArray();
+    const real_t* covVect = d.getCovVect().getArray();
+    const weight_t w = m.weight(c);
+    s[0] = w;
+    for (unsigned long i=0; i<vectSize; i++)
+    {
+      s[1+i] = w*meanVect[i];
+      s[1+vectSize+i] = w*(covVect[i] + meanVect[i]*meanVect[i]);
+    }
+  }
+  _onlineStepCount = 0;
+  _onlineStep = 0.0;
+  _onlineLLK = 0.0;
+  _onlineLLKWeight = 0.0;
+}
+//-------------------------------------------------------------------------
+const Mixture& M::updateOnlineEM()
+{
+  assertResetEMDone();
+  const unsigned long vectSize = _pMixture->getVectSize();
+  const unsigned long rowSize = 2*vectSize+1;
+  if (_onlineStat.size() != _distribCount*rowSize)
+    throw Exception("resetOnlineEM() must be called beforehand",
+                    __FILE__, __LINE__);
+  const real_t frameCount = _accum.getFeatureCount();
+  if (frameCount > 0.0) // else the mini-batch is ignored
+  {
+    const real_t step = pow(_onlineStepCount + _onlineStepOffset,
+                            -_onlineStepExponent);
+    const real_t keep = 1.0 - step;
+    const real_t a = step/frameCount;
+    const occ_t* occVect = _accum.getZeroOrderArray();
+    real_t* s = _onlineStat.getArray();
+    for (unsigned long c=0; c<_distribCount; c++, s+=rowSize)
+    {
+      const real_t* first = _accum.getFirstOrder(c);
+      const real_t* second = _accum.getSecondOrder(c);
+      s[0] = keep*s[0] + a*occVect[c];
       for (unsigned long i=0; i<vectSize; i++)
       {
-        mean = dTmpMeanVect[i] / occ;
-        cov  = dTmpCovVect [i] / occ - mean * mean;
-        if (cov >MIN_COV)
-          dCovVect [i] = cov;
-        else
-          dCovVect [i] = MIN_COV;
-        dMeanVect[i] = mean;
+        s[1+i] = keep*s[1+i] + a*first[i];
+        s[1+vectSize+i] = keep*s[1+vectSize+i] + a*second[i];
       }
-      _pMixtureForEM->weight(c) = occ/totOcc;
-      d.computeAll();
     }
+    if (getAccumulatedLLKFeatureCount() > 0.0)
+    {
+      _onlineLLK = keep*_onlineLLK + step*getMeanLLK();
+      _onlineLLKWeight = keep*_onlineLLKWeight + step;
+    }
+    _onlineStep = step;
+    _onlineStepCount++;
   }
+  const real_t* s = _onlineStat.getArray();
+  occ_t totOcc = 0.0;
+  for (unsigned long c=0; c<_distribCount; c++)
+    totOcc += s[c*rowSize];
+  for (unsigned long c=0; c<_distribCount; c++, s+=rowSize)
+    estimateDistrib(c, s[0], s+1, s+1+vectSize, totOcc);
+  resetEM();
+  resetLLK();
   return *_pMixtureForEM;
 }
 //-------------------------------------------------------------------------
-MixtureGD& M::getInternalAccumEM()
+unsigned long M::getOnlineEMStepCount() const { return _onlineStepCount; }
+//-------------------------------------------------------------------------
+real_t M::getOnlineEMStep() const { return _onlineStep; }
+//-------------------------------------------------------------------------
+lk_t M::getOnlineMeanLLK() const
+{
+  if (_onlineLLKWeight == 0.0)
+    throw Exception("No features -> no mean", __FILE__, __LINE__);
+  return _onlineLLK/_onlineLLKWeight;
+}
+//-------------------------------------------------------------------------
+const MixtureGD& M::getInternalAccumEM()
 {
   assertResetEMDone();
-  assert(_pMixForAccumulation != NULL);
+  const unsigned long vectSize = _pMixture->getVectSize();
+  if (_pMixForAccumulation != NULL &&
+      (_pMixForAccumulation->getDistribCount() != _distribCount
+       || _pMixForAccumulation->getVectSize() != vectSize))
+  {
+    delete _pMixForAccumulation;
+    _pMixForAccumulation = NULL;
+  }
+  if (_pMixForAccumulation == NULL)
+    _pMixForAccumulation = &MixtureGD::create(K::k, "", vectSize,
+                                              _distribCount);
+  for (unsigned long c=0; c<_distribCount; c++)
+  {
+    DistribGD& d = _pMixForAccumulation->getDistrib(c);
+    memcpy(d.getMeanVect().getArray(), _accum.getFirstOrder(c),
+           vectSize*sizeof(real_t));
+    memcpy(d.getCovVect().getArray(), _accum.getSecondOrder(c),
+           vectSize*sizeof(real_t));
+  }
   return *_pMixForAccumulation;
 }
 //-------------------------------------------------------------------------
+// saveAccEM() : zero order [distribCount], first and second order
+// [distribCount][vectSize] (rows not padded) and frame count, or the
+// exact sums of the accumulator (deterministic accumulation)
+//-------------------------------------------------------------------------
+unsigned long M::getAccEMSize() const // protected
+{
+  if (_accum.isExact())
+    return _accum.getExactStateSize();
+  return _distribCount*(1 + 2*_pMixture->getVectSize()) + 1;
+}
+//-------------------------------------------------------------------------
+void M::writeAccEM(double* p) const // protected
+{
+  if (_accum.isExact())
+  {
+    _accum.writeExactState(p);
+    return;
+  }
+  const unsigned long vectSize = _pMixture->getVectSize();
+  memcpy(p, _accum.getZeroOrderArray(), _distribCount*sizeof(double));
+  p += _distribCount;
+  for (unsigned long c=0; c<_distribCount; c++, p+=vectSize)
+    memcpy(p, _accum.getFirstOrder(c), vectSize*sizeof(double));
+  for (unsigned long c=0; c<_distribCount; c++, p+=vectSize)
+    memcpy(p, _accum.getSecondOrder(c), vectSize*sizeof(double));
+  *p = _accum.getFeatureCount();
+}
+//-------------------------------------------------------------------------
+void M::readAccEM(const double* p) // protected
+{
+  if (_accum.isExact())
+  {
+    _accum.readExactState(p);
+    return;
+  }
+  const unsigned long vectSize = _pMixture->getVectSize();
+  const unsigned long stride = _accum.getStride();
+  memcpy(_accum.getZeroOrderArray(), p, _distribCount*sizeof(double));
+  p += _distribCount;
+  for (unsigned long c=0; c<_distribCount; c++, p+=vectSize)
+    memcpy(_accum.getFirstOrderArray()+c*stride, p,
+           vectSize*sizeof(double));
+  for (unsigned long c=0; c<_distribCount; c++, p+=vectSize)
+    memcpy(_accum.getSecondOrderArray()+c*stride, p,
+           vectSize*sizeof(double));
+  _accum.setFeatureCount(*p);
+}
+//-------------------------------------------------------------------------
+GDAccumulator& M::getAccumulator() { return _accum; }
+//-------------------------------------------------------------------------
+const GDAccumulator& M::getAccumulator() const { return _accum; }
+//-------------------------------------------------------------------------
 string M::getClassName() const { return "MixtureGDStat"; }
 //-------------------------------------------------------------------------
 M::~MixtureGDStat()
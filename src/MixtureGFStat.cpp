@@ -56,6 +56,7 @@
 #define ALIZE_MixtureGFStat_cpp
 
 #include <new>
+#include <cstring>
 #include "MixtureGFStat.h"
 
 #include "Feature.h"
@@ -104,6 +105,7 @@ void M::resetEM()
   {
     DistribGF& d = _pMixForAccumulation->getDistrib(cc);
 
+    d.getCovMatrix().setSize(vectSize); // the matrix is created empty
     real_t* m = d.getMeanVect().getArray();	
     real_t* c = d.getCovMatrix().getArray();
 	
@@ -112,11 +114,10 @@ void M::resetEM()
       m[i] = 0.0;
       for (unsigned long j=0; j<vectSize; j++)
         c[i + j*vectSize] = 0.0;
-        c[0 + 0*vectSize] = 1e200; // to avoid throwing exception "Matrix is not positive definite"
     }
 	
   }
-  _featureCounterForEM = 0.0;
+  resetEMFeatureCount();
   _resetedEM = true;
 }
 
@@ -127,7 +128,6 @@ occ_t M::computeAndAccumulateEM(const Feature& f, double w)
   real_t sum = computeAndAccumulateOcc(f, w);
   Feature::data_t* dataVect = f.getDataVector();
   unsigned long vectSize = _pMixture->getVectSize();
-  unsigned long vectSize2 = vectSize*vectSize;
 
   for (unsigned long c=0; c<_distribCount; c++)
   {
@@ -139,11 +139,11 @@ occ_t M::computeAndAccumulateEM(const Feature& f, double w)
     {
       real_t mean = _occVect[c] * dataVect[i];
       dTmpMeanVect[i] += mean;
-      for (unsigned long j=i*vectSize; j<vectSize2; j += vectSize)
-        dTmpCovMatr[i+j]  += mean * dataVect[j];
+      for (unsigned long j=0; j<vectSize; j++)
+        dTmpCovMatr[i+j*vectSize] += mean * dataVect[j];
     }
   }
-    _featureCounterForEM += w;
+  addEMFeatureCount(w);
   return sum;
 }
 //-------------------------------------------------------------------------
@@ -154,24 +154,37 @@ void M::addAccEM(const MixtureStat& mx)
     throw Exception("MixtureStat incompatibility", __FILE__, __LINE__);
   if (p->_distribCount != _distribCount)
     throw Exception("MixtureStat incompatibility", __FILE__, __LINE__);
-  //const MixtureGFStat& m = static_cast<const MixtureGFStat&>(mx);
+  const MixtureGFStat& m = static_cast<const MixtureGFStat&>(mx);
+  const unsigned long vectSize = _pMixture->getVectSize();
+  const unsigned long vectSize2 = vectSize*vectSize;
+
+  addAccOcc(m);
 
-  throw Exception("unimplemented method :o(", __FILE__, __LINE__);
-  // TODO : implement this method
+  for (unsigned long c=0; c<_distribCount; c++)
+  {
+    DistribGF& d = _pMixForAccumulation->getDistrib(c);
+    const DistribGF& d2 = m._pMixForAccumulation->getDistrib(c);
+    d.getMeanVect() += d2.getMeanVect();
+    real_t* cov = d.getCovMatrix().getArray();
+    const real_t* cov2 = d2.getCovMatrix().getArray();
+    for (unsigned long i=0; i<vectSize2; i++)
+      cov[i] += cov2[i];
+  }
 }
 //-------------------------------------------------------------------------
 const Mixture& M::getEM()
 {
   assertResetEMDone();
   unsigned long vectSize = _pMixture->getVectSize();
-  unsigned long c, idx, vectSize2 = vectSize*vectSize;
+  unsigned long c, idx;
   occ_t occ, totOcc = 0.0;
   real_t* dTmpCovMatr;
   real_t* dTmpMeanVect;
   real_t* dCovMatr;
   real_t* dMeanVect;
-  real_t mean, mean2, cov;
+  real_t mean, cov;
 
+  synchronizeOcc();
   for (c=0; c<_distribCount; c++)
     totOcc += _accumulatedOccVect[c];
 
@@ -185,22 +198,22 @@ const Mixture& M::getEM()
       dTmpMeanVect = dTmp.getMeanVect().getArray();
 
       DistribGF& d = _pMixtureForEM->getDistrib(c);
+      d.getCovMatrix().setSize(vectSize); // removed by computeAll()
       dCovMatr  = d.getCovMatrix().getArray();
       dMeanVect = d.getMeanVect().getArray();
 
-
+      for (unsigned long i=0; i<vectSize; i++)
+        dMeanVect[i] = dTmpMeanVect[i] / occ;
       for (unsigned long i=0; i<vectSize; i++)
       {
-        dMeanVect[i] = mean = dTmpMeanVect[i] / occ;
-        mean2 = mean*mean;
-        for (unsigned long j=0; j<vectSize2; j += vectSize)
+        mean = dMeanVect[i];
+        for (unsigned long j=0; j<vectSize; j++)
         {
-          idx = i+j;
-          cov  = dTmpCovMatr[idx] / occ - mean2;
-          if (cov >= MIN_COV )
-            dCovMatr[idx] = cov;
-          else
-            dCovMatr[idx] = MIN_COV;
+          idx = i+j*vectSize;
+          cov = dTmpCovMatr[idx] / occ - mean*dMeanVect[j];
+          if (i == j && cov < MIN_COV)
+            cov = MIN_COV;
+          dCovMatr[idx] = cov;
         }
       }
       _pMixtureForEM->weight(c) = occ/totOcc;
@@ -217,6 +230,43 @@ MixtureGF& M::getInternalAccumEM()
   return *_pMixForAccumulation;
 }
 //-------------------------------------------------------------------------
+// saveAccEM() : mean accumulators [distribCount][vectSize] and covariance
+// accumulators [distribCount][vectSize*vectSize]
+//-------------------------------------------------------------------------
+unsigned long M::getAccEMSize() const // protected
+{
+  const unsigned long vectSize = _pMixture->getVectSize();
+  return _distribCount*vectSize*(1 + vectSize);
+}
+//-------------------------------------------------------------------------
+void M::writeAccEM(double* p) const // protected
+{
+  const unsigned long vectSize = _pMixture->getVectSize();
+  const unsigned long vectSize2 = vectSize*vectSize;
+  for (unsigned long c=0; c<_distribCount; c++)
+  {
+    const DistribGF& d = _pMixForAccumulation->getDistrib(c);
+    memcpy(p, d.getMeanVect().getArray(), vectSize*sizeof(double));
+    p += vectSize;
+    memcpy(p, d.getCovMatrix().getArray(), vectSize2*sizeof(double));
+    p += vectSize2;
+  }
+}
+//-------------------------------------------------------------------------
+void M::readAccEM(const double* p) // protected
+{
+  const unsigned long vectSize = _pMixture->getVectSize();
+  const unsigned long vectSize2 = vectSize*vectSize;
+  for (unsigned long c=0; c<_distribCount; c++)
+  {
+    DistribGF& d = _pMixForAccumulation->getDistrib(c);
+    memcpy(d.getMeanVect().getArray(), p, vectSize*sizeof(double));
+    p += vectSize;
+    memcpy(d.getCovMatrix().getArray(), p, vectSize2*sizeof(double));
+    p += vectSize2;
+  }
+}
+//-------------------------------------------------------------------------
 string M::getClassName() const { return "MixtureGFStat"; }
 //-------------------------------------------------------------------------
 M::~MixtureGFStat()
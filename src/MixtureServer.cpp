@@ -412,6 +412,26 @@ void S::deleteUnusedDistribs()
     _vectSizeDefined = false;
 }
 //-------------------------------------------------------------------------
+void S::updatePackedMixtures() const
+{
+  for (unsigned long i=0; i<getMixtureCount(); i++)
+  {
+    const Mixture& m = getMixture(i);
+    if (m.getType() == DistribType_GD)
+      static_cast<const MixtureGD&>(m).getPacked();
+  }
+}
+//-------------------------------------------------------------------------
+void S::releasePackedMixtures() const
+{
+  for (unsigned long i=0; i<getMixtureCount(); i++)
+  {
+    const Mixture& m = getMixture(i);
+    if (m.getType() == DistribType_GD)
+      static_cast<const MixtureGD&>(m).releasePacked();
+  }
+}
+//-------------------------------------------------------------------------
 void S::save(const FileName& f) const
 { MixtureServerFileWriter(f, _config).writeMixtureServer(*this); }
 //-------------------------------------------------------------------------
@@ -55,20 +55,61 @@
 #if !defined(ALIZE_MixtureStat_cpp)
 #define ALIZE_MixtureStat_cpp
 
-//#include <cmath>
+#if defined(_WIN32)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <new>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
 #include "MixtureStat.h"
 
 #include "Mixture.h"
+#include "MixtureGD.h"
+#include "MixtureGDPacked.h"
+#include "GDKernel.h"
+#include "GDGemm.h"
 #include "Distrib.h"
 #include "Exception.h"
+#include "MappedFile.h"
+#include "XLine.h"
 #include "Feature.h"
+#include "FeatureBlock.h"
 #include "Config.h"
 #include "RealVector.h"
+#include "Matrix.h"
 #include "StatServer.h"
 
 using namespace std; 
 using namespace alize;
 typedef MixtureStat S;
+
+// file of EM accumulators (see saveAccEM()) : header, then the doubles
+// featureCounterForEM, featureCounterForAccumulatedOcc,
+// accumulatedPrunedOcc, accumulatedOccVect[distribCount] and the
+// statistics of the derived class [statSize].
+// With the flag ACC_EXACT (deterministic accumulation), the doubles are
+// the digits of the exact sums [(distribCount+3)*LIMB_COUNT] followed by
+// the statistics of the derived class
+static const char ACC_MAGIC[8] = {'A','L','I','Z','E','A','C','C'};
+static const uint32_t ACC_VERSION = 1;
+static const uint32_t ACC_BYTE_ORDER_MARK = 0x01020304;
+static const unsigned long long ACC_EXACT = 1;
+
+struct AccHeader // 64 bytes
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  unsigned long long distribType;
+  unsigned long long distribCount;
+  unsigned long long vectSize;
+  unsigned long long statSize;
+  unsigned long long flags;
+  char     unused[8];
+};
 //-------------------------------------------------------------------------
 S::MixtureStat(StatServer& ss, const Mixture& m, const Config& c)
 :Object(), _distribCount(m.getDistribCount()), _pMixture(&m), _config(c), 
@@ -76,10 +117,18 @@ S::MixtureStat(StatServer& ss, const Mixture& m, const Config& c)
  _accumulatedLLK(0), _occVect(_distribCount, _distribCount),
  _accumulatedOccVect(_distribCount, _distribCount),
  _meanOccVect(_distribCount, _distribCount), _resetedEM(false),
- _pStatServer(&ss), _featureCounterForEM(0.0)
+ _pStatServer(&ss), _featureCounterForEM(0.0),
+ _posteriorFloor(c.existsParam("posteriorFloor") ?
+                 c.getFloatParam("posteriorFloor") : 0.0),
+ _posteriorTopCount(c.existsParam("posteriorTopCount") ?
+                    (unsigned long)c.getIntegerParam("posteriorTopCount")
+                    : 0),
+ _occIndexVect(_distribCount, _distribCount), _occIndexCount(0),
+ _accumulatedPrunedOcc(0.0), _pBlockLLKMatrix(NULL), _deterministic(false),
+ _occSynchronized(true)
 {
-  resetLLK();
-  resetOcc();
+  setDeterministicAccumulation(c.existsParam("deterministicAccumulation")
+                      && c.getBooleanParam("deterministicAccumulation"));
 }
 //-------------------------------------------------------------------------
 Mixture& S::getMixture() const { return const_cast<Mixture&>(*_pMixture); }
@@ -96,11 +145,21 @@ void S::resetLLK()
 {
   _accumulatedLLK = 0.0;
   _featureCounterForAccumulatedLK = 0.0;
+  _exactLLKAcc.reset();
 }
 //-------------------------------------------------------------------------
 lk_t S::accumulateLLK(lk_t llk, double w)
 {
-  _accumulatedLLK += (_llk = llk*w);
+  _llk = llk*w;
+  if (_deterministic)
+  {
+    _exactLLKAcc.add(0, _llk);
+    _exactLLKAcc.add(1, w);
+    _accumulatedLLK = _exactLLKAcc.getValue(0);
+    _featureCounterForAccumulatedLK = _exactLLKAcc.getValue(1);
+    return llk;
+  }
+  _accumulatedLLK += _llk;
   _featureCounterForAccumulatedLK += w;
   return llk;
 }
@@ -125,6 +184,25 @@ lk_t S::computeAndAccumulateLLK(const Feature& f,
   return accumulateLLK(llk, w);
 }
 //-------------------------------------------------------------------------
+lk_t S::computeAndAccumulateLLK(const FeatureBlock& b, double w)
+{
+  if (_pBlockLLKMatrix == NULL)
+  {
+    _pBlockLLKMatrix = new (std::nothrow) DoubleMatrix();
+    assertMemoryIsAllocated(_pBlockLLKMatrix, __FILE__, __LINE__);
+  }
+  _pStatServer->computeLLK(*_pMixture, b, *_pBlockLLKMatrix, _blockLLKVect);
+  const lk_t* llk = _blockLLKVect.getArray();
+  const unsigned long n = b.getFrameCount();
+  lk_t sum = 0.0;
+  for (unsigned long i=0; i<n; i++)
+  {
+    sum += llk[i];
+    accumulateLLK(llk[i], w);
+  }
+  return sum;
+}
+//-------------------------------------------------------------------------
 lk_t S::getAccumulatedLLK() const { return _accumulatedLLK; }
 //-------------------------------------------------------------------------
 lk_t S::getMeanLLK() const
@@ -140,13 +218,253 @@ void S::resetOcc()
 {
   _accumulatedOccVect.setAllValues(0.0);
   _featureCounterForAccumulatedOcc = 0.0;
+  _accumulatedPrunedOcc = 0.0;
+  _occSynchronized = true;
+  if (_deterministic) // the EM count is kept
+    for (unsigned long i=0; i<_distribCount+2; i++)
+      _exactOccAcc.reset(i);
+}
+//-------------------------------------------------------------------------
+void S::setDeterministicAccumulation(bool b)
+{
+  _deterministic = b;
+  _exactLLKAcc.setSize(b ? 2 : 0);
+  _exactOccAcc.setSize(b ? _distribCount+3 : 0);
+  resetLLK();
+  resetOcc();
+  _featureCounterForEM = 0.0;
+  _resetedEM = false;
+}
+//-------------------------------------------------------------------------
+bool S::isDeterministicAccumulationActive() const { return _deterministic; }
+//-------------------------------------------------------------------------
+void S::addOcc(unsigned long c, occ_t occ) // protected
+{
+  if (_deterministic)
+  {
+    _exactOccAcc.add(c, occ);
+    _occSynchronized = false;
+  }
+  else
+    _accumulatedOccVect[c] += occ;
+}
+//-------------------------------------------------------------------------
+void S::addOcc(unsigned long c, const occ_t* occ, unsigned long n) // protected
+{
+  if (_deterministic)
+  {
+    _exactOccAcc.addAll(c, occ, n);
+    _occSynchronized = false;
+  }
+  else
+    for (unsigned long i=0; i<n; i++)
+      _accumulatedOccVect[c] += occ[i];
+}
+//-------------------------------------------------------------------------
+void S::addOccFeatureCount(real_t w) // protected
+{
+  if (_deterministic)
+  {
+    _exactOccAcc.add(_distribCount, w);
+    _featureCounterForAccumulatedOcc = _exactOccAcc.getValue(_distribCount);
+  }
+  else
+    _featureCounterForAccumulatedOcc += w;
+}
+//-------------------------------------------------------------------------
+void S::addPrunedOcc(occ_t occ) // protected
+{
+  if (_deterministic)
+  {
+    _exactOccAcc.add(_distribCount+1, occ);
+    _accumulatedPrunedOcc = _exactOccAcc.getValue(_distribCount+1);
+  }
+  else
+    _accumulatedPrunedOcc += occ;
 }
 //-------------------------------------------------------------------------
+void S::addEMFeatureCount(real_t w) // protected
+{
+  if (_deterministic)
+  {
+    _exactOccAcc.add(_distribCount+2, w);
+    _featureCounterForEM = _exactOccAcc.getValue(_distribCount+2);
+  }
+  else
+    _featureCounterForEM += w;
+}
+//-------------------------------------------------------------------------
+void S::resetEMFeatureCount() // protected
+{
+  _featureCounterForEM = 0.0;
+  if (_deterministic)
+    _exactOccAcc.reset(_distribCount+2);
+}
+//-------------------------------------------------------------------------
+// addAccEM() : occupations and counters of another accumulator
+//-------------------------------------------------------------------------
+void S::addAccOcc(const MixtureStat& m) // protected
+{
+  if (m._deterministic != _deterministic)
+    throw Exception("MixtureStat incompatibility : deterministic"
+                    " accumulation", __FILE__, __LINE__);
+  if (!_deterministic)
+  {
+    _accumulatedOccVect += m._accumulatedOccVect;
+    _featureCounterForAccumulatedOcc += m._featureCounterForAccumulatedOcc;
+    _accumulatedPrunedOcc += m._accumulatedPrunedOcc;
+    _featureCounterForEM += m._featureCounterForEM;
+    return;
+  }
+  _exactOccAcc.add(m._exactOccAcc);
+  synchronizeCounters();
+}
+//-------------------------------------------------------------------------
+// copies the exact sums of the occupations, computed when they are read
+//-------------------------------------------------------------------------
+void S::synchronizeOcc() const // protected
+{
+  if (_occSynchronized)
+    return;
+  for (unsigned long c=0; c<_distribCount; c++)
+    _accumulatedOccVect[c] = _exactOccAcc.getValue(c);
+  _occSynchronized = true;
+}
+//-------------------------------------------------------------------------
+// copies the exact sums of the counters
+//-------------------------------------------------------------------------
+void S::synchronizeCounters() // private
+{
+  _occSynchronized = false;
+  _featureCounterForAccumulatedOcc = _exactOccAcc.getValue(_distribCount);
+  _accumulatedPrunedOcc = _exactOccAcc.getValue(_distribCount+1);
+  _featureCounterForEM = _exactOccAcc.getValue(_distribCount+2);
+}
+//-------------------------------------------------------------------------
+// EPS_APP : Utilise pour tester si une trame a un poids total
+// non negligeable
+//-------------------------------------------------------------------------
+static const real_t EPS_APP = 1e-200;
+//-------------------------------------------------------------------------
 real_t S::computeAndAccumulateOcc(const Feature& f, weight_t w)
 {
   real_t sum = computeOccVect(f);
-  _accumulatedOccVect += (_occVect *= w);
-  _featureCounterForAccumulatedOcc += w;
+  if (isPosteriorPruningActive())
+  {
+    occ_t* occVect = _occVect.getArray();
+    const unsigned long* idx = _occIndexVect.getArray();
+    addPrunedOcc(w*pruneOcc(occVect, _occIndexVect.getArray(),
+                            _occIndexCount));
+    for (unsigned long i=0; i<_occIndexCount; i++)
+      addOcc(idx[i], occVect[idx[i]] *= w);
+  }
+  else if (_deterministic)
+  {
+    occ_t* occVect = _occVect.getArray();
+    for (unsigned long c=0; c<_distribCount; c++)
+      addOcc(c, occVect[c] *= w);
+  }
+  else
+    _accumulatedOccVect += (_occVect *= w);
+  addOccFeatureCount(w);
+  return sum;
+}
+//-------------------------------------------------------------------------
+void S::setPosteriorPruning(occ_t floor, unsigned long topCount)
+{
+  _posteriorFloor = floor;
+  _posteriorTopCount = topCount;
+}
+//-------------------------------------------------------------------------
+occ_t S::getPosteriorFloor() const { return _posteriorFloor; }
+//-------------------------------------------------------------------------
+unsigned long S::getPosteriorTopCount() const { return _posteriorTopCount; }
+//-------------------------------------------------------------------------
+bool S::isPosteriorPruningActive() const
+{ return _posteriorFloor > 0.0 || _posteriorTopCount != 0; }
+//-------------------------------------------------------------------------
+const ULongVector& S::getOccIndexVect() const { return _occIndexVect; }
+//-------------------------------------------------------------------------
+unsigned long S::getOccIndexCount() const { return _occIndexCount; }
+//-------------------------------------------------------------------------
+occ_t S::getAccumulatedPrunedOcc() const { return _accumulatedPrunedOcc; }
+//-------------------------------------------------------------------------
+// pruning of the normalized posteriors of a frame occ[nb distrib] :
+// the kept posteriors are renormalized, the others are set to 0
+// -> idx[count] : indices of the kept distributions (increasing order)
+// returns the sum of the removed posteriors
+//-------------------------------------------------------------------------
+occ_t S::pruneOcc(occ_t* occ, unsigned long* idx,
+                  unsigned long& count) // protected
+{
+  unsigned long c, best = 0;
+  occ_t kept = 0.0, removed = 0.0;
+  count = 0;
+  for (c=0; c<_distribCount; c++)
+  {
+    if (occ[c] > occ[best])
+      best = c;
+    if (occ[c] >= _posteriorFloor)
+      idx[count++] = c;
+  }
+  if (count == 0 || occ[best] <= EPS_APP) // negligible frame : 1 distrib
+  {
+    count = 1;
+    idx[0] = best;
+  }
+  else if (_posteriorTopCount != 0 && count > _posteriorTopCount)
+  {
+    // decreasing posteriors, equal posteriors in increasing index order
+    std::nth_element(idx, idx+_posteriorTopCount-1, idx+count,
+        [occ](unsigned long a, unsigned long b)
+        { return occ[a] > occ[b] || (occ[a] == occ[b] && a < b); });
+    count = _posteriorTopCount;
+    std::sort(idx, idx+count);
+  }
+  for (c=0; c<count; c++)
+    kept += occ[idx[c]];
+  if (kept <= EPS_APP) // negligible frame : no renormalization
+    kept = 1.0;
+  unsigned long i = 0;
+  for (c=0; c<_distribCount; c++)
+  {
+    if (i < count && idx[i] == c)
+    {
+      occ[c] /= kept;
+      i++;
+    }
+    else
+    {
+      removed += occ[c];
+      occ[c] = 0.0;
+    }
+  }
+  return removed;
+}
+//-------------------------------------------------------------------------
+// normalisation des occupations lineaires d'une trame
+// retourne leur somme avant normalisation
+//-------------------------------------------------------------------------
+static real_t normalizeOcc(occ_t* occVect, unsigned long distribCount)
+{
+  occ_t sum = 0.0;
+  unsigned long c;
+  for (c=0; c<distribCount; c++)
+    sum += occVect[c];
+  if (sum > EPS_APP) /* si la trame a un poids non negligeable */
+  {
+    for (c=0; c<distribCount; c++)
+    { occVect[c] /= sum; } /* normalisation   Somme des occ = 1 */
+  }
+  else /* si la trame a un poids negligeable */
+  {
+    for (c=0; c<distribCount; c++)
+    {
+      //if (occVect[c] != 0.0)
+        occVect[c] = EPS_APP;
+    }
+    sum  = EPS_APP;
+  }
   return sum;
 }
 //-------------------------------------------------------------------------
@@ -158,36 +476,92 @@ real_t S::computeOccVect(const Feature& f) // private
 {
   // source : Amiral AppMM_IterationApp.c ContributionTrame(...)
 
-  // EPS_APP : Utilise pour tester si une trame a un poids total
-  // non negligeable
-
-  const real_t EPS_APP = 1e-200;
-
-  occ_t sum = 0.0;
   unsigned long c;
   weight_t* weightVect  = _pMixture->getTabWeight().getArray();
   Distrib** distribVect = _pMixture->getTabDistrib();
   occ_t*  occVect   = _occVect.getArray(); 
 
-  for (c=0; c<_distribCount; c++)
+  const ScoringMode mode = _pStatServer->getScoringMode();
+
+  if (mode != ScoringMode_EXACT && _pMixture->getType() == DistribType_GD
+      && _distribCount != 0 && _pMixture->getDistribCount() == _distribCount)
   {
-    Distrib* d = distribVect[c];
-    occVect[c] = weightVect[c] * d->computeLK(f);
-    sum += _occVect[c];
+    const MixtureGDPacked& p =
+                       static_cast<const MixtureGD*>(_pMixture)->getPacked();
+    if (mode == ScoringMode_LOG)
+    {
+      // occupations are computed from the log-likelihoods and are
+      // meaningful even if the frame likelihood underflows
+      p.computeWeightedLogLK(f, occVect);
+      occ_t sum = exp(GDKernel::computePosteriors(occVect, _distribCount,
+                                                  occVect));
+      return sum > EPS_APP ? sum : EPS_APP;
+    }
+    p.computeWeightedLK(f, occVect);
   }
-  if (sum > EPS_APP) /* si la trame a un poids non negligeable */
-  {
+  else
     for (c=0; c<_distribCount; c++)
-    { _occVect[c] /= sum; } /* normalisation   Somme des occ = 1 */
-  }
-  else /* si la trame a un poids negligeable */
+    {
+      Distrib* d = distribVect[c];
+      occVect[c] = weightVect[c] * d->computeLK(f);
+    }
+  return normalizeOcc(occVect, _distribCount);
+}
+//-------------------------------------------------------------------------
+// same as computeOccVect() for frameCount frames
+// -> occ[frameCount][nb distrib]
+// In mode ScoringMode_LOG the log-likelihoods are computed by a matrix
+// product (see GDGemm)
+//-------------------------------------------------------------------------
+real_t S::computeOccBlock(const float* frames, unsigned long frameCount,
+                          occ_t* occ) // protected
+{
+  const ScoringMode mode = _pStatServer->getScoringMode();
+  const unsigned long vectSize = _pMixture->getVectSize();
+  real_t total = 0.0;
+  unsigned long n;
+
+  if (mode != ScoringMode_EXACT && _pMixture->getType() == DistribType_GD
+      && _distribCount != 0 && _pMixture->getDistribCount() == _distribCount)
   {
-    for (c=0; c<_distribCount; c++)
+    const MixtureGDPacked& p =
+                       static_cast<const MixtureGD*>(_pMixture)->getPacked();
+    if (mode == ScoringMode_LOG)
     {
-      //if (_occVect[c] != 0.0)
-        _occVect[c] = EPS_APP;
+      GDGemm::computeWeightedLogLK(p, frames, frameCount, occ);
+      for (n=0; n<frameCount; n++)
+      {
+        occ_t* row = occ + n*_distribCount;
+        occ_t sum = exp(GDKernel::computePosteriors(row, _distribCount,
+                                                    row));
+        total += sum > EPS_APP ? sum : EPS_APP;
+      }
+      return total;
     }
-    sum  = EPS_APP;
+    GDKernel::computeWeightedLK(p, frames, frameCount, occ);
+    for (n=0; n<frameCount; n++)
+      total += normalizeOcc(occ + n*_distribCount, _distribCount);
+    return total;
+  }
+  Feature f(vectSize);
+  for (n=0; n<frameCount; n++)
+  {
+    f.setData(frames + n*vectSize);
+    total += computeOccVect(f);
+    memcpy(occ + n*_distribCount, _occVect.getArray(),
+           _distribCount*sizeof(occ_t));
+  }
+  return total;
+}
+//-------------------------------------------------------------------------
+occ_t S::computeAndAccumulateEM(const FeatureBlock& b, real_t w)
+{
+  Feature f;
+  occ_t sum = 0.0;
+  for (unsigned long n=0; n<b.getFrameCount(); n++)
+  {
+    b.getFeature(n, f);
+    sum += computeAndAccumulateEM(f, w);
   }
   return sum;
 }
@@ -197,12 +571,13 @@ DoubleVector& S::getOccVect() { return _occVect; }
 const DoubleVector& S::getOccVect() const { return _occVect; }
 //-------------------------------------------------------------------------
 const DoubleVector& S::getAccumulatedOccVect() const
-{ return _accumulatedOccVect; }
+{ synchronizeOcc(); return _accumulatedOccVect; }
 //-------------------------------------------------------------------------
-DoubleVector& S::getAccumulatedOccVect() { return _accumulatedOccVect; }
+DoubleVector& S::getAccumulatedOccVect()
+{ synchronizeOcc(); return _accumulatedOccVect; }
 //-------------------------------------------------------------------------
 occ_t S::getAccumulatedOcc()
-{ return _accumulatedOccVect.computeSum(); }
+{ synchronizeOcc(); return _accumulatedOccVect.computeSum(); }
 //-------------------------------------------------------------------------
 real_t S::getAccumulatedOccFeatureCount() const
 { return _featureCounterForAccumulatedOcc; }
@@ -218,6 +593,7 @@ DoubleVector& S::getMeanOccVect()
   if (_featureCounterForAccumulatedOcc == 0.0)
     throw Exception("no occ accumulated", __FILE__, __LINE__);
 
+  synchronizeOcc();
   occ_t* meanOccVect = _meanOccVect.getArray();
   for (unsigned long c=0; c<_distribCount; c++)
     meanOccVect[c] = _accumulatedOccVect[c]
@@ -225,6 +601,122 @@ DoubleVector& S::getMeanOccVect()
   return _meanOccVect;
 }
 //-------------------------------------------------------------------------
+void S::saveAccEM(const FileName& f) const
+{
+  assertResetEMDone();
+  const unsigned long statSize = getAccEMSize();
+  const unsigned long occSize = _deterministic ?
+                 _exactOccAcc.getSize()*ExactAccumulator::LIMB_COUNT
+                 : 3 + _distribCount;
+  const unsigned long valueCount = occSize + statSize;
+  const unsigned long size = sizeof(AccHeader) + valueCount*sizeof(double);
+  char* buffer = new (std::nothrow) char[size];
+  assertMemoryIsAllocated(buffer, __FILE__, __LINE__);
+  memset(buffer, 0, sizeof(AccHeader));
+  AccHeader& h = *reinterpret_cast<AccHeader*>(buffer);
+  memcpy(h.magic, ACC_MAGIC, sizeof(ACC_MAGIC));
+  h.version = ACC_VERSION;
+  h.byteOrderMark = ACC_BYTE_ORDER_MARK;
+  h.distribType = _pMixture->getType();
+  h.distribCount = _distribCount;
+  h.vectSize = _pMixture->getVectSize();
+  h.statSize = statSize;
+  h.flags = _deterministic ? ACC_EXACT : 0;
+  double* p = reinterpret_cast<double*>(buffer + sizeof(AccHeader));
+  if (_deterministic)
+    _exactOccAcc.write(p);
+  else
+  {
+    p[0] = _featureCounterForEM;
+    p[1] = _featureCounterForAccumulatedOcc;
+    p[2] = _accumulatedPrunedOcc;
+    memcpy(p+3, _accumulatedOccVect.getArray(),
+           _distribCount*sizeof(double));
+  }
+  writeAccEM(p + occSize);
+
+  FILE* file = ::fopen(f.c_str(), "wb");
+  if (file == NULL)
+  {
+    delete[] buffer;
+    throw IOException("Cannot create new file", __FILE__, __LINE__, f);
+  }
+  const bool ok = ::fwrite(buffer, 1, size, file) == size;
+  delete[] buffer;
+  if (::fclose(file) != 0 || !ok)
+    throw IOException("Cannot write in file", __FILE__, __LINE__, f);
+}
+//-------------------------------------------------------------------------
+void S::loadAccEM(const FileName& f)
+{
+  MappedFile file(f);
+  const AccHeader* h = reinterpret_cast<const AccHeader*>(file.getData());
+  if (file.getLength() < sizeof(AccHeader)
+      || memcmp(h->magic, ACC_MAGIC, sizeof(ACC_MAGIC)) != 0)
+    throw InvalidDataException("Not an EM accumulator file", __FILE__,
+                               __LINE__, f);
+  resetEM();
+  const unsigned long statSize = getAccEMSize();
+  const unsigned long occSize = _deterministic ?
+                 _exactOccAcc.getSize()*ExactAccumulator::LIMB_COUNT
+                 : 3 + _distribCount;
+  if (h->version != ACC_VERSION || h->byteOrderMark != ACC_BYTE_ORDER_MARK
+      || h->distribType != (unsigned long long)_pMixture->getType()
+      || h->distribCount != _distribCount
+      || h->vectSize != _pMixture->getVectSize())
+    throw InvalidDataException("Wrong version, byte order or mixture",
+                               __FILE__, __LINE__, f);
+  if (h->flags != (_deterministic ? ACC_EXACT : 0))
+    throw InvalidDataException("Deterministic accumulation of the file "
+        "different from the one of the accumulator", __FILE__, __LINE__, f);
+  if (h->statSize != statSize || file.getLength() != sizeof(AccHeader)
+                  + (occSize + statSize)*sizeof(double))
+    throw InvalidDataException("Wrong size", __FILE__, __LINE__, f);
+  // the data after the header are aligned if the file is mapped; they
+  // are copied anyway
+  DoubleVector v(occSize + statSize, occSize + statSize);
+  memcpy(v.getArray(), file.getData() + sizeof(AccHeader),
+         v.size()*sizeof(double));
+  const double* p = v.getArray();
+  if (_deterministic)
+  {
+    _exactOccAcc.read(p);
+    synchronizeCounters();
+  }
+  else
+  {
+    _featureCounterForEM = p[0];
+    _featureCounterForAccumulatedOcc = p[1];
+    _accumulatedPrunedOcc = p[2];
+    memcpy(_accumulatedOccVect.getArray(), p+3,
+           _distribCount*sizeof(double));
+  }
+  readAccEM(p + occSize);
+}
+//-------------------------------------------------------------------------
+const Mixture& S::mergeAccEM(const XLine& fileList)
+{
+  resetEM();
+  MixtureStat& tmp = _pMixture->createNewMixtureStatObject(K::k,
+                                              *_pStatServer, _config);
+  try
+  {
+    tmp.setDeterministicAccumulation(_deterministic);
+    for (unsigned long i=0; i<fileList.getElementCount(); i++)
+    {
+      tmp.loadAccEM(fileList.getElement(i, false));
+      addAccEM(tmp);
+    }
+  }
+  catch (...)
+  {
+    delete &tmp;
+    throw;
+  }
+  delete &tmp;
+  return getEM();
+}
+//-------------------------------------------------------------------------
 void S::assertResetEMDone() const
 {
   if (!_resetedEM)
@@ -242,7 +734,7 @@ string S::toString() const
             + std::to_string(_featureCounterForAccumulatedLK);
 }
 //-------------------------------------------------------------------------
-S::~MixtureStat() {}
+S::~MixtureStat() { delete _pBlockLLKMatrix; }
 //-------------------------------------------------------------------------
 
 #endif // !defined(ALIZE_MixtureStat_cpp)
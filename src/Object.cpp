@@ -69,9 +69,9 @@ using namespace std;
 using namespace alize;
 
 #if !defined(NDEBUG)
-unsigned long Object::_creationCounter = 0;
-unsigned long Object::_destructionCounter = 0;
-unsigned long Object::_max = 0;
+std::atomic<unsigned long> Object::_creationCounter(0);
+std::atomic<unsigned long> Object::_destructionCounter(0);
+std::atomic<unsigned long> Object::_max(0);
 #endif
 
 bool Object::_initialized = false;
@@ -106,10 +106,9 @@ Object::Object()
   }
 
 #if !defined NDEBUG
-  _creationCounter++;
-  unsigned long diff = _creationCounter-_destructionCounter;
-  if (diff > _max)
-    _max = diff;
+  unsigned long diff = ++_creationCounter-_destructionCounter;
+  unsigned long max = _max;
+  while (diff > max && !_max.compare_exchange_weak(max, diff)) {}
 #endif
 }
 //-------------------------------------------------------------------------
@@ -194,6 +193,28 @@ MixtureServerFileWriterFormat Object::getMixtureServerFileWriterFormat(const str
   return MixtureServerFileWriterFormat_RAW; // never called
 }
 //-------------------------------------------------------------------------
+ScoringMode Object::getScoringMode(const string& name)
+{
+  if (name == "EXACT")
+    return ScoringMode_EXACT;
+  if (name == "LINEAR")
+    return ScoringMode_LINEAR;
+  if (name == "LOG")
+    return ScoringMode_LOG;
+  throw Exception("Unavailable scoring mode name '" + name + "'",
+                            __FILE__, __LINE__);
+  return ScoringMode_LINEAR; // never called
+}
+//-------------------------------------------------------------------------
+string Object::getScoringModeName(ScoringMode m)
+{
+  if (m == ScoringMode_EXACT)
+    return "EXACT";
+  if (m == ScoringMode_LOG)
+    return "LOG";
+  return "LINEAR";
+}
+//-------------------------------------------------------------------------
 string Object::getDistribTypeName(DistribType t)
 {
   if (t == DistribType_GD)
@@ -222,6 +243,10 @@ FeatureFileReaderFormat Object::getFeatureFileReaderFormat(const string& name)
     return FeatureFileReaderFormat_RAW;
   if (name == "HTK")
     return FeatureFileReaderFormat_HTK;
+  if (name == "COMPRESSED")
+    return FeatureFileReaderFormat_COMPRESSED;
+  if (name == "ARCHIVE")
+    return FeatureFileReaderFormat_ARCHIVE;
   throw Exception("Unavailable feature file format name '" + name + "'",
                             __FILE__, __LINE__);
   return FeatureFileReaderFormat_RAW; // never called
@@ -297,6 +322,8 @@ FeatureFileWriterFormat Object::getFeatureFileWriterFormat(const string& name)
     return FeatureFileWriterFormat_SPRO4;
   if (name == "RAW")
     return FeatureFileWriterFormat_RAW;
+  if (name == "COMPRESSED")
+    return FeatureFileWriterFormat_COMPRESSED;
   throw Exception("Unavailable feature file format name '" + name + "'",
                             __FILE__, __LINE__);
   return FeatureFileWriterFormat_RAW; // never called
@@ -319,9 +346,6 @@ Object::~Object()
 {
 #if !defined NDEBUG
   _destructionCounter++;
-  unsigned long diff = _creationCounter-_destructionCounter;
-  if (diff > _max)
-    _max = diff;
 #endif
 }
 //-------------------------------------------------------------------------
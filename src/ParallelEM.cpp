@@ -0,0 +1,248 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_ParallelEM_cpp)
+#define ALIZE_ParallelEM_cpp
+
+#include <new>
+#include <climits>
+#include "ParallelEM.h"
+#include "StatServer.h"
+#include "MixtureStat.h"
+#include "Mixture.h"
+#include "MixtureGD.h"
+#include "Feature.h"
+#include "FeatureBlock.h"
+#include "FeatureInputStream.h"
+#include "FeatureServer.h"
+#include "Config.h"
+#include "XLine.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef ParallelEM P;
+
+// frames given to each thread for each block read from a stream
+static const unsigned long FRAME_BLOCK = 512;
+
+//-------------------------------------------------------------------------
+P::ParallelEM(const Config& c, StatServer& ss, unsigned long threadCount)
+:Object(), _config(c), _statServer(ss),
+ _pool(ThreadPool::getThreadCount(c, threadCount)), _accArray(NULL) {}
+//-------------------------------------------------------------------------
+unsigned long P::accumulateEM(MixtureStat& acc, FeatureInputStream& fs,
+                              unsigned long start, unsigned long count)
+{
+  fs.seekFeature(start);
+  return accumulateStream(acc, fs, count);
+}
+//-------------------------------------------------------------------------
+unsigned long P::accumulateEM(MixtureStat& acc, FeatureInputStream& fs)
+{ return accumulateStream(acc, fs, ULONG_MAX); }
+//-------------------------------------------------------------------------
+unsigned long P::accumulateStream(MixtureStat& acc, FeatureInputStream& fs,
+                                  unsigned long count) // private
+{
+  const unsigned long threadCount = _pool.getThreadCount();
+  const unsigned long blockSize = threadCount*FRAME_BLOCK;
+  FeatureBlock block;
+  unsigned long total = 0, n;
+
+  createAccumulators(acc);
+  try
+  {
+    do
+    {
+      // the frames are read by this thread, the stream is not shared
+      n = total < count ? fs.readFeatures(block, count-total < blockSize
+                                          ? count-total : blockSize) : 0;
+      // thread t always gets the same part of the block
+      _pool.run(threadCount, [&](unsigned long t, unsigned long)
+      {
+        const unsigned long first = t*n/threadCount;
+        const unsigned long last = (t+1)*n/threadCount;
+        if (first == last)
+          return;
+        FeatureBlock part;
+        part.setAlias(block.getFrame(first), last-first,
+                      block.getVectSize());
+        _accArray[t]->computeAndAccumulateEM(part);
+      });
+      total += n;
+    }
+    while (n != 0);
+  }
+  catch (...)
+  {
+    reduceAccumulators(acc, false);
+    throw;
+  }
+  reduceAccumulators(acc, true);
+  return total;
+}
+//-------------------------------------------------------------------------
+unsigned long P::accumulateEM(MixtureStat& acc, const XLine& fileList)
+{
+  const unsigned long threadCount = _pool.getThreadCount();
+  const unsigned long fileCount = fileList.getElementCount();
+  unsigned long t, total = 0;
+
+  // each thread gets its own copy of the configuration and of the names
+  string* nameArray = new (std::nothrow) string[fileCount];
+  assertMemoryIsAllocated(nameArray, __FILE__, __LINE__);
+  for (unsigned long i=0; i<fileCount; i++)
+    nameArray[i] = fileList.getElement(i, false);
+  Config** configArray = new (std::nothrow) Config*[threadCount];
+  assertMemoryIsAllocated(configArray, __FILE__, __LINE__);
+  unsigned long* countArray = new (std::nothrow) unsigned long[threadCount];
+  assertMemoryIsAllocated(countArray, __FILE__, __LINE__);
+  for (t=0; t<threadCount; t++)
+  {
+    configArray[t] = new (std::nothrow) Config(_config);
+    assertMemoryIsAllocated(configArray[t], __FILE__, __LINE__);
+    countArray[t] = 0;
+  }
+
+  createAccumulators(acc);
+  try
+  {
+    _pool.run(threadCount, [&](unsigned long t, unsigned long)
+    {
+      MixtureStat& s = *_accArray[t];
+      FeatureBlock b;
+      unsigned long n;
+      for (unsigned long i=t*fileCount/threadCount;
+                         i<(t+1)*fileCount/threadCount; i++)
+      {
+        FeatureServer fs(*configArray[t], nameArray[i]);
+        while ((n = fs.readFeatures(b, FRAME_BLOCK)) != 0)
+        {
+          s.computeAndAccumulateEM(b);
+          countArray[t] += n;
+        }
+      }
+    });
+    reduceAccumulators(acc, true);
+  }
+  catch (...)
+  {
+    reduceAccumulators(acc, false);
+    for (t=0; t<threadCount; t++)
+      delete configArray[t];
+    delete[] configArray;
+    delete[] countArray;
+    delete[] nameArray;
+    throw;
+  }
+  for (t=0; t<threadCount; t++)
+  {
+    total += countArray[t];
+    delete configArray[t];
+  }
+  delete[] configArray;
+  delete[] countArray;
+  delete[] nameArray;
+  return total;
+}
+//-------------------------------------------------------------------------
+void P::createAccumulators(const MixtureStat& acc) // private
+{
+  const Mixture& m = acc.getMixture();
+  const unsigned long threadCount = _pool.getThreadCount();
+  if (m.getType() == DistribType_GD)
+    static_cast<const MixtureGD&>(m).getPacked();
+  _accArray = new (std::nothrow) MixtureStat*[threadCount];
+  assertMemoryIsAllocated(_accArray, __FILE__, __LINE__);
+  for (unsigned long t=0; t<threadCount; t++)
+  {
+    _accArray[t] = &m.createNewMixtureStatObject(K::k, _statServer,
+                                                 _config);
+    _accArray[t]->setPosteriorPruning(acc.getPosteriorFloor(),
+                                      acc.getPosteriorTopCount());
+    _accArray[t]->setDeterministicAccumulation(
+                                 acc.isDeterministicAccumulationActive());
+    _accArray[t]->resetEM();
+  }
+}
+//-------------------------------------------------------------------------
+void P::reduceAccumulators(MixtureStat& acc, bool add) // private
+{
+  const unsigned long threadCount = _pool.getThreadCount();
+  if (_accArray == NULL)
+    return;
+  for (unsigned long t=0; t<threadCount; t++)
+  {
+    if (add)
+      acc.addAccEM(*_accArray[t]); // always in the same order
+    delete _accArray[t];
+  }
+  delete[] _accArray;
+  _accArray = NULL;
+}
+//-------------------------------------------------------------------------
+unsigned long P::getThreadCount() const { return _pool.getThreadCount(); }
+//-------------------------------------------------------------------------
+string P::getClassName() const { return "ParallelEM"; }
+//-------------------------------------------------------------------------
+string P::toString() const
+{
+  return Object::toString()
+    + "\n  threadCount = " + std::to_string(_pool.getThreadCount());
+}
+//-------------------------------------------------------------------------
+P::~ParallelEM() {}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_ParallelEM_cpp)
@@ -0,0 +1,294 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_ParallelLLK_cpp)
+#define ALIZE_ParallelLLK_cpp
+
+#include <new>
+#include <climits>
+#include <cstring>
+#include "ParallelLLK.h"
+#include "StatServer.h"
+#include "Mixture.h"
+#include "MixtureGD.h"
+#include "Feature.h"
+#include "FeatureInputStream.h"
+#include "LKVector.h"
+#include "Config.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef ParallelLLK P;
+
+// frames read from the stream at a time
+static const unsigned long FRAME_CHUNK = 1024;
+// frames of a task
+static const unsigned long FRAME_BLOCK = 64;
+
+//-------------------------------------------------------------------------
+// packed copy of a mixture GD, NULL for another mixture
+static const MixtureGDPacked* getPacked(const Mixture& m)
+{
+  if (m.getType() == DistribType_GD)
+    return &static_cast<const MixtureGD&>(m).getPacked();
+  return NULL;
+}
+//-------------------------------------------------------------------------
+P::ParallelLLK(const Config& c, StatServer& ss, unsigned long threadCount)
+:Object(), _config(c), _statServer(ss),
+ _pool(ThreadPool::getThreadCount(c, threadCount)), _worldLLKAcc(0.0),
+ _featureCounter(0.0), _worldFeatureCounter(0.0) {}
+//-------------------------------------------------------------------------
+unsigned long P::addMixture(const Mixture& m)
+{
+  _llkAccVect.addValue(0.0);
+  return _mixtureVect.addObject(const_cast<Mixture&>(m));
+}
+//-------------------------------------------------------------------------
+unsigned long P::getMixtureCount() const { return _mixtureVect.size(); }
+//-------------------------------------------------------------------------
+void P::removeAllMixtures()
+{
+  _mixtureVect.clear();
+  _llkAccVect.clear();
+  resetLLK();
+}
+//-------------------------------------------------------------------------
+void P::resetLLK()
+{
+  _llkAccVect.setAllValues(0.0);
+  _worldLLKAcc = 0.0;
+  _featureCounter = 0.0;
+  _worldFeatureCounter = 0.0;
+}
+//-------------------------------------------------------------------------
+unsigned long P::computeAndAccumulateLLK(FeatureInputStream& fs,
+                 unsigned long start, unsigned long count,
+                 const Mixture* world, double w)
+{
+  fs.seekFeature(start);
+  return accumulateStream(fs, count, world, w);
+}
+//-------------------------------------------------------------------------
+unsigned long P::computeAndAccumulateLLK(FeatureInputStream& fs,
+                 const Mixture* world, double w)
+{ return accumulateStream(fs, ULONG_MAX, world, w); }
+//-------------------------------------------------------------------------
+unsigned long P::accumulateStream(FeatureInputStream& fs,
+                 unsigned long count, const Mixture* world,
+                 double w) // private
+{
+  const unsigned long threadCount = _pool.getThreadCount();
+  const unsigned long mixtureCount = _mixtureVect.size();
+  Mixture** mixtureArray = _mixtureVect.getArray();
+  unsigned long total = 0, n, i, j;
+
+  // the packed copies are given to the tasks : MixtureGD::getPacked()
+  // and its lock are not called for each frame (the mixtures must not be
+  // modified until the end of the call)
+  const MixtureGDPacked* worldPacked = world != NULL ? getPacked(*world)
+                                                     : NULL;
+  const MixtureGDPacked** packedArray =
+        new (std::nothrow) const MixtureGDPacked*[mixtureCount+1];
+  assertMemoryIsAllocated(packedArray, __FILE__, __LINE__);
+  for (j=0; j<mixtureCount; j++)
+    packedArray[j] = getPacked(*mixtureArray[j]);
+
+  Feature* featureArray = new (std::nothrow) Feature[FRAME_CHUNK];
+  assertMemoryIsAllocated(featureArray, __FILE__, __LINE__);
+  LKVector* topArray = NULL;   // [FRAME_CHUNK] shared top distributions
+  lk_t* worldLLKArray = NULL;  // [FRAME_CHUNK]
+  LKVector* lkVectArray = NULL; // [threadCount] work vectors
+  DoubleVector* bufferArray = new (std::nothrow) DoubleVector[threadCount];
+  assertMemoryIsAllocated(bufferArray, __FILE__, __LINE__);
+  lk_t* llkArray = new (std::nothrow) lk_t[mixtureCount*FRAME_CHUNK+1];
+  assertMemoryIsAllocated(llkArray, __FILE__, __LINE__);
+  if (world != NULL)
+  {
+    topArray = new (std::nothrow) LKVector[FRAME_CHUNK];
+    assertMemoryIsAllocated(topArray, __FILE__, __LINE__);
+    worldLLKArray = new (std::nothrow) lk_t[FRAME_CHUNK];
+    assertMemoryIsAllocated(worldLLKArray, __FILE__, __LINE__);
+    lkVectArray = new (std::nothrow) LKVector[threadCount];
+    assertMemoryIsAllocated(lkVectArray, __FILE__, __LINE__);
+  }
+  try
+  {
+    do
+    {
+      // the frames are read by this thread, the stream is not shared
+      for (n=0; n<FRAME_CHUNK && total+n<count
+                && fs.readFeature(featureArray[n]); n++) {}
+      const unsigned long blockCount = (n+FRAME_BLOCK-1)/FRAME_BLOCK;
+
+      // top distributions of the world, once for all the targets
+      if (world != NULL)
+        _pool.run(blockCount, [&](unsigned long b, unsigned long t)
+        {
+          LKVector& v = lkVectArray[t];
+          const unsigned long end = min(n, (b+1)*FRAME_BLOCK);
+          for (unsigned long i=b*FRAME_BLOCK; i<end; i++)
+          {
+            worldLLKArray[i] = worldPacked != NULL
+                ? _statServer.computeTopDistribsLLK(*world, *worldPacked,
+                                      featureArray[i], v, bufferArray[t])
+                : _statServer.computeTopDistribsLLK(*world,
+                                      featureArray[i], v, bufferArray[t]);
+            // only the top distributions are kept
+            LKVector& top = topArray[i];
+            const unsigned long nTop = min(v.topDistribsCount, v.size());
+            top.setSize(nTop);
+            memcpy(top.getArray(), v.getArray(), nTop*sizeof(LKVector::type));
+            top.sumNonTopDistribWeights = v.sumNonTopDistribWeights;
+            top.sumNonTopDistribLK = v.sumNonTopDistribLK;
+            top.topDistribsCount = v.topDistribsCount;
+          }
+        });
+
+      // one task for each target mixture and each block of frames
+      _pool.run(mixtureCount*blockCount, [&](unsigned long k,
+                                             unsigned long t)
+      {
+        const unsigned long m = k/blockCount, b = k%blockCount;
+        const Mixture& mixture = *mixtureArray[m];
+        const MixtureGDPacked* p = packedArray[m];
+        lk_t* llk = llkArray + m*FRAME_CHUNK;
+        const unsigned long end = min(n, (b+1)*FRAME_BLOCK);
+        for (unsigned long i=b*FRAME_BLOCK; i<end; i++)
+          llk[i] = world != NULL ? _statServer.computeLLKWithTopDistribs(
+                                   mixture, featureArray[i], topArray[i])
+                 : p != NULL ? _statServer.computeLLK(mixture, *p,
+                                          featureArray[i], bufferArray[t])
+                 : _statServer.computeLLK(mixture, featureArray[i],
+                                          bufferArray[t]);
+      });
+
+      // accumulation in frame order, as the serial computation
+      for (j=0; j<mixtureCount; j++)
+      {
+        const lk_t* llk = llkArray + j*FRAME_CHUNK;
+        lk_t& acc = _llkAccVect[j];
+        for (i=0; i<n; i++)
+          acc += llk[i]*w;
+      }
+      if (world != NULL)
+        for (i=0; i<n; i++)
+        {
+          _worldLLKAcc += worldLLKArray[i]*w;
+          _worldFeatureCounter += w;
+        }
+      for (i=0; i<n; i++)
+        _featureCounter += w;
+      total += n;
+    }
+    while (n == FRAME_CHUNK);
+  }
+  catch (...)
+  {
+    delete[] featureArray;
+    delete[] topArray;
+    delete[] worldLLKArray;
+    delete[] lkVectArray;
+    delete[] bufferArray;
+    delete[] llkArray;
+    delete[] packedArray;
+    throw;
+  }
+  delete[] featureArray;
+  delete[] topArray;
+  delete[] worldLLKArray;
+  delete[] lkVectArray;
+  delete[] bufferArray;
+  delete[] llkArray;
+  delete[] packedArray;
+  return total;
+}
+//-------------------------------------------------------------------------
+lk_t P::getAccumulatedLLK(unsigned long i) const { return _llkAccVect[i]; }
+//-------------------------------------------------------------------------
+lk_t P::getMeanLLK(unsigned long i) const
+{
+  if (_featureCounter == 0.0)
+    throw Exception("No features -> no mean", __FILE__, __LINE__);
+  return _llkAccVect[i]/_featureCounter;
+}
+//-------------------------------------------------------------------------
+lk_t P::getWorldAccumulatedLLK() const { return _worldLLKAcc; }
+//-------------------------------------------------------------------------
+lk_t P::getWorldMeanLLK() const
+{
+  if (_worldFeatureCounter == 0.0)
+    throw Exception("No features -> no mean", __FILE__, __LINE__);
+  return _worldLLKAcc/_worldFeatureCounter;
+}
+//-------------------------------------------------------------------------
+double P::getAccumulatedLLKFeatureCount() const { return _featureCounter; }
+//-------------------------------------------------------------------------
+unsigned long P::getThreadCount() const { return _pool.getThreadCount(); }
+//-------------------------------------------------------------------------
+string P::getClassName() const { return "ParallelLLK"; }
+//-------------------------------------------------------------------------
+string P::toString() const
+{
+  return Object::toString()
+    + "\n  threadCount  = " + std::to_string(_pool.getThreadCount())
+    + "\n  mixtureCount = " + std::to_string(_mixtureVect.size())
+    + "\n  featureCount = " + std::to_string(_featureCounter);
+}
+//-------------------------------------------------------------------------
+P::~ParallelLLK() {}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_ParallelLLK_cpp)
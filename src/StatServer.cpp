@@ -74,10 +74,17 @@
 #include "MixtureGDStat.h"
 #include "MixtureGFStat.h"
 #include "Mixture.h"
+#include "MixtureGD.h"
+#include "MixtureGDPacked.h"
+#include "GDKernel.h"
+#include "GDGemm.h"
+#include "TopDistribsStore.h"
+#include "FeatureBlock.h"
 #include "Exception.h"
 #include "Config.h"
 #include "RealVector.h"
 #include "ULongVector.h"
+#include "Matrix.h"
 #include "ViterbiAccum.h"
 #include "FrameAccGD.h"
 #include "FrameAccGF.h"
@@ -92,21 +99,32 @@ using namespace std;
 
 
 typedef StatServer S;
+
+static ScoringMode getScoringModeParam(const Config& c)
+{
+  if (c.existsParam("scoringMode"))
+    return Object::getScoringMode(c.getParam("scoringMode"));
+  return ScoringMode_LINEAR;
+}
 //-------------------------------------------------------------------------
 S::StatServer(const Config& c)
 :Object(), _config(c), _pMixtureServer(NULL), 
 _topDistribsVect(0, 0), _minLLK(c.getParam_minLLK()), 
-_maxLLK(c.getParam_maxLLK()){ 
+_maxLLK(c.getParam_maxLLK()), _scoringMode(getScoringModeParam(c)){ 
 	reset(); 
 	}
 //-------------------------------------------------------------------------
 S::StatServer(const Config& c, MixtureServer& ms)
 :Object(), _config(c), _pMixtureServer(&ms),
  _topDistribsVect(0, 0), _minLLK(c.getParam_minLLK()),
-_maxLLK(c.getParam_maxLLK())
+_maxLLK(c.getParam_maxLLK()), _scoringMode(getScoringModeParam(c))
 
 { reset(); }
 //-------------------------------------------------------------------------
+void S::setScoringMode(ScoringMode m) { _scoringMode = m; }
+//-------------------------------------------------------------------------
+ScoringMode S::getScoringMode() const { return _scoringMode; }
+//-------------------------------------------------------------------------
 void S::reset()
 {
   _mixtureStatVect.deleteAllObjects();
@@ -148,8 +166,41 @@ lk_t S::getLLK(const Mixture& m) { return getMixtureStat(m).getLLK(); }
 lk_t S::getMeanLLK(const Mixture& m) { return getMixtureStat(m).getMeanLLK(); }
 //-------------------------------------------------------------------------
 lk_t S::computeLLK(const Mixture& m, const Feature& f) const
+{ return computeLLK(m, f, _weightedLKVect); }
+//-------------------------------------------------------------------------
+lk_t S::computeLLK(const Mixture& m, const Feature& f,
+                   DoubleVector& buffer) const
+{
+  return computeLLK(m, usesPacked(m) ? &static_cast<const MixtureGD&>(m)
+                                        .getPacked() : NULL, f, buffer);
+}
+//-------------------------------------------------------------------------
+lk_t S::computeLLK(const Mixture& m, const MixtureGDPacked& p,
+                   const Feature& f, DoubleVector& buffer) const
+{ return computeLLK(m, usesPacked(m) ? &p : NULL, f, buffer); }
+//-------------------------------------------------------------------------
+lk_t S::computeLLK(const Mixture& m, const MixtureGDPacked* p,
+                   const Feature& f, DoubleVector& buffer) const // private
 {
   lk_t lk = 0.0;
+  if (p != NULL && _scoringMode == ScoringMode_LOG)
+  {
+    buffer.setSize(p->getDistribCount());
+    lk_t* llk = buffer.getArray();
+    p->computeWeightedLogLK(f, llk);
+    lk = GDKernel::logSumExp(llk, p->getDistribCount());
+    // no distribution contributes (null weights) : same as lk == 0
+    if (ISNAN(lk) || lk <= GDKernel::LOG_ZERO)
+      return _minLLK;
+    return lk > _maxLLK ? _maxLLK : lk;
+  }
+  if (p != NULL)
+  {
+    const lk_t* v = computeWeightedLK(*p, f, buffer);
+    for (unsigned long c=0; c<m.getDistribCount(); c++)
+      lk += v[c];
+    return computeLLK(lk);
+  }
   weight_t*  w = m.getTabWeight().getArray();
   Distrib**  d = m.getTabDistrib();
   unsigned long distribCount = m.getDistribCount();
@@ -170,6 +221,68 @@ lk_t S::computeLLK(const Mixture& m, const Feature& f, unsigned long idx) const
   return computeLLK(lk);
 }
 //-------------------------------------------------------------------------
+// F : type of the frames (real_t or float)
+//-------------------------------------------------------------------------
+template <class F> static void computeBlockLLK(const Mixture& m,
+                 const F* frames, unsigned long frameCount,
+                 DoubleMatrix& llkMatrix, DoubleVector& llkVect,
+                 ScoringMode mode, lk_t minLLK, lk_t maxLLK)
+{
+  const unsigned long distribCount = m.getDistribCount();
+  const unsigned long vectSize = m.getVectSize();
+  unsigned long n, c;
+  llkMatrix.setDimensions(frameCount, distribCount);
+  llkVect.setSize(frameCount);
+  lk_t* llk = llkMatrix.getArray();
+
+  if (mode != ScoringMode_EXACT && m.getType() == DistribType_GD)
+    GDGemm::computeWeightedLogLK(static_cast<const MixtureGD&>(m)
+                                 .getPacked(), frames, frameCount, llk);
+  else
+  {
+    const weight_t* w = m.getTabWeight().getArray();
+    Distrib** d = m.getTabDistrib();
+    Feature f(vectSize);
+    for (n=0; n<frameCount; n++)
+    {
+      for (unsigned long i=0; i<vectSize; i++)
+        f[i] = frames[n*vectSize+i];
+      for (c=0; c<distribCount; c++)
+      {
+        const lk_t lk = w[c] * d[c]->computeLK(f);
+        llk[n*distribCount+c] = lk > 0.0 ? log(lk) : GDKernel::LOG_ZERO;
+      }
+    }
+  }
+  for (n=0; n<frameCount; n++)
+  {
+    const lk_t lk = GDKernel::logSumExp(llk+n*distribCount, distribCount);
+    if (ISNAN(lk) || lk <= GDKernel::LOG_ZERO)
+      llkVect[n] = minLLK;
+    else
+      llkVect[n] = lk > maxLLK ? maxLLK : lk;
+  }
+}
+//-------------------------------------------------------------------------
+void S::computeLLK(const Mixture& m, const real_t* frames,
+                   unsigned long frameCount, DoubleMatrix& llkMatrix,
+                   DoubleVector& llkVect) const
+{
+  computeBlockLLK(m, frames, frameCount, llkMatrix, llkVect,
+                  _scoringMode, _minLLK, _maxLLK);
+}
+//-------------------------------------------------------------------------
+void S::computeLLK(const Mixture& m, const FeatureBlock& b,
+                   DoubleMatrix& llkMatrix, DoubleVector& llkVect) const
+{
+  if (b.getVectSize() != m.getVectSize() && b.getFrameCount() != 0)
+    throw Exception("mixture vectSize ("
+        + std::to_string(m.getVectSize()) + ") != block vectSize ("
+        + std::to_string(b.getVectSize()) + ")", __FILE__, __LINE__);
+  computeBlockLLK(m, b.getArray(), b.getFrameCount(), llkMatrix, llkVect,
+                  _scoringMode, _minLLK, _maxLLK);
+}
+//-------------------------------------------------------------------------
 lk_t S::computeLLK(const K&, const Mixture& m) const
 {
   const weight_t* weightVect  = m.getTabWeight().getArray();
@@ -196,6 +309,26 @@ lk_t S::computeLLK(lk_t lk) const // private
   return lk;
 }
 //-------------------------------------------------------------------------
+// Tests whether a mixture is scored with its packed copy : mixture GD
+// not empty, not in mode EXACT
+//-------------------------------------------------------------------------
+bool S::usesPacked(const Mixture& m) const // private
+{
+  return _scoringMode != ScoringMode_EXACT
+      && m.getType() == DistribType_GD && m.getDistribCount() != 0;
+}
+//-------------------------------------------------------------------------
+// Computes w[c]*lk(c,f) with the vectorized kernel (see GDKernel).
+//-------------------------------------------------------------------------
+const lk_t* S::computeWeightedLK(const MixtureGDPacked& p, const Feature& f,
+                                 DoubleVector& buffer) const // private
+{
+  buffer.setSize(p.getDistribCount());
+  lk_t* lk = buffer.getArray();
+  p.computeWeightedLK(f, lk);
+  return lk;
+}
+//-------------------------------------------------------------------------
 lk_t S::computeLLK(const K&, const Mixture& m, const Feature& f,
                    const TopDistribsAction& a)
 {
@@ -234,16 +367,57 @@ lk_t S::computeLLK(const K&, const Mixture& m, const Feature& f,
     return computeLLK(lk);
   }
   // a == DETERMINE_TOP_DISTRIBS
+  return computeTopDistribsLLK(m, f, lkVect, _weightedLKVect);
+}
+//-------------------------------------------------------------------------
+lk_t S::computeTopDistribsLLK(const Mixture& m, const Feature& f,
+                     LKVector& lkVect, DoubleVector& buffer) const
+{
+  return computeTopDistribsLLK(m, usesPacked(m) ?
+           &static_cast<const MixtureGD&>(m).getPacked() : NULL, f, lkVect,
+           buffer);
+}
+//-------------------------------------------------------------------------
+lk_t S::computeTopDistribsLLK(const Mixture& m, const MixtureGDPacked& p,
+      const Feature& f, LKVector& lkVect, DoubleVector& buffer) const
+{
+  return computeTopDistribsLLK(m, usesPacked(m) ? &p : NULL, f, lkVect,
+                               buffer);
+}
+//-------------------------------------------------------------------------
+lk_t S::computeTopDistribsLLK(const Mixture& m, const MixtureGDPacked* p,
+      const Feature& f, LKVector& lkVect, DoubleVector& buffer)
+      const // private
+{
+  lk_t lk = 0.0;
+  weight_t* w = m.getTabWeight().getArray();
+  Distrib** d = m.getTabDistrib();
+  unsigned long distribCount = m.getDistribCount();
+  unsigned long c, i, nTop = _config.getParam_topDistribsCount();
+
   lkVect.setSize(distribCount);
   LKVector::type* v = lkVect.getArray();
   lkVect.topDistribsCount = nTop;
 
-  for (c=0; c<distribCount; c++)
+  if (p != NULL)
   {
-    v[c].idx = c;
-    lk += (v[c].lk = w[c] * d[c]->computeLK(f));
+    const lk_t* wlk = computeWeightedLK(*p, f, buffer);
+    for (c=0; c<distribCount; c++)
+    {
+      v[c].idx = c;
+      lk += (v[c].lk = wlk[c]);
+    }
   }
-  lkVect.descendingSort();
+  else
+    for (c=0; c<distribCount; c++)
+    {
+      v[c].idx = c;
+      lk += (v[c].lk = w[c] * d[c]->computeLK(f));
+    }
+  // only the top distributions are sorted, by decreasing weighted lk
+  // then by index so that the result does not depend on the order of
+  // the computations
+  lkVect.descendingSort(nTop, true);
   //
   if (_config.getParam_computeLLKWithTopDistribs() == true) // COMPLETE
   {
@@ -262,6 +436,39 @@ lk_t S::computeLLK(const K&, const Mixture& m, const Feature& f,
   return computeLLK(lk);
 }
 //-------------------------------------------------------------------------
+// Same operations as computeLLK(K, m, f, USE_TOP_DISTRIBS)
+//-------------------------------------------------------------------------
+lk_t S::computeLLKWithTopDistribs(const Mixture& m, const Feature& f,
+                                  const LKVector& lkVect) const
+{
+  lk_t lk = 0.0;
+  weight_t* w = m.getTabWeight().getArray();
+  Distrib** d = m.getTabDistrib();
+  unsigned long distribCount = m.getDistribCount();
+  unsigned long c, i, nTop = _config.getParam_topDistribsCount();
+
+  if (nTop >= distribCount)
+    nTop = distribCount;
+  if (lkVect.size() < nTop)
+    throw Exception("Not enough top distributions", __FILE__, __LINE__);
+  const LKVector::type* v = lkVect.getArray();
+  real_t sumTopDistribWeights = 0.0;
+
+  for (i=0; i<nTop; i++)
+  {
+    c = v[i].idx;
+    sumTopDistribWeights += w[c];
+    lk += w[c] * d[c]->computeLK(f);
+  }
+  if (_config.getParam_computeLLKWithTopDistribs()) // COMPLETE
+    lk += lkVect.sumNonTopDistribLK *
+        (1.0 - sumTopDistribWeights) / lkVect.sumNonTopDistribWeights;
+  else // PARTIAL
+    if (nTop != 0)
+      lk /= sumTopDistribWeights;
+  return computeLLK(lk);
+}
+//-------------------------------------------------------------------------
 lk_t S::computeLLK(const K&, const Mixture& m, const Feature& f,
                    const LKVector& lkVect)
 {
@@ -334,6 +541,14 @@ void S::setTopDistribIndexVector(const ULongVector& indexVect,
   _topDistribsVect.sumNonTopDistribLK = l;
 }
 //-------------------------------------------------------------------------
+void S::setTopDistribIndexVector(const TopDistribsStore& s,
+                                 unsigned long frame)
+{
+  s.getTopDistribs(frame, _topDistribsVect);
+  // same size as after DETERMINE_TOP_DISTRIBS
+  _topDistribsVect.setSize(s.getDistribCount());
+}
+//-------------------------------------------------------------------------
 MixtureStat& S::getMixtureStat(const Mixture& m) // private
 {
   // TODO : not optimised...
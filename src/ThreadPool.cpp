@@ -0,0 +1,245 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_ThreadPool_cpp)
+#define ALIZE_ThreadPool_cpp
+
+#include <new>
+#include "ThreadPool.h"
+#include "Config.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef ThreadPool T;
+
+//-------------------------------------------------------------------------
+T::ThreadPool(unsigned long threadCount)
+:Object(), _threadCount(threadCount == 0 ? getHardwareThreadCount()
+                                         : threadCount),
+ _threadArray(NULL), _rangeArray(NULL), _pTask(NULL), _activeCount(0),
+ _group(0), _stop(false), _cancelled(false)
+{
+  _rangeArray = new (std::nothrow) Range[_threadCount];
+  assertMemoryIsAllocated(_rangeArray, __FILE__, __LINE__);
+  for (unsigned long t=0; t<_threadCount; t++)
+    _rangeArray[t].begin = _rangeArray[t].end = 0;
+  if (_threadCount > 1)
+  {
+    _threadArray = new (std::nothrow) std::thread[_threadCount-1];
+    assertMemoryIsAllocated(_threadArray, __FILE__, __LINE__);
+    // the calling thread is the thread 0
+    for (unsigned long t=1; t<_threadCount; t++)
+      _threadArray[t-1] = std::thread(&T::work, this, t);
+  }
+}
+//-------------------------------------------------------------------------
+void T::run(unsigned long taskCount, const Task& task)
+{
+  if (taskCount == 0)
+    return;
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _pTask = &task;
+    _error = std::exception_ptr();
+    _cancelled = false;
+    for (unsigned long t=0; t<_threadCount; t++)
+    {
+      std::unique_lock<std::mutex> rangeLock(_rangeArray[t].mutex);
+      _rangeArray[t].begin = t*taskCount/_threadCount;
+      _rangeArray[t].end = (t+1)*taskCount/_threadCount;
+    }
+    _activeCount = _threadCount-1;
+    _group++;
+  }
+  _startCondition.notify_all();
+  runTasks(0);
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_activeCount != 0)
+      _doneCondition.wait(lock);
+    _pTask = NULL;
+    error = _error;
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+//-------------------------------------------------------------------------
+bool T::nextTask(unsigned long thread, unsigned long& task) // private
+{
+  if (_cancelled)
+    return false;
+  Range& own = _rangeArray[thread];
+  {
+    std::unique_lock<std::mutex> lock(own.mutex);
+    if (own.begin < own.end)
+    {
+      task = own.begin++;
+      return true;
+    }
+  }
+  // steals the upper half of the largest range
+  for (;;)
+  {
+    unsigned long victim = _threadCount, size = 0, t;
+    for (t=0; t<_threadCount; t++)
+    {
+      std::unique_lock<std::mutex> lock(_rangeArray[t].mutex);
+      if (_rangeArray[t].end - _rangeArray[t].begin > size)
+      {
+        size = _rangeArray[t].end - _rangeArray[t].begin;
+        victim = t;
+      }
+    }
+    if (victim == _threadCount)
+      return false;
+    unsigned long begin, end;
+    {
+      std::unique_lock<std::mutex> lock(_rangeArray[victim].mutex);
+      Range& r = _rangeArray[victim];
+      if (r.begin >= r.end) // emptied in the meantime
+        continue;
+      end = r.end; // a single task left is taken as well
+      begin = r.end = r.begin + (r.end-r.begin)/2;
+    }
+    std::unique_lock<std::mutex> lock(own.mutex);
+    task = begin;
+    own.begin = begin+1;
+    own.end = end;
+    return true;
+  }
+}
+//-------------------------------------------------------------------------
+void T::runTasks(unsigned long thread) // private
+{
+  unsigned long task;
+  while (nextTask(thread, task))
+  {
+    try { (*_pTask)(task, thread); }
+    catch (...)
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      if (!_error)
+        _error = std::current_exception();
+      _cancelled = true; // the remaining tasks are not run
+    }
+  }
+}
+//-------------------------------------------------------------------------
+void T::work(unsigned long thread) // private, thread function
+{
+  unsigned long long group = 0;
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      while (!_stop && _group == group)
+        _startCondition.wait(lock);
+      if (_stop)
+        return;
+      group = _group;
+    }
+    runTasks(thread);
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      if (--_activeCount == 0)
+        _doneCondition.notify_one();
+    }
+  }
+}
+//-------------------------------------------------------------------------
+unsigned long T::getThreadCount() const { return _threadCount; }
+//-------------------------------------------------------------------------
+unsigned long T::getThreadCount(const Config& c, unsigned long threadCount)
+{
+  if (threadCount == 0 && c.existsParam("threadCount"))
+  {
+    const long n = c.getIntegerParam("threadCount");
+    if (n < 0)
+      throw Exception("Wrong threadCount (< 0)", __FILE__, __LINE__);
+    return (unsigned long)n;
+  }
+  return threadCount;
+}
+//-------------------------------------------------------------------------
+unsigned long T::getHardwareThreadCount()
+{
+  const unsigned long n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+//-------------------------------------------------------------------------
+string T::getClassName() const { return "ThreadPool"; }
+//-------------------------------------------------------------------------
+string T::toString() const
+{
+  return Object::toString()
+    + "\n  threadCount = " + std::to_string(_threadCount);
+}
+//-------------------------------------------------------------------------
+T::~ThreadPool()
+{
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _startCondition.notify_all();
+  for (unsigned long t=1; t<_threadCount; t++)
+    _threadArray[t-1].join();
+  delete[] _threadArray;
+  delete[] _rangeArray;
+}
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_ThreadPool_cpp)
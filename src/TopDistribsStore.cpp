@@ -0,0 +1,319 @@
+/*
+	This file is part of ALIZE which is an open-source tool for 
+	speaker recognition.
+
+    ALIZE is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as 
+    published by the Free Software Foundation, either version 3 of 
+    the License, or any later version.
+
+    ALIZE is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public 
+    License along with ALIZE.
+    If not, see <http://www.gnu.org/licenses/>.
+        
+	ALIZE is a development project initiated by the ELISA consortium
+	[alize.univ-avignon.fr/] and funded by the French Research 
+	Ministry in the framework of the TECHNOLANGUE program 
+	[www.technolangue.net]
+
+	The ALIZE project team wants to highlight the limits of voice
+	authentication in a forensic context.
+	The "Person  Authentification by Voice: A Need of Caution" paper 
+	proposes a good overview of this point (cf. "Person  
+	Authentification by Voice: A Need of Caution", Bonastre J.F., 
+	Bimbot F., Boe L.J., Campbell J.P., Douglas D.A., Magrin-
+	chagnolleau I., Eurospeech 2003, Genova].
+	The conclusion of the paper of the paper is proposed bellow:
+	[Currently, it is not possible to completely determine whether the 
+	similarity between two recordings is due to the speaker or to other 
+	factors, especially when: (a) the speaker does not cooperate, (b) there 
+	is no control over recording equipment, (c) recording conditions are not 
+	known, (d) one does not know whether the voice was disguised and, to a 
+	lesser extent, (e) the linguistic content of the message is not 
+	controlled. Caution and judgment must be exercised when applying speaker 
+	recognition techniques, whether human or automatic, to account for these 
+	uncontrolled factors. Under more constrained or calibrated situations, 
+	or as an aid for investigative purposes, judicious application of these 
+	techniques may be suitable, provided they are not considered as infallible.
+	At the present time, there is no scientific process that enables one to 
+	uniquely characterize a person=92s voice or to identify with absolute 
+	certainty an individual from his or her voice.]
+	Contact Jean-Francois Bonastre for more information about the licence or
+	the use of ALIZE
+
+	Copyright (C) 2003-2010
+	Laboratoire d'informatique d'Avignon [lia.univ-avignon.fr]
+	ALIZE admin [alize@univ-avignon.fr]
+	Jean-Francois Bonastre [jean-francois.bonastre@univ-avignon.fr]
+*/
+
+#if !defined(ALIZE_TopDistribsStore_cpp)
+#define ALIZE_TopDistribsStore_cpp
+
+#if defined(_WIN32)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <new>
+#include <cstdio>
+#include <cstring>
+#include "TopDistribsStore.h"
+#include "MappedFile.h"
+#include "StatServer.h"
+#include "Mixture.h"
+#include "Feature.h"
+#include "FeatureInputStream.h"
+#include "LKVector.h"
+#include "RealVector.h"
+#include "Config.h"
+#include "Exception.h"
+
+using namespace alize;
+using namespace std;
+typedef TopDistribsStore T;
+
+static const char MAGIC[8] = {'A','L','I','Z','E','T','O','P'};
+static const uint32_t VERSION = 1;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct Header // 64 bytes
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  unsigned long long frameCount;
+  unsigned long long topCount;
+  unsigned long long distribCount;
+  unsigned long long paramTopCount;
+  char     unused[16];
+};
+
+//-------------------------------------------------------------------------
+// size of a file, 0 if it cannot be represented (header of a corrupted
+// file)
+//-------------------------------------------------------------------------
+static unsigned long getSize(unsigned long long frameCount,
+                             unsigned long long topCount)
+{
+  const unsigned long max = ~0UL;
+  const unsigned long frameSize = 3*sizeof(double);
+  const unsigned long topSize = sizeof(double) + sizeof(uint32_t);
+  if (topCount > (max - frameSize)/topSize)
+    return 0;
+  const unsigned long size = frameSize + (unsigned long)topCount*topSize;
+  if (frameCount > (max - sizeof(Header))/size)
+    return 0;
+  return sizeof(Header) + (unsigned long)frameCount*size;
+}
+//-------------------------------------------------------------------------
+T::TopDistribsStore(const Config& c)
+:Object(), _config(c), _frameCount(0), _topCount(0), _distribCount(0),
+ _paramTopCount(0), _buffer(NULL), _pMappedFile(NULL), _frameArray(NULL),
+ _lkArray(NULL), _idxArray(NULL) {}
+//-------------------------------------------------------------------------
+unsigned long T::computeTopDistribs(const StatServer& ss,
+                 const Mixture& world, FeatureInputStream& fs)
+{
+  clear();
+  _distribCount = world.getDistribCount();
+  _paramTopCount = _config.getParam_topDistribsCount();
+  _topCount = _paramTopCount < _distribCount ? _paramTopCount
+                                             : _distribCount;
+  fs.reset();
+  const unsigned long n = fs.getFeatureCount();
+
+  _frameCount = n;
+  _buffer = new (std::nothrow) char[getSize(n, _topCount)];
+  assertMemoryIsAllocated(_buffer, __FILE__, __LINE__);
+  setArrays(_buffer);
+  double* frame = const_cast<double*>(_frameArray);
+  double* lk = const_cast<double*>(_lkArray);
+  uint32_t* idx = const_cast<uint32_t*>(_idxArray);
+
+  LKVector v;
+  DoubleVector buffer;
+  Feature f;
+  unsigned long count;
+  for (count=0; count<n && fs.readFeature(f); count++)
+  {
+    frame[0] = ss.computeTopDistribsLLK(world, f, v, buffer);
+    frame[1] = v.sumNonTopDistribWeights;
+    frame[2] = v.sumNonTopDistribLK;
+    frame += 3;
+    const LKVector::type* p = v.getArray();
+    for (unsigned long i=0; i<_topCount; i++, lk++, idx++)
+    {
+      *lk = p[i].lk;
+      *idx = (uint32_t)p[i].idx;
+    }
+  }
+  if (count != n) // shorter stream : the arrays are moved
+  {
+    char* oldBuffer = _buffer;
+    const double* oldFrameArray = _frameArray;
+    const double* oldLkArray = _lkArray;
+    const uint32_t* oldIdxArray = _idxArray;
+    _frameCount = count;
+    _buffer = new (std::nothrow) char[getSize(count, _topCount)];
+    assertMemoryIsAllocated(_buffer, __FILE__, __LINE__);
+    setArrays(_buffer);
+    memcpy(const_cast<double*>(_frameArray), oldFrameArray,
+           count*3*sizeof(double));
+    memcpy(const_cast<double*>(_lkArray), oldLkArray,
+           count*_topCount*sizeof(double));
+    memcpy(const_cast<uint32_t*>(_idxArray), oldIdxArray,
+           count*_topCount*sizeof(uint32_t));
+    delete[] oldBuffer;
+  }
+  return _frameCount;
+}
+//-------------------------------------------------------------------------
+// sets the header of a buffer and the pointers on its arrays
+//-------------------------------------------------------------------------
+void T::setArrays(const char* data) // private
+{
+  if (data == _buffer)
+  {
+    Header& h = *reinterpret_cast<Header*>(_buffer);
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.byteOrderMark = BYTE_ORDER_MARK;
+    h.frameCount = _frameCount;
+    h.topCount = _topCount;
+    h.distribCount = _distribCount;
+    h.paramTopCount = _paramTopCount;
+  }
+  const unsigned long n = reinterpret_cast<const Header*>(data)->frameCount;
+  _frameArray = reinterpret_cast<const double*>(data + sizeof(Header));
+  _lkArray = _frameArray + n*3;
+  _idxArray = reinterpret_cast<const uint32_t*>(_lkArray + n*_topCount);
+}
+//-------------------------------------------------------------------------
+unsigned long T::getFrameCount() const { return _frameCount; }
+//-------------------------------------------------------------------------
+unsigned long T::getTopDistribsCount() const { return _topCount; }
+//-------------------------------------------------------------------------
+unsigned long T::getDistribCount() const { return _distribCount; }
+//-------------------------------------------------------------------------
+lk_t T::getLLK(unsigned long frame) const
+{
+  assertIsInBounds(__FILE__, __LINE__, frame, _frameCount);
+  return _frameArray[frame*3];
+}
+//-------------------------------------------------------------------------
+void T::getTopDistribs(unsigned long frame, LKVector& v) const
+{
+  assertIsInBounds(__FILE__, __LINE__, frame, _frameCount);
+  v.setSize(_topCount);
+  LKVector::type* p = v.getArray();
+  const double* lk = _lkArray + frame*_topCount;
+  const uint32_t* idx = _idxArray + frame*_topCount;
+  for (unsigned long i=0; i<_topCount; i++)
+  {
+    p[i].idx = idx[i];
+    p[i].lk = lk[i];
+  }
+  v.sumNonTopDistribWeights = _frameArray[frame*3+1];
+  v.sumNonTopDistribLK = _frameArray[frame*3+2];
+  v.topDistribsCount = _paramTopCount;
+}
+//-------------------------------------------------------------------------
+FileName T::getFullFileName(const FileName& f) const // private
+{
+  string path, ext = ".top";
+  if (_config.existsParam("featureFilesPath"))
+    path = _config.getParam("featureFilesPath");
+  if (_config.existsParam("topDistribsFileExtension"))
+    ext = _config.getParam("topDistribsFileExtension");
+  return path + f + ext;
+}
+//-------------------------------------------------------------------------
+void T::save(const FileName& f) const
+{
+  const FileName fullName = getFullFileName(f);
+  const char* data = _pMappedFile != NULL ? _pMappedFile->getData()
+                                           : _buffer;
+  if (data == NULL)
+    throw Exception("Empty store", __FILE__, __LINE__);
+  FILE* file = ::fopen(fullName.c_str(), "wb");
+  if (file == NULL)
+    throw IOException("Cannot create new file", __FILE__, __LINE__,
+                      fullName);
+  const unsigned long size = getSize(_frameCount, _topCount);
+  const bool ok = ::fwrite(data, 1, size, file) == size;
+  if (::fclose(file) != 0 || !ok)
+    throw IOException("Cannot write in file", __FILE__, __LINE__, fullName);
+}
+//-------------------------------------------------------------------------
+void T::load(const FileName& f)
+{
+  clear();
+  const FileName fullName = getFullFileName(f);
+  MappedFile* p = new (std::nothrow) MappedFile(fullName);
+  assertMemoryIsAllocated(p, __FILE__, __LINE__);
+  const Header* h = reinterpret_cast<const Header*>(p->getData());
+  if (p->getLength() < sizeof(Header)
+      || memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0)
+  {
+    delete p;
+    throw InvalidDataException("Not a top distributions file", __FILE__,
+                               __LINE__, fullName);
+  }
+  if (h->version != VERSION || h->byteOrderMark != BYTE_ORDER_MARK
+      || p->getLength() != getSize(h->frameCount, h->topCount))
+  {
+    delete p;
+    throw InvalidDataException("Wrong version, byte order or size",
+                               __FILE__, __LINE__, fullName);
+  }
+  _pMappedFile = p;
+  _frameCount = h->frameCount;
+  _topCount = h->topCount;
+  _distribCount = h->distribCount;
+  _paramTopCount = h->paramTopCount;
+  setArrays(p->getData());
+  // the indexes are used without checks by StatServer : the file is
+  // rejected if one of them is not the index of a distribution
+  bool ok = _topCount <= _distribCount;
+  for (unsigned long i=0; ok && i<_frameCount*_topCount; i++)
+    ok = _idxArray[i] < _distribCount;
+  if (!ok)
+  {
+    clear();
+    throw InvalidDataException("Wrong distribution index", __FILE__,
+                               __LINE__, fullName);
+  }
+}
+//-------------------------------------------------------------------------
+void T::clear() // private
+{
+  delete[] _buffer;
+  _buffer = NULL;
+  delete _pMappedFile;
+  _pMappedFile = NULL;
+  _frameArray = _lkArray = NULL;
+  _idxArray = NULL;
+  _frameCount = _topCount = _distribCount = _paramTopCount = 0;
+}
+//-------------------------------------------------------------------------
+string T::getClassName() const { return "TopDistribsStore"; }
+//-------------------------------------------------------------------------
+string T::toString() const
+{
+  return Object::toString()
+    + "\n  frameCount   = " + std::to_string(_frameCount)
+    + "\n  topCount     = " + std::to_string(_topCount)
+    + "\n  distribCount = " + std::to_string(_distribCount)
+    + "\n  mapped file  = " + (_pMappedFile != NULL ? "yes" : "no");
+}
+//-------------------------------------------------------------------------
+T::~TopDistribsStore() { clear(); }
+//-------------------------------------------------------------------------
+
+#endif // !defined(ALIZE_TopDistribsStore_cpp)
@@ -88,7 +88,8 @@ XLine::XLine(const XLine& l)
 :Object(), _current(0), _pLine(NULL)
 {
   for (unsigned long i=0; i<l._vector.size(); i++)
-    _vector.addObject(l._vector.getObject(i));
+    addElement(l._vector.getObject(i));
+  _current = 0;
 }
 //-------------------------------------------------------------------------
 XLine& XLine::duplicate() const
@@ -161,13 +162,17 @@ const XLine& XLine::getElements() const
   else
     _pLine->reset();
   for (unsigned long i=_current; i<_vector.size(); i++)
-    _pLine->_vector.addObject(_vector.getObject(i));
+    _pLine->addElement(_vector.getObject(i));
+  _pLine->_current = 0;
   return *_pLine;
 }
 //-------------------------------------------------------------------------
 XLine& XLine::addElement(string e) 
 {
-  _current = _vector.addObject(e);
+  // the vector owns its strings (see reset())
+  string* p = new (std::nothrow) string(e);
+  assertMemoryIsAllocated(p, __FILE__, __LINE__);
+  _current = _vector.addObject(*p);
   return *this;
 }
 //-------------------------------------------------------------------------